@@ -45,7 +45,37 @@ static auto read_project_file(const fs::path &path) -> ls::option<ProjectFileInf
         return ls::nullopt;
     }
 
-    return ProjectFileInfo{ .name = std::string(name_json.value_unsafe()) };
+    auto project_info = ProjectFileInfo{ .name = std::string(name_json.value_unsafe()) };
+    if (auto format_json = doc["texture_cook_format"].get_uint64(); !format_json.error()) {
+        auto format = format_json.value_unsafe();
+        if (format <= std::to_underlying(lr::TextureCookFormat::ETC1S)) {
+            project_info.texture_cook_format = static_cast<lr::TextureCookFormat>(format);
+        }
+    }
+
+    return project_info;
+}
+
+static auto write_project_file(const fs::path &path, const ProjectFileInfo &info) -> bool {
+    ZoneScoped;
+
+    lr::JsonWriter json;
+    json.begin_obj();
+    json["name"] = info.name;
+    json["texture_cook_format"] = std::to_underlying(info.texture_cook_format);
+    json.end_obj();
+
+    lr::File file(path, lr::FileAccess::Write);
+    if (!file) {
+        LOG_ERROR("Failed to open file {}!", path);
+        return false;
+    }
+
+    auto json_str = json.stream.view();
+    file.write(json_str.data(), json_str.length());
+    file.close();
+
+    return true;
 }
 
 auto EditorModule::load_editor_data(this EditorModule &self) -> void {
@@ -162,22 +192,12 @@ auto EditorModule::new_project(this EditorModule &self, const fs::path &root_pat
         }
     }
 
-    lr::JsonWriter json;
-    json.begin_obj();
-    json["name"] = name;
-    json.end_obj();
-
-    lr::File file(proj_file_path, lr::FileAccess::Write);
-    if (!file) {
-        LOG_ERROR("Failed to open file {}!", proj_file_path);
+    if (!write_project_file(proj_file_path, ProjectFileInfo{ .name = name })) {
         return nullptr;
     }
 
-    auto json_str = json.stream.view();
-    file.write(json_str.data(), json_str.length());
-    file.close();
-
     auto project = std::make_unique<Project>(proj_root_path, name);
+    project->file_path = proj_file_path;
     self.recent_project_infos.emplace(proj_file_path, ProjectFileInfo{ .name = name });
     self.save_editor_data();
 
@@ -195,6 +215,7 @@ auto EditorModule::open_project(this EditorModule &self, const fs::path &path) -
 
     auto project_info = read_project_file(path);
     auto project = std::make_unique<Project>(proj_root_dir, project_info.value());
+    project->file_path = path;
     self.recent_project_infos.emplace(path, ProjectFileInfo{ .name = project->name });
     self.save_editor_data();
 
@@ -204,6 +225,8 @@ auto EditorModule::open_project(this EditorModule &self, const fs::path &path) -
 auto EditorModule::save_project(this EditorModule &, std::unique_ptr<Project> &project) -> void {
     ZoneScoped;
 
+    write_project_file(project->file_path, ProjectFileInfo{ .name = project->name, .texture_cook_format = project->texture_cook_format });
+
     if (!project->active_scene_uuid) {
         return;
     }
@@ -218,6 +241,16 @@ auto EditorModule::set_active_project(this EditorModule &self, std::unique_ptr<P
     ZoneScoped;
 
     self.active_project = std::move(project);
+
+    auto &asset_man = lr::App::mod<lr::AssetManager>();
+    if (self.active_project) {
+        asset_man.texture_cook_format = self.active_project->texture_cook_format;
+        asset_man.open_project_cache(self.active_project->root_dir);
+    }
+
+    if (self.active_project && !asset_man.watch_project(self.active_project->root_dir)) {
+        LOG_WARN("Hot reload is not available for project '{}'.", self.active_project->name);
+    }
 }
 
 auto EditorModule::get_asset_texture(this EditorModule &self, lr::Asset *asset) -> lr::Texture * {
@@ -278,9 +311,22 @@ bool EditorModule::update(this EditorModule &self, f64 delta_time) {
     swapchain_attachment = vuk::clear_image(std::move(swapchain_attachment), vuk::Black<f32>);
     imgui_renderer.begin_frame(delta_time, swapchain_attachment->extent);
 
+    self.file_events = asset_man.poll_file_changes();
+    asset_man.poll_loads();
+    asset_man.texture_streamer.update(asset_man);
+    asset_man.mesh_streamer.update(asset_man);
+
     if (self.active_project) {
         const auto &active_scene_uuid = self.active_project->active_scene_uuid;
         if (active_scene_uuid) {
+            // Active scene might be reloaded, its entities are gone.
+            auto *active_scene_asset = asset_man.get_asset(active_scene_uuid);
+            for (const auto &event : self.file_events) {
+                if (active_scene_asset && event.file_name == active_scene_asset->path) {
+                    self.active_project->selected_entity = {};
+                }
+            }
+
             auto *active_scene = asset_man.get_scene(active_scene_uuid);
             active_scene->tick(static_cast<f32>(delta_time));
         }
@@ -339,6 +385,12 @@ static auto draw_menu_bar(EditorModule &self) -> void {
                 self.save_project(self.active_project);
             }
 
+            if (ImGui::MenuItem("Pack Project", nullptr, false, self.active_project != nullptr)) {
+                auto &asset_man = lr::App::mod<lr::AssetManager>();
+                const auto &root_dir = self.active_project->root_dir;
+                asset_man.pack_project(root_dir, root_dir / lr::AssetPack::DEFAULT_FILE_NAME);
+            }
+
             ImGui::Separator();
 
             if (ImGui::MenuItem("Exit")) {
@@ -348,6 +400,31 @@ static auto draw_menu_bar(EditorModule &self) -> void {
             ImGui::EndMenu();
         }
 
+        if (ImGui::BeginMenu("Project", self.active_project != nullptr)) {
+            if (ImGui::BeginMenu("Texture Format")) {
+                constexpr static ls::pair<lr::TextureCookFormat, const c8 *> cook_formats[] = {
+                    { lr::TextureCookFormat::BC7, "BC7" },
+                    { lr::TextureCookFormat::UASTC, "UASTC (KTX2)" },
+                    { lr::TextureCookFormat::ETC1S, "ETC1S (KTX2)" },
+                };
+                for (const auto &[cook_format, cook_format_name] : cook_formats) {
+                    auto &project = self.active_project;
+                    if (ImGui::MenuItem(cook_format_name, nullptr, project->texture_cook_format == cook_format)) {
+                        // Textures loaded from now on are cooked into it, existing
+                        // cooks stay in cache for switching back.
+                        auto &asset_man = lr::App::mod<lr::AssetManager>();
+                        project->texture_cook_format = cook_format;
+                        asset_man.texture_cook_format = cook_format;
+                        write_project_file(project->file_path, ProjectFileInfo{ .name = project->name, .texture_cook_format = cook_format });
+                    }
+                }
+
+                ImGui::EndMenu();
+            }
+
+            ImGui::EndMenu();
+        }
+
         if (ImGui::BeginMenu("View")) {
             if (ImGui::MenuItem("Frame Profiler")) {
                 self.show_profiler = !self.show_profiler;
@@ -19,6 +19,8 @@ struct EditorModule {
 
     ankerl::unordered_dense::map<std::string, lr::UUID> editor_assets = {};
     lr::FrameProfiler frame_profiler = {};
+    // Changes in project directory, polled once per frame.
+    std::vector<lr::FileEvent> file_events = {};
 
     bool show_profiler = false;
     bool show_debug = false;
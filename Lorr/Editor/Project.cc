@@ -4,7 +4,10 @@
 #include "Engine/Core/App.hh"
 
 namespace led {
-Project::Project(fs::path root_path_, const ProjectFileInfo &info_) : root_dir(std::move(root_path_)), name(info_.name) {}
+Project::Project(fs::path root_path_, const ProjectFileInfo &info_) :
+    root_dir(std::move(root_path_)),
+    name(info_.name),
+    texture_cook_format(info_.texture_cook_format) {}
 Project::Project(fs::path root_path_, std::string name_) : root_dir(std::move(root_path_)), name(std::move(name_)) {}
 Project::~Project() {
     ZoneScoped;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Asset/TextureFile.hh"
 #include "Engine/Asset/UUID.hh"
 
 #include <flecs.h>
@@ -8,6 +9,8 @@ namespace led {
 // Contents of lrproj file.
 struct ProjectFileInfo {
     std::string name = {};
+    // What PNG/JPEG textures of the project are cooked into.
+    lr::TextureCookFormat texture_cook_format = lr::TextureCookFormat::BC7;
 };
 
 enum class ActiveTool : u32 {
@@ -20,7 +23,9 @@ enum class ActiveTool : u32 {
 
 struct Project {
     fs::path root_dir = {};
+    fs::path file_path = {};
     std::string name = {};
+    lr::TextureCookFormat texture_cook_format = lr::TextureCookFormat::BC7;
     flecs::entity selected_entity = {};
     ActiveTool active_tool = ActiveTool::Cursor;
     lr::UUID active_scene_uuid = lr::UUID(nullptr);
@@ -30,9 +30,15 @@ struct AssetDirectoryCallbacks {
     void (*on_new_asset)(void *user_data, lr::UUID &asset_uuid) = nullptr;
 };
 
-auto populate_directory(AssetDirectory *dir, const AssetDirectoryCallbacks &callbacks) -> void {
+// Without `import_assets` only files registered already are shown.
+auto populate_directory(AssetDirectory *dir, const AssetDirectoryCallbacks &callbacks, bool import_assets = true) -> void {
     for (const auto &entry : fs::directory_iterator(dir->path)) {
         const auto &path = entry.path();
+        // Engine data like `.cache`, not assets
+        if (entry.is_directory() && path.filename().string().starts_with('.')) {
+            continue;
+        }
+
         if (entry.is_directory()) {
             AssetDirectory *cur_subdir = nullptr;
             auto dir_it = std::ranges::find_if(dir->subdirs, [&](const auto &v) { return path == v->path; });
@@ -47,9 +53,9 @@ auto populate_directory(AssetDirectory *dir, const AssetDirectoryCallbacks &call
                 cur_subdir = dir_it->get();
             }
 
-            populate_directory(cur_subdir, callbacks);
+            populate_directory(cur_subdir, callbacks, import_assets);
         } else if (entry.is_regular_file()) {
-            auto new_asset_uuid = dir->add_asset(path);
+            auto new_asset_uuid = import_assets ? dir->add_asset(path) : dir->show_asset(path);
             if (callbacks.on_new_asset) {
                 callbacks.on_new_asset(callbacks.user_data, new_asset_uuid);
             }
@@ -93,13 +99,50 @@ auto AssetDirectory::add_asset(this AssetDirectory &self, const fs::path &path)
     return asset_uuid;
 }
 
+auto AssetDirectory::show_asset(this AssetDirectory &self, const fs::path &path) -> lr::UUID {
+    auto &asset_man = lr::App::mod<lr::AssetManager>();
+    auto asset_type = asset_man.to_asset_type(asset_man.to_asset_file_type(path));
+    if (asset_type == lr::AssetType::None) {
+        return lr::UUID(nullptr);
+    }
+
+    auto asset_uuid = asset_man.find_asset(path, asset_type);
+    if (!asset_uuid) {
+        return lr::UUID(nullptr);
+    }
+
+    self.asset_uuids.emplace(asset_uuid);
+
+    return asset_uuid;
+}
+
+auto AssetDirectory::remove_asset(this AssetDirectory &self, const fs::path &path) -> void {
+    // Only the browser entry goes away, scenes might still be using the
+    // asset. Whoever owns it decides what happens to it.
+    auto &asset_man = lr::App::mod<lr::AssetManager>();
+    for (const auto &asset_uuid : self.asset_uuids) {
+        auto *asset = asset_man.get_asset(asset_uuid);
+        if (asset && asset->path == path) {
+            self.asset_uuids.erase(asset_uuid);
+            return;
+        }
+    }
+}
+
+auto AssetDirectory::forget_assets(this AssetDirectory &self) -> void {
+    self.asset_uuids.clear();
+    for (auto &subdir : self.subdirs) {
+        subdir->forget_assets();
+    }
+}
+
 auto AssetDirectory::refresh(this AssetDirectory &self) -> void {
     populate_directory(&self, {});
 }
 
 AssetBrowserWindow::AssetBrowserWindow(std::string name_, bool open_) : IWindow(std::move(name_), open_) {}
 
-auto AssetBrowserWindow::add_directory(this AssetBrowserWindow &self, const fs::path &path) -> std::unique_ptr<AssetDirectory> {
+auto AssetBrowserWindow::add_directory(this AssetBrowserWindow &self, const fs::path &path, bool import_assets) -> std::unique_ptr<AssetDirectory> {
     AssetDirectory *parent = nullptr;
     if (path.has_parent_path()) {
         parent = self.find_directory(path.parent_path());
@@ -117,13 +160,13 @@ auto AssetBrowserWindow::add_directory(this AssetBrowserWindow &self, const fs::
         // This is intentional. You should find this new child directory
         // through `::find_directory`.
         auto dir = std::make_unique<AssetDirectory>(path, parent);
-        populate_directory(dir.get(), {});
+        populate_directory(dir.get(), {}, import_assets);
         parent->add_subdir(std::move(dir));
         return nullptr;
     }
 
     auto dir = std::make_unique<AssetDirectory>(path, nullptr);
-    populate_directory(dir.get(), {});
+    populate_directory(dir.get(), {}, import_assets);
 
     return dir;
 }
@@ -184,6 +227,48 @@ auto AssetBrowserWindow::find_directory(this AssetBrowserWindow &self, const fs:
     return cur_dir;
 }
 
+auto AssetBrowserWindow::apply_file_events(this AssetBrowserWindow &self, ls::span<const lr::FileEvent> events) -> void {
+    ZoneScoped;
+
+    if (!self.home_dir) {
+        return;
+    }
+
+    for (const auto &event : events) {
+        const auto &path = event.file_name;
+        auto *parent_dir = self.find_directory(path.parent_path());
+        if (!parent_dir) {
+            continue;
+        }
+
+        if (event.action_mask & lr::FileActionMask::Directory) {
+            if (path.filename().string().starts_with('.')) {
+                continue;
+            }
+
+            // Files inside have their own events, they are imported.
+            if (event.action_mask & lr::FileActionMask::Create) {
+                self.add_directory(path, false);
+            } else if (event.action_mask & lr::FileActionMask::Delete) {
+                if (auto *dir = self.find_directory(path); dir && dir != self.home_dir.get()) {
+                    // Deleted from disk, keep its assets registered same as `remove_asset`.
+                    dir->forget_assets();
+                    self.remove_directory(dir);
+                }
+            }
+
+            continue;
+        }
+
+        // `AssetManager::poll_file_changes` imported new files already.
+        if (event.action_mask & lr::FileActionMask::Create) {
+            parent_dir->show_asset(path);
+        } else if (event.action_mask & lr::FileActionMask::Delete) {
+            parent_dir->remove_asset(path);
+        }
+    }
+}
+
 static auto draw_dir_contents(AssetBrowserWindow &self) -> void {
     auto &asset_man = lr::App::mod<lr::AssetManager>();
     auto &imgui_renderer = lr::App::mod<lr::ImGuiRenderer>();
@@ -460,6 +545,8 @@ void AssetBrowserWindow::render(this AssetBrowserWindow &self) {
         self.home_dir = std::move(new_home_dir);
     }
 
+    self.apply_file_events(editor.file_events);
+
     if (ImGui::Begin(self.name.data(), nullptr, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse)) {
         if (editor.active_project) {
             draw_file_paths(self);
@@ -4,6 +4,8 @@
 
 #include "Engine/Asset/UUID.hh"
 
+#include "Engine/OS/OS.hh"
+
 namespace led {
 struct AssetDirectory {
     fs::path path = {};
@@ -17,6 +19,14 @@ struct AssetDirectory {
     auto add_subdir(this AssetDirectory &, const fs::path &path) -> AssetDirectory *;
     auto add_subdir(this AssetDirectory &, std::unique_ptr<AssetDirectory> &&directory) -> AssetDirectory *;
     auto add_asset(this AssetDirectory &, const fs::path &path) -> lr::UUID;
+    // Adds browser entry of an asset that is registered already, nothing
+    // is imported.
+    auto show_asset(this AssetDirectory &, const fs::path &path) -> lr::UUID;
+    // Drops browser entry only, asset stays registered.
+    auto remove_asset(this AssetDirectory &, const fs::path &path) -> void;
+    // Same as `remove_asset` for every asset in the tree, destroying the
+    // directory then leaves them alone.
+    auto forget_assets(this AssetDirectory &) -> void;
 
     auto refresh(this AssetDirectory &) -> void;
 };
@@ -27,10 +37,13 @@ struct AssetBrowserWindow : IWindow {
 
     AssetBrowserWindow(std::string name_, bool open_ = true);
 
-    auto add_directory(this AssetBrowserWindow &, const fs::path &path) -> std::unique_ptr<AssetDirectory>;
+    auto add_directory(this AssetBrowserWindow &, const fs::path &path, bool import_assets = true) -> std::unique_ptr<AssetDirectory>;
     auto remove_directory(this AssetBrowserWindow &, const fs::path &path) -> void;
     auto remove_directory(this AssetBrowserWindow &, AssetDirectory *directory) -> void;
     auto find_directory(this AssetBrowserWindow &, const fs::path &path) -> AssetDirectory *;
+    // Patch directory tree with changes reported by asset manager,
+    // instead of rescanning everything.
+    auto apply_file_events(this AssetBrowserWindow &, ls::span<const lr::FileEvent> events) -> void;
 
     void render(this AssetBrowserWindow &);
     void do_render(vuk::Swapchain &) override {
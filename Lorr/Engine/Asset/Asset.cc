@@ -1,8 +1,12 @@
 #include "Engine/Asset/Asset.hh"
 
+#include "Engine/Asset/MipChain.hh"
+#include "Engine/Asset/ModelFile.hh"
 #include "Engine/Asset/ParserGLTF.hh"
 #include "Engine/Asset/ParserKTX2.hh"
 #include "Engine/Asset/ParserSTB.hh"
+#include "Engine/Asset/TextureFile.hh"
+#include "Engine/Asset/VertexQuantization.hh"
 
 #include "Engine/Core/App.hh"
 
@@ -14,12 +18,14 @@
 #include "Engine/Memory/Stack.hh"
 
 #include "Engine/OS/File.hh"
+#include "Engine/OS/Timer.hh"
 
 #include "Engine/Scene/ECSModule/Core.hh"
 
 #include <ankerl/svector.h>
 #include <meshoptimizer.h>
 #include <simdjson.h>
+#include <xxhash.h>
 
 namespace lr {
 template<glm::length_t N, typename T>
@@ -100,8 +106,11 @@ auto end_asset_meta(JsonWriter &json, const fs::path &path) -> bool {
 
     json.end_obj();
 
+    // Renamed over the old one, directory mtime changes and registry
+    // snapshot picks the new contents up.
     auto meta_path = path.string() + ".lrasset";
-    File file(meta_path, FileAccess::Write);
+    auto temp_path = meta_path + ".tmp";
+    File file(temp_path, FileAccess::Write);
     if (!file) {
         return false;
     }
@@ -109,18 +118,98 @@ auto end_asset_meta(JsonWriter &json, const fs::path &path) -> bool {
     file.write(json.stream.view().data(), json.stream.view().length());
     file.close();
 
+    auto ec = std::error_code{};
+    fs::rename(temp_path, meta_path, ec);
+    if (ec) {
+        LOG_ERROR("Failed to write meta file '{}'! {}", meta_path, ec.message());
+        fs::remove(temp_path, ec);
+        return false;
+    }
+
     return true;
 }
 
-auto AssetManager::init(this AssetManager &) -> bool {
+auto AssetManager::init(this AssetManager &self) -> bool {
     ZoneScoped;
 
+    // Engine assets are cooked too, projects move it with `open_project_cache`
+    if (!self.derived_data_cache.init(self.root_path / ".cache")) {
+        LOG_WARN("Derived data cache is not available, assets will be cooked on every load.");
+    }
+
     return true;
 }
 
 auto AssetManager::destroy(this AssetManager &self) -> void {
     ZoneScoped;
 
+    // Loading jobs refer to the manager, they also lock requests while loading.
+    auto load_requests = std::vector<AssetLoadHandle>();
+    {
+        auto lock = std::unique_lock(self.load_requests_mutex);
+        for (auto &[uuid, request] : self.load_requests) {
+            load_requests.push_back(request);
+        }
+    }
+
+    for (auto &request : load_requests) {
+        request->wait();
+    }
+
+    self.file_watcher.destroy();
+    self.save_registry_snapshot();
+
+    auto streaming_stats = self.texture_streamer.stats();
+    LOG_INFO(
+        "Texture streaming: {} streamed textures, {} MiB resident ({} MiB not streamable) of {} MiB budget.",
+        streaming_stats.streamed_texture_count,
+        streaming_stats.resident_size / (1024 * 1024),
+        streaming_stats.fixed_size / (1024 * 1024),
+        streaming_stats.budget / (1024 * 1024)
+    );
+    self.texture_streamer.destroy();
+
+    auto mesh_streaming_stats = self.mesh_streamer.stats();
+    LOG_INFO(
+        "Mesh streaming: {} streamed primitives, {} MiB resident ({} MiB not streamable) of {} MiB budget.",
+        mesh_streaming_stats.streamed_primitive_count,
+        mesh_streaming_stats.resident_size / (1024 * 1024),
+        mesh_streaming_stats.fixed_size / (1024 * 1024),
+        mesh_streaming_stats.budget / (1024 * 1024)
+    );
+    self.mesh_streamer.destroy(self);
+
+    auto asset_cache_stats = self.asset_cache.stats();
+    LOG_INFO(
+        "Asset cache: {} hits, {} misses, {} evictions, {} cached assets, {} MiB CPU of {} MiB, {} MiB GPU of {} MiB budget.",
+        asset_cache_stats.hit_count,
+        asset_cache_stats.miss_count,
+        asset_cache_stats.eviction_count,
+        asset_cache_stats.cached_count,
+        asset_cache_stats.cpu_size / (1024 * 1024),
+        asset_cache_stats.cpu_budget / (1024 * 1024),
+        asset_cache_stats.gpu_size / (1024 * 1024),
+        asset_cache_stats.gpu_budget / (1024 * 1024)
+    );
+
+    auto cache_stats = self.derived_data_cache.stats();
+    LOG_INFO(
+        "Derived data cache: {} hits, {} misses, {} MiB served, {} MiB saved by compression.",
+        cache_stats.hit_count,
+        cache_stats.miss_count,
+        cache_stats.hit_bytes / (1024 * 1024),
+        cache_stats.compressed_bytes_saved / (1024 * 1024)
+    );
+
+    auto job_stats = App::get().job_man.stats();
+    LOG_INFO(
+        "Jobs: {} completed, {:.1f} us average latency ({:.1f} us max), {:.1f} us average run time.",
+        job_stats.completed_job_count,
+        job_stats.avg_latency_us,
+        job_stats.max_latency_us,
+        job_stats.avg_run_time_us
+    );
+
     auto read_lock = std::shared_lock(self.registry_mutex);
 
     for (const auto &[asset_uuid, asset] : self.registry) {
@@ -194,6 +283,22 @@ auto AssetManager::to_asset_file_type(this AssetManager &, const fs::path &path)
     }
 }
 
+auto AssetManager::to_asset_type(this AssetManager &, AssetFileType file_type) -> AssetType {
+    switch (file_type) {
+        case AssetFileType::GLB:
+        case AssetFileType::GLTF:
+            return AssetType::Model;
+        case AssetFileType::PNG:
+        case AssetFileType::JPEG:
+        case AssetFileType::KTX2:
+            return AssetType::Texture;
+        case AssetFileType::JSON:
+            return AssetType::Scene;
+        default:
+            return AssetType::None;
+    }
+}
+
 auto AssetManager::to_asset_type_sv(this AssetManager &, AssetType type) -> std::string_view {
     ZoneScoped;
 
@@ -238,6 +343,7 @@ auto AssetManager::create_asset(this AssetManager &self, AssetType type, const f
     asset.uuid = uuid;
     asset.type = type;
     asset.path = path;
+    self.asset_paths.emplace(ls::pair(asset.path, asset.type), uuid);
 
     return asset.uuid;
 }
@@ -256,7 +362,7 @@ auto AssetManager::init_new_scene(this AssetManager &self, const UUID &uuid, con
     return true;
 }
 
-auto AssetManager::import_asset(this AssetManager &self, const fs::path &path) -> UUID {
+auto AssetManager::import_asset(this AssetManager &self, const fs::path &path, ls::option<TextureInfo> texture_info) -> UUID {
     ZoneScoped;
     memory::ScopedStack stack;
 
@@ -266,7 +372,8 @@ auto AssetManager::import_asset(this AssetManager &self, const fs::path &path) -
     }
 
     auto asset_type = AssetType::None;
-    switch (self.to_asset_file_type(path)) {
+    auto file_type = self.to_asset_file_type(path);
+    switch (file_type) {
         case AssetFileType::Meta: {
             return self.register_asset(path);
         }
@@ -303,9 +410,21 @@ auto AssetManager::import_asset(this AssetManager &self, const fs::path &path) -
     switch (asset_type) {
         case AssetType::Model: {
             auto gltf_model = GLTFModelInfo::parse_info(path);
+            auto texture_infos = std::vector<TextureInfo>(gltf_model->textures.size());
+            for (const auto &gltf_material : gltf_model->materials) {
+                if (auto tex_idx = gltf_material.normal_texture_index; tex_idx.has_value()) {
+                    texture_infos[tex_idx.value()].kind = TextureKind::Normal;
+                }
+
+                auto alpha_mode = static_cast<AlphaMode>(gltf_material.alpha_mode);
+                if (auto tex_idx = gltf_material.albedo_texture_index; tex_idx.has_value() && alpha_mode == AlphaMode::Mask) {
+                    texture_infos[tex_idx.value()].alpha_cutoff = gltf_material.alpha_cutoff;
+                }
+            }
+
             auto textures = std::vector<UUID>();
             auto embedded_textures = std::vector<UUID>();
-            for (auto &v : gltf_model->textures) {
+            for (const auto &[v, texture_info] : std::views::zip(gltf_model->textures, texture_infos)) {
                 auto &image = gltf_model->images[v.image_index.value()];
                 auto &texture_uuid = textures.emplace_back();
                 std::visit(
@@ -315,7 +434,7 @@ auto AssetManager::import_asset(this AssetManager &self, const fs::path &path) -
                             embedded_textures.push_back(texture_uuid);
                         },
                         [&](const fs::path &image_path) { //
-                            texture_uuid = self.import_asset(image_path);
+                            texture_uuid = self.import_asset(image_path, texture_info);
                         },
                     },
                     image.image_data
@@ -368,647 +487,2112 @@ auto AssetManager::import_asset(this AssetManager &self, const fs::path &path) -
         return UUID(nullptr);
     }
 
+    // Only models know the material slot of a texture, anything else is
+    // cooked on its first load.
+    auto is_cookable = file_type == AssetFileType::PNG || file_type == AssetFileType::JPEG;
+    if (is_cookable && texture_info.has_value()) {
+        self.cook_texture(path, texture_info->kind == TextureKind::Normal, texture_info->alpha_cutoff);
+    }
+
     return uuid;
 }
 
-auto AssetManager::import_project(this AssetManager &self, const fs::path &path) -> void {
+auto AssetManager::cook_texture(this AssetManager &self, const fs::path &path, bool normal, f32 alpha_cutoff) -> void {
     ZoneScoped;
 
-    for (const auto &entry : fs::recursive_directory_iterator(path)) {
-        const auto &cur_path = entry.path();
-        self.import_asset(cur_path);
+    {
+        auto lock = std::unique_lock(self.cook_mutex);
+        if (!self.cooking_textures.emplace(path).second) {
+            return;
+        }
     }
+
+    // Hashing reads the whole source, keep it off the calling thread too.
+    // Every texture gets its own job, encoder spreads each one over all
+    // cores as well.
+    auto job = Job::create([&self, path, normal, alpha_cutoff, cook_format = self.texture_cook_format]() {
+        LS_DEFER(&) {
+            auto lock = std::unique_lock(self.cook_mutex);
+            self.cooking_textures.erase(path);
+        };
+
+        auto source_hash = self.derived_data_cache.hash_file(path);
+        if (!source_hash.has_value()) {
+            return;
+        }
+
+        auto key = self.derived_data_cache.make_key(source_hash.value(), TextureFile::params_hash(normal, alpha_cutoff, cook_format));
+        if (self.derived_data_cache.contains(key)) {
+            return;
+        }
+
+        auto image_bytes = File::to_bytes(path);
+        if (image_bytes.empty()) {
+            return;
+        }
+
+        auto cooked_data = cook_format == TextureCookFormat::BC7 ? TextureFile::cook(image_bytes, normal, alpha_cutoff)
+                                                                 : TextureFile::cook_ktx2(image_bytes, normal, alpha_cutoff, cook_format);
+        if (!cooked_data.empty() && self.derived_data_cache.put(key, cooked_data)) {
+            LOG_TRACE("Cooked texture '{}'.", path);
+        }
+    });
+    App::submit_job(std::move(job));
 }
 
-struct AssetMetaFile {
-    simdjson::padded_string contents;
-    simdjson::ondemand::parser parser;
-    simdjson::simdjson_result<simdjson::ondemand::document> doc;
+struct AssetMetaHeader {
+    UUID uuid = {};
+    AssetType type = AssetType::None;
+    i64 meta_time = 0;
+    u64 meta_size = 0;
+    std::vector<UUID> dependencies = {};
 };
 
-auto read_meta_file(const fs::path &path) -> std::unique_ptr<AssetMetaFile> {
+// Only what the registry needs. `parser` and `contents` are reused between
+// calls, every thread brings its own.
+static auto read_meta_header(const fs::path &path, simdjson::ondemand::parser &parser, std::vector<c8> &contents) -> ls::option<AssetMetaHeader> {
     ZoneScoped;
 
-    if (!path.has_extension() || path.extension() != ".lrasset") {
-        LOG_ERROR("'{}' is not a valid asset file. It must end with .lrasset", path);
-        return nullptr;
-    }
+    // Taken before reading, a write in between shows up as a change next time.
+    auto ec = std::error_code{};
+    auto meta_time = fs::last_write_time(path, ec).time_since_epoch().count();
 
     File file(path, FileAccess::Read);
     if (!file) {
         LOG_ERROR("Failed to open file {}!", path);
-        return nullptr;
+        return ls::nullopt;
     }
 
-    auto result = std::make_unique<AssetMetaFile>();
-    result->contents = simdjson::padded_string(file.size);
-    file.read(result->contents.data(), file.size);
-    result->doc = result->parser.iterate(result->contents);
-    if (result->doc.error()) {
-        LOG_ERROR("Failed to parse asset meta file! {}", simdjson::error_message(result->doc.error()));
-        return nullptr;
+    contents.resize(file.size + simdjson::SIMDJSON_PADDING);
+    if (file.read(contents.data(), file.size) != file.size) {
+        LOG_ERROR("Failed to read file {}!", path);
+        return ls::nullopt;
     }
 
-    return result;
-}
-
-auto AssetManager::register_asset(this AssetManager &self, const fs::path &path) -> UUID {
-    ZoneScoped;
-    memory::ScopedStack stack;
-
-    auto meta_json = read_meta_file(path);
-    if (!meta_json) {
-        return UUID(nullptr);
+    auto doc = parser.iterate(contents.data(), file.size, contents.size());
+    if (doc.error()) {
+        LOG_ERROR("Failed to parse asset meta file '{}'! {}", path, simdjson::error_message(doc.error()));
+        return ls::nullopt;
     }
 
-    auto uuid_json = meta_json->doc["uuid"].get_string();
+    auto uuid_json = doc["uuid"].get_string();
     if (uuid_json.error()) {
-        LOG_ERROR("Failed to read asset meta file. `uuid` is missing.");
-        return UUID(nullptr);
+        LOG_ERROR("Failed to read asset meta file '{}'. `uuid` is missing.", path);
+        return ls::nullopt;
     }
 
-    auto type_json = meta_json->doc["type"].get_number();
-    if (type_json.error()) {
-        LOG_ERROR("Failed to read asset meta file. `type` is missing.");
-        return UUID(nullptr);
+    auto uuid = UUID::from_string(uuid_json.value_unsafe());
+    if (!uuid.has_value()) {
+        LOG_ERROR("Failed to read asset meta file '{}'. `uuid` is corrupt.", path);
+        return ls::nullopt;
     }
 
-    auto asset_path = path;
-    asset_path.replace_extension("");
-    auto uuid = UUID::from_string(uuid_json.value_unsafe()).value();
-    auto type = static_cast<AssetType>(type_json.value_unsafe().get_uint64());
-
-    if (!self.register_asset(uuid, type, asset_path)) {
-        return UUID(nullptr);
+    auto type_json = doc["type"].get_uint64();
+    if (type_json.error()) {
+        LOG_ERROR("Failed to read asset meta file '{}'. `type` is missing.", path);
+        return ls::nullopt;
     }
 
-    return uuid;
-}
-
-auto AssetManager::register_asset(this AssetManager &self, const UUID &uuid, AssetType type, const fs::path &path) -> bool {
-    ZoneScoped;
+    auto meta_header = AssetMetaHeader{
+        .uuid = uuid.value(),
+        .type = static_cast<AssetType>(type_json.value_unsafe()),
+        .meta_time = meta_time,
+        .meta_size = file.size,
+    };
 
-    auto write_lock = std::unique_lock(self.registry_mutex);
-    auto [asset_it, inserted] = self.registry.try_emplace(uuid);
-    if (!inserted) {
-        if (asset_it != self.registry.end()) {
-            // Tried a reinsert, asset already exists
-            return true;
+    // Embedded assets of models, they only get registered once the model loads.
+    if (meta_header.type == AssetType::Model) {
+        if (auto embedded_textures_json = doc["embedded_textures"].get_array(); !embedded_textures_json.error()) {
+            for (auto embedded_texture_json : embedded_textures_json) {
+                auto embedded_texture_uuid = UUID::from_string(embedded_texture_json.get_string().value_unsafe());
+                if (embedded_texture_uuid.has_value()) {
+                    meta_header.dependencies.push_back(embedded_texture_uuid.value());
+                }
+            }
         }
 
-        return false;
-    }
-
-    auto &asset = asset_it->second;
-    asset.uuid = uuid;
-    asset.path = path;
-    asset.type = type;
-
-    return true;
-}
-
-auto AssetManager::load_asset(this AssetManager &self, const UUID &uuid) -> bool {
-    ZoneScoped;
+        if (auto embedded_materials_json = doc["embedded_materials"].get_array(); !embedded_materials_json.error()) {
+            for (auto embedded_material_json : embedded_materials_json) {
+                auto material_uuid_json = embedded_material_json["uuid"].get_string();
+                if (material_uuid_json.error()) {
+                    continue;
+                }
 
-    auto *asset = self.get_asset(uuid);
-    switch (asset->type) {
-        case AssetType::Model: {
-            return self.load_model(uuid);
-        }
-        case AssetType::Texture: {
-            return self.load_texture(uuid);
-        }
-        case AssetType::Scene: {
-            return self.load_scene(uuid);
+                if (auto material_uuid = UUID::from_string(material_uuid_json.value_unsafe()); material_uuid.has_value()) {
+                    meta_header.dependencies.push_back(material_uuid.value());
+                }
+            }
         }
-        default:;
     }
 
-    return false;
+    return meta_header;
 }
 
-auto AssetManager::unload_asset(this AssetManager &self, const UUID &uuid) -> bool {
+auto AssetManager::import_project(this AssetManager &self, const fs::path &path) -> void {
     ZoneScoped;
 
-    auto *asset = self.get_asset(uuid);
-    LS_EXPECT(asset);
-    switch (asset->type) {
-        case AssetType::Model: {
-            return self.unload_model(uuid);
-        } break;
-        case AssetType::Texture: {
-            return self.unload_texture(uuid);
-        } break;
-        case AssetType::Scene: {
-            return self.unload_scene(uuid);
-        } break;
-        default:;
-    }
+    //  ── SNAPSHOT ────────────────────────────────────────────────────────
+    // Everything keyed by project relative path, `.` for project root.
+    auto old_snapshot = RegistrySnapshot::read(path / ".cache" / RegistrySnapshot::FILE_NAME).value_or(RegistrySnapshot{});
+    auto parent_of = [](std::string_view relative_path) -> std::string_view {
+        auto separator = relative_path.rfind('/');
+        return separator == std::string_view::npos ? std::string_view(".") : relative_path.substr(0, separator);
+    };
 
-    return false;
-}
+    auto old_directory_times = ankerl::unordered_dense::map<std::string_view, i64>();
+    auto old_directory_children = ankerl::unordered_dense::map<std::string_view, std::vector<std::string_view>>();
+    for (const auto &directory : old_snapshot.directories) {
+        old_directory_times.emplace(directory.path, directory.time);
+        if (directory.path != ".") {
+            old_directory_children[parent_of(directory.path)].push_back(directory.path);
+        }
+    }
 
-auto AssetManager::load_model(this AssetManager &self, const UUID &uuid) -> bool {
-    ZoneScoped;
-    memory::ScopedStack stack;
+    auto old_directory_entries = ankerl::unordered_dense::map<std::string_view, std::vector<u32>>();
+    auto old_meta_entries = ankerl::unordered_dense::map<std::string_view, u32>();
+    for (u32 i = 0; i < old_snapshot.entries.size(); i++) {
+        const auto &entry = old_snapshot.entries[i];
+        old_directory_entries[parent_of(entry.meta_path)].push_back(i);
+        old_meta_entries.emplace(entry.meta_path, i);
+    }
+
+    //  ── DISCOVERY ───────────────────────────────────────────────────────
+    // Directories whose mtime didn't change have the same files as last
+    // time, their entries are taken from the snapshot without listing them.
+    auto snapshot = RegistrySnapshot{};
+    auto reused_entry_indices = std::vector<u32>();
+    auto meta_paths = std::vector<fs::path>();
+    auto source_paths = std::vector<fs::path>();
+    auto listed_meta_paths = ankerl::unordered_dense::set<fs::path>();
+    auto pending_directories = std::vector<fs::path>{ path };
+    while (!pending_directories.empty()) {
+        auto directory = std::move(pending_directories.back());
+        pending_directories.pop_back();
+
+        auto ec = std::error_code{};
+        auto directory_time = fs::last_write_time(directory, ec).time_since_epoch().count();
+        if (ec) {
+            continue;
+        }
 
-    auto *asset = self.get_asset(uuid);
-    if (asset->is_loaded()) {
-        // Model is collection of multiple assets and all child
-        // assets must be alive to safely process meshes.
-        // Don't acquire child refs.
-        asset->acquire_ref();
+        auto relative_path = directory.lexically_relative(path).generic_string();
+        auto old_time_it = old_directory_times.find(relative_path);
+        auto is_unchanged = old_time_it != old_directory_times.end() && old_time_it->second == directory_time;
+        snapshot.directories.push_back({ .path = relative_path, .time = directory_time });
+        if (is_unchanged) {
+            if (auto it = old_directory_entries.find(relative_path); it != old_directory_entries.end()) {
+                reused_entry_indices.insert(reused_entry_indices.end(), it->second.begin(), it->second.end());
+            }
 
-        return true;
-    }
+            if (auto it = old_directory_children.find(relative_path); it != old_directory_children.end()) {
+                for (const auto &child_path : it->second) {
+                    pending_directories.push_back(path / fs::path(child_path));
+                }
+            }
 
-    asset->model_id = self.models.create_slot();
-    auto *model = self.models.slot(asset->model_id);
+            continue;
+        }
 
-    fs::path meta_path = asset->path.string() + ".lrasset";
-    auto meta_json = read_meta_file(meta_path);
-    if (!meta_json) {
-        LOG_ERROR("Model assets require proper meta file.");
-        return false;
-    }
+        for (const auto &entry : fs::directory_iterator(directory, ec)) {
+            const auto &cur_path = entry.path();
+            if (entry.is_directory(ec)) {
+                // Engine data like `.cache`, not assets
+                if (!cur_path.filename().string().starts_with('.')) {
+                    pending_directories.push_back(cur_path);
+                }
 
-    auto asset_path = asset->path;
-    asset->acquire_ref();
+                continue;
+            }
 
-    // Below we register new assets, which causes asset pointer to be invalidated.
-    // set this to nullptr so it's obvious when debugging.
-    asset = nullptr;
+            switch (self.to_asset_file_type(cur_path)) {
+                case AssetFileType::Meta: {
+                    listed_meta_paths.emplace(cur_path);
+                    auto old_it = old_meta_entries.find(cur_path.lexically_relative(path).generic_string());
+                    if (old_it != old_meta_entries.end()) {
+                        const auto &old_entry = old_snapshot.entries[old_it->second];
+                        auto meta_time = entry.last_write_time(ec).time_since_epoch().count();
+                        auto meta_size = entry.file_size(ec);
+                        if (!ec && meta_time == old_entry.meta_time && meta_size == old_entry.meta_size) {
+                            reused_entry_indices.push_back(old_it->second);
+                            break;
+                        }
+                    }
 
-    //  ── INITIAL PARSING ─────────────────────────────────────────────────
-    auto embedded_textures = std::vector<UUID>();
-    auto embedded_texture_uuids_json = meta_json->doc["embedded_textures"].get_array();
-    for (auto embedded_texture_uuid_json : embedded_texture_uuids_json) {
-        auto embedded_texture_uuid_str = embedded_texture_uuid_json.get_string();
-        if (embedded_texture_uuid_str.error()) {
-            LOG_ERROR("Failed to import model {}! An embedded texture with corrupt UUID.", asset_path);
-            return false;
+                    meta_paths.push_back(cur_path);
+                } break;
+                case AssetFileType::GLB:
+                case AssetFileType::GLTF:
+                case AssetFileType::PNG:
+                case AssetFileType::JPEG:
+                case AssetFileType::KTX2: {
+                    source_paths.push_back(cur_path);
+                } break;
+                default:;
+            }
         }
+    }
 
-        auto embedded_texture_uuid = UUID::from_string(embedded_texture_uuid_str.value_unsafe());
-        if (!embedded_texture_uuid.has_value()) {
-            LOG_ERROR("Failed to import model {}! An embedded texture with corrupt UUID.", asset_path);
-            return false;
+    //  ── META PARSING ────────────────────────────────────────────────────
+    // Chunks of meta files are spread over workers, parser and read buffer
+    // are reused within a chunk.
+    auto meta_headers = std::vector<ls::option<AssetMetaHeader>>(meta_paths.size());
+    App::get().job_man.parallel_for(static_cast<u32>(meta_paths.size()), 32, [&](u32 first_meta, u32 last_meta) {
+        auto parser = simdjson::ondemand::parser();
+        auto contents = std::vector<c8>();
+        for (auto i = first_meta; i < last_meta; i++) {
+            meta_headers[i] = read_meta_header(meta_paths[i], parser, contents);
         }
+    });
 
-        embedded_textures.push_back(embedded_texture_uuid.value());
-        self.register_asset(embedded_texture_uuid.value(), AssetType::Texture, asset_path);
-    }
-
-    // Load registered UUIDs.
-    auto embedded_materials_json = meta_json->doc["embedded_materials"].get_array();
-    if (embedded_materials_json.error()) {
-        LOG_ERROR("Failed to import model {}! Missing materials filed.", asset_path);
-        return false;
+    //  ── REGISTRATION ────────────────────────────────────────────────────
+    for (auto entry_index : reused_entry_indices) {
+        snapshot.entries.push_back(std::move(old_snapshot.entries[entry_index]));
     }
 
-    auto embedded_material_infos = std::vector<MaterialInfo>();
-    for (auto embedded_material_json : embedded_materials_json) {
-        if (embedded_material_json.error()) {
-            LOG_ERROR("Failed to import model {}! A material with error.", asset_path);
-            return false;
+    for (auto &&[meta_path, meta_header] : std::views::zip(meta_paths, meta_headers)) {
+        if (!meta_header.has_value()) {
+            continue;
         }
 
-        if (auto material_uuid_json = embedded_material_json["uuid"]; !material_uuid_json.error()) {
-            auto material_uuid = UUID::from_string(material_uuid_json.value_unsafe());
-            if (!material_uuid.has_value()) {
-                LOG_ERROR("Failed to import model {}! A material with corrupt UUID.", asset_path);
-                return false;
+        snapshot.entries.push_back({
+            .uuid = meta_header->uuid,
+            .type = meta_header->type,
+            .meta_path = meta_path.lexically_relative(path).generic_string(),
+            .meta_time = meta_header->meta_time,
+            .meta_size = meta_header->meta_size,
+            .dependencies = std::move(meta_header->dependencies),
+        });
+    }
+
+    auto registered_count = 0_sz;
+    {
+        auto write_lock = std::unique_lock(self.registry_mutex);
+        self.registry.reserve(self.registry.size() + snapshot.entries.size());
+        for (const auto &entry : snapshot.entries) {
+            auto [asset_it, inserted] = self.registry.try_emplace(entry.uuid);
+            if (!inserted) {
+                continue;
             }
 
-            self.register_asset(material_uuid.value(), AssetType::Material, asset_path);
-            model->materials.emplace_back(material_uuid.value());
+            auto &asset = asset_it->second;
+            asset.uuid = entry.uuid;
+            asset.path = path / fs::path(entry.meta_path);
+            asset.path.replace_extension("");
+            asset.type = entry.type;
+            asset.dependencies = entry.dependencies;
+            self.asset_paths.emplace(ls::pair(asset.path, asset.type), entry.uuid);
+            registered_count++;
+
+            // Loads then don't hash sources that didn't change.
+            if (entry.source_hash.hash != 0) {
+                self.derived_data_cache.set_source_hash(asset.path, entry.source_hash);
+            }
         }
+    }
 
-        auto &material_info = embedded_material_infos.emplace_back();
-        auto &material = material_info.material;
-        if (auto member_json = embedded_material_json["albedo_color"]; !member_json.error()) {
-            json_to_vec(member_json.value_unsafe(), material.albedo_color);
-        }
-        if (auto member_json = embedded_material_json["emissive_color"]; !member_json.error()) {
-            json_to_vec(member_json.value_unsafe(), material.emissive_color);
-        }
-        if (auto member_json = embedded_material_json["roughness_factor"]; !member_json.error()) {
-            material.roughness_factor = static_cast<f32>(member_json.get_double().value_unsafe());
-        }
-        if (auto member_json = embedded_material_json["metallic_factor"]; !member_json.error()) {
-            material.metallic_factor = static_cast<f32>(member_json.get_double().value_unsafe());
-        }
-        if (auto member_json = embedded_material_json["alpha_mode"]; !member_json.error()) {
-            material.alpha_mode = static_cast<AlphaMode>(member_json.get_uint64().value_unsafe());
-        }
-        if (auto member_json = embedded_material_json["alpha_cutoff"]; !member_json.error()) {
-            material.alpha_cutoff = static_cast<f32>(member_json.get_double().value_unsafe());
+    //  ── NEW ASSETS ──────────────────────────────────────────────────────
+    // Importing writes meta files and models import their images, these
+    // stay serial so nothing gets two UUIDs. Their directories changed,
+    // next import picks their meta files up.
+    auto imported_count = 0_sz;
+    for (const auto &source_path : source_paths) {
+        auto meta_path = source_path;
+        meta_path += ".lrasset";
+        // Textures that are already imported get cooked on their first load,
+        // only material slots know what to cook them as.
+        if (listed_meta_paths.contains(meta_path)) {
+            continue;
         }
-        if (auto member_json = embedded_material_json["albedo_texture"]; !member_json.error()) {
-            material.albedo_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
-            material_info.albedo_texture_info.use_srgb = true;
-        }
-        if (auto member_json = embedded_material_json["normal_texture"]; !member_json.error()) {
-            material.normal_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
-            material_info.normal_texture_info.use_srgb = false;
-        }
-        if (auto member_json = embedded_material_json["emissive_texture"]; !member_json.error()) {
-            material.emissive_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
-            material_info.emissive_texture_info.use_srgb = true;
-        }
-        if (auto member_json = embedded_material_json["metallic_roughness_texture"]; !member_json.error()) {
-            material.metallic_roughness_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
-            material_info.metallic_roughness_texture_info.use_srgb = false;
-        }
-        if (auto member_json = embedded_material_json["occlusion_texture"]; !member_json.error()) {
-            material.occlusion_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
-            material_info.occlusion_texture_info.use_srgb = false;
+
+        if (self.import_asset(source_path)) {
+            imported_count++;
         }
     }
 
-    for (const auto &[material_uuid, material_info] : std::views::zip(model->materials, embedded_material_infos)) {
-        self.load_material(material_uuid, material_info);
-    }
+    LOG_INFO(
+        "Imported project '{}', {} assets registered ({} from snapshot), {} new assets imported.",
+        path,
+        registered_count,
+        reused_entry_indices.size(),
+        imported_count
+    );
 
-    struct GLTFCallbacks {
-        AssetManager *asset_man = nullptr;
-        Model *model = nullptr;
+    self.registry_snapshot_root = path;
+    self.registry_snapshot = std::move(snapshot);
+    self.save_registry_snapshot();
+}
 
-        std::vector<glm::vec3> vertex_positions = {};
-        std::vector<glm::vec3> vertex_normals = {};
-        std::vector<glm::vec2> vertex_texcoords = {};
-        std::vector<Model::Index> indices = {};
-    };
-    auto on_new_primitive =
-        [](void *user_data, u32 mesh_index, u32 material_index, u32 vertex_offset, u32 vertex_count, u32 index_offset, u32 index_count) {
-            auto *info = static_cast<GLTFCallbacks *>(user_data);
-            if (info->model->meshes.size() <= mesh_index) {
-                info->model->meshes.resize(mesh_index + 1);
-            }
-
-            auto &mesh = info->model->meshes[mesh_index];
-            auto primitive_index = info->model->primitives.size();
-            auto &primitive = info->model->primitives.emplace_back();
-            auto *material_asset = info->asset_man->get_asset(info->model->materials[material_index]);
-
-            info->model->gpu_meshes.emplace_back();
-            info->model->gpu_mesh_buffers.emplace_back();
-
-            info->vertex_positions.resize(info->vertex_positions.size() + vertex_count);
-            info->vertex_normals.resize(info->vertex_normals.size() + vertex_count);
-            info->vertex_texcoords.resize(info->vertex_texcoords.size() + vertex_count);
-            info->indices.resize(info->indices.size() + index_count);
-
-            mesh.primitive_indices.push_back(primitive_index);
-            primitive.material_id = material_asset->material_id;
-            primitive.vertex_offset = vertex_offset;
-            primitive.vertex_count = vertex_count;
-            primitive.index_offset = index_offset;
-            primitive.index_count = index_count;
-        };
-    auto on_access_index = [](void *user_data, u32, u64 offset, u32 index) {
-        auto *info = static_cast<GLTFCallbacks *>(user_data);
-        info->indices[offset] = index;
-    };
-    auto on_access_position = [](void *user_data, u32, u64 offset, glm::vec3 position) {
-        auto *info = static_cast<GLTFCallbacks *>(user_data);
-        info->vertex_positions[offset] = position;
-    };
-    auto on_access_normal = [](void *user_data, u32, u64 offset, glm::vec3 normal) {
-        auto *info = static_cast<GLTFCallbacks *>(user_data);
-        info->vertex_normals[offset] = normal;
-    };
-    auto on_access_texcoord = [](void *user_data, u32, u64 offset, glm::vec2 texcoord) {
-        auto *info = static_cast<GLTFCallbacks *>(user_data);
-        info->vertex_texcoords[offset] = texcoord;
-    };
+auto AssetManager::save_registry_snapshot(this AssetManager &self) -> bool {
+    ZoneScoped;
 
-    GLTFCallbacks gltf_callbacks = { .asset_man = &self, .model = model };
-    auto gltf_model = GLTFModelInfo::parse(
-        asset_path,
-        { .user_data = &gltf_callbacks,
-          .on_new_primitive = on_new_primitive,
-          .on_access_index = on_access_index,
-          .on_access_position = on_access_position,
-          .on_access_normal = on_access_normal,
-          .on_access_texcoord = on_access_texcoord }
-    );
-    if (!gltf_model.has_value()) {
-        LOG_ERROR("Failed to parse Model '{}'!", asset_path);
+    if (self.registry_snapshot_root.empty()) {
         return false;
     }
 
-    auto &device = App::mod<Device>();
-    auto &transfer_man = device.transfer_man();
-
-    //  ── SCENE HIERARCHY ─────────────────────────────────────────────────
-    for (const auto &node : gltf_model->nodes) {
-        model->nodes.push_back(
-            { .name = node.name,
-              .child_indices = node.children,
-              .mesh_index = node.mesh_index,
-              .translation = node.translation,
-              .rotation = node.rotation,
-              .scale = node.scale }
-        );
+    // Sources hashed since last save
+    for (auto &entry : self.registry_snapshot.entries) {
+        auto source_path = self.registry_snapshot_root / fs::path(entry.meta_path);
+        source_path.replace_extension("");
+        if (auto source_hash = self.derived_data_cache.get_source_hash(source_path); source_hash.has_value()) {
+            entry.source_hash = source_hash.value();
+        }
     }
 
-    model->default_scene_index = gltf_model->defualt_scene_index.value_or(0_sz);
+    auto snapshot_dir = self.registry_snapshot_root / ".cache";
+    auto ec = std::error_code{};
+    fs::create_directories(snapshot_dir, ec);
+
+    return self.registry_snapshot.write(snapshot_dir / RegistrySnapshot::FILE_NAME);
+}
+
+auto AssetManager::open_project_cache(this AssetManager &self, const fs::path &path) -> bool {
+    ZoneScoped;
+
+    return self.derived_data_cache.init(path / ".cache");
+}
+
+struct AssetMetaFile {
+    simdjson::padded_string contents;
+    simdjson::ondemand::parser parser;
+    simdjson::simdjson_result<simdjson::ondemand::document> doc;
+};
+
+auto parse_meta_file(simdjson::padded_string contents) -> std::unique_ptr<AssetMetaFile> {
+    ZoneScoped;
+
+    auto result = std::make_unique<AssetMetaFile>();
+    result->contents = std::move(contents);
+    result->doc = result->parser.iterate(result->contents);
+    if (result->doc.error()) {
+        LOG_ERROR("Failed to parse asset meta file! {}", simdjson::error_message(result->doc.error()));
+        return nullptr;
+    }
+
+    return result;
+}
+
+auto read_meta_file(const fs::path &path) -> std::unique_ptr<AssetMetaFile> {
+    ZoneScoped;
+
+    if (!path.has_extension() || path.extension() != ".lrasset") {
+        LOG_ERROR("'{}' is not a valid asset file. It must end with .lrasset", path);
+        return nullptr;
+    }
+
+    File file(path, FileAccess::Read);
+    if (!file) {
+        LOG_ERROR("Failed to open file {}!", path);
+        return nullptr;
+    }
+
+    auto contents = simdjson::padded_string(file.size);
+    file.read(contents.data(), file.size);
+
+    return parse_meta_file(std::move(contents));
+}
+
+struct PackedAsset {
+    const AssetPack *pack = nullptr;
+    const AssetPackEntry *entry = nullptr;
+
+    auto read_meta(this const PackedAsset &self) -> std::unique_ptr<AssetMetaFile> {
+        auto meta_data = self.pack->read(self.entry->meta);
+        if (!meta_data.has_value()) {
+            return nullptr;
+        }
+
+        const auto *meta_str = reinterpret_cast<const c8 *>(meta_data->data.data());
+        return parse_meta_file(simdjson::padded_string(meta_str, meta_data->data.size()));
+    }
+
+    auto read_data(this const PackedAsset &self) -> ls::option<DerivedData> {
+        return self.pack->read(self.entry->data);
+    }
+};
+
+// Packed or loose is decided once by `mount_pack`.
+auto find_packed_asset(AssetManager &self, const UUID &uuid, const Asset &asset) -> ls::option<PackedAsset> {
+    ZoneScoped;
+
+    if (!asset.pack_index.has_value()) {
+        return ls::nullopt;
+    }
+
+    const auto &pack = self.packs[asset.pack_index.value()];
+    const auto *entry = pack.find(uuid);
+    if (!entry) {
+        return ls::nullopt;
+    }
+
+    return PackedAsset{ .pack = &pack, .entry = entry };
+}
+
+auto AssetManager::mount_pack(this AssetManager &self, const fs::path &project_path, const fs::path &pack_path) -> bool {
+    ZoneScoped;
+
+    auto pack = AssetPack::open(pack_path);
+    if (!pack.has_value()) {
+        return false;
+    }
+
+    auto pack_index = static_cast<u32>(self.packs.size());
+    const auto &mounted_pack = self.packs.emplace_back(std::move(pack.value()));
+
+    auto registered_count = 0_u32;
+    {
+        auto write_lock = std::unique_lock(self.registry_mutex);
+        self.registry.reserve(self.registry.size() + mounted_pack.entry_count);
+        for (const auto &entry : mounted_pack.slots) {
+            if (entry.type == AssetType::None) {
+                continue;
+            }
+
+            // Pack shadows loose files, an earlier pack wins over it.
+            auto uuid = mounted_pack.entry_uuid(entry);
+            auto [asset_it, inserted] = self.registry.try_emplace(uuid);
+            auto &asset = asset_it->second;
+            if (!inserted) {
+                if (!asset.pack_index.has_value()) {
+                    asset.pack_index = pack_index;
+                    registered_count++;
+                }
+
+                continue;
+            }
+
+            asset.uuid = uuid;
+            asset.path = project_path / fs::path(mounted_pack.entry_path(entry));
+            asset.type = entry.type;
+            asset.pack_index = pack_index;
+            self.asset_paths.emplace(ls::pair(asset.path, asset.type), uuid);
+            registered_count++;
+        }
+    }
+
+    LOG_INFO("Mounted asset pack '{}', {} of {} assets loaded from it.", pack_path, registered_count, mounted_pack.entry_count);
+
+    return true;
+}
+
+static auto cook_gltf_model(
+    const fs::path &path,
+    Model &model,
+    std::vector<CookedPrimitive> &cooked_primitives,
+    std::vector<std::vector<u8>> &cooked_payloads
+) -> bool;
+
+// Material of a model meta, texture infos follow the slot each texture is
+// bound to. `load_model` and `pack_project` both read them from here.
+static auto read_embedded_material(simdjson::simdjson_result<simdjson::ondemand::value> &material_json) -> MaterialInfo {
+    auto material_info = MaterialInfo{};
+    auto &material = material_info.material;
+    if (auto member_json = material_json["albedo_color"]; !member_json.error()) {
+        json_to_vec(member_json.value_unsafe(), material.albedo_color);
+    }
+    if (auto member_json = material_json["emissive_color"]; !member_json.error()) {
+        json_to_vec(member_json.value_unsafe(), material.emissive_color);
+    }
+    if (auto member_json = material_json["roughness_factor"]; !member_json.error()) {
+        material.roughness_factor = static_cast<f32>(member_json.get_double().value_unsafe());
+    }
+    if (auto member_json = material_json["metallic_factor"]; !member_json.error()) {
+        material.metallic_factor = static_cast<f32>(member_json.get_double().value_unsafe());
+    }
+    if (auto member_json = material_json["alpha_mode"]; !member_json.error()) {
+        material.alpha_mode = static_cast<AlphaMode>(member_json.get_uint64().value_unsafe());
+    }
+    if (auto member_json = material_json["alpha_cutoff"]; !member_json.error()) {
+        material.alpha_cutoff = static_cast<f32>(member_json.get_double().value_unsafe());
+    }
+    if (auto member_json = material_json["albedo_texture"]; !member_json.error()) {
+        material.albedo_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
+        material_info.albedo_texture_info.use_srgb = true;
+    }
+    if (auto member_json = material_json["normal_texture"]; !member_json.error()) {
+        material.normal_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
+        material_info.normal_texture_info.use_srgb = false;
+    }
+    if (auto member_json = material_json["emissive_texture"]; !member_json.error()) {
+        material.emissive_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
+        material_info.emissive_texture_info.use_srgb = true;
+    }
+    if (auto member_json = material_json["metallic_roughness_texture"]; !member_json.error()) {
+        material.metallic_roughness_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
+        material_info.metallic_roughness_texture_info.use_srgb = false;
+    }
+    if (auto member_json = material_json["occlusion_texture"]; !member_json.error()) {
+        material.occlusion_texture = UUID::from_string(member_json.get_string().value_unsafe()).value_or(UUID(nullptr));
+        material_info.occlusion_texture_info.use_srgb = false;
+    }
+
+    // Occlusion packed into metallic roughness texture needs all channels.
+    if (material.occlusion_texture == material.metallic_roughness_texture) {
+        material_info.occlusion_texture_info.kind = TextureKind::Color;
+    }
+
+    if (material.alpha_mode == AlphaMode::Mask) {
+        material_info.albedo_texture_info.alpha_cutoff = material.alpha_cutoff;
+    }
+
+    return material_info;
+}
+
+auto AssetManager::pack_project(this AssetManager &self, const fs::path &project_path, const fs::path &pack_path) -> bool {
+    ZoneScoped;
+
+    self.import_project(project_path);
+
+    struct PackedAssetInfo {
+        UUID uuid = {};
+        AssetType type = AssetType::None;
+        fs::path path = {};
+    };
+    auto asset_infos = std::vector<PackedAssetInfo>();
+    {
+        auto read_lock = std::shared_lock(self.registry_mutex);
+        for (const auto &[uuid, asset] : self.registry) {
+            if (asset.type != AssetType::Model && asset.type != AssetType::Texture && asset.type != AssetType::Scene) {
+                continue;
+            }
+
+            // Engine resources aren't part of the project.
+            auto relative_path = asset.path.lexically_relative(project_path);
+            if (relative_path.empty() || *relative_path.begin() == "..") {
+                continue;
+            }
+
+            asset_infos.push_back({ .uuid = uuid, .type = asset.type, .path = asset.path });
+        }
+    }
+
+    // Textures are cooked for the slots materials bind them to, models
+    // come first to find those out.
+    std::ranges::stable_partition(asset_infos, [](const PackedAssetInfo &v) { return v.type == AssetType::Model; });
+    struct TextureCookParams {
+        bool normal = false;
+        f32 alpha_cutoff = 0.0f;
+        // Bound with different parameters, packed as source and decoded
+        // for each on load.
+        bool ambiguous = false;
+    };
+    auto texture_cook_params = ankerl::unordered_dense::map<UUID, TextureCookParams>();
+    auto add_texture_use = [&](const UUID &texture_uuid, const TextureInfo &texture_info) {
+        if (!texture_uuid) {
+            return;
+        }
+
+        auto params = TextureCookParams{ .normal = texture_info.kind == TextureKind::Normal, .alpha_cutoff = texture_info.alpha_cutoff };
+        auto [params_it, inserted] = texture_cook_params.try_emplace(texture_uuid, params);
+        if (!inserted && (params_it->second.normal != params.normal || params_it->second.alpha_cutoff != params.alpha_cutoff)) {
+            params_it->second.ambiguous = true;
+        }
+    };
+
+    auto sources = std::vector<AssetPackSource>();
+    for (const auto &asset_info : asset_infos) {
+        auto source = AssetPackSource{
+            .uuid = asset_info.uuid,
+            .type = asset_info.type,
+            .data_type = AssetPackDataType::Source,
+            .path = asset_info.path.lexically_relative(project_path).generic_string(),
+            .meta = File::to_bytes(asset_info.path.string() + ".lrasset"),
+        };
+        if (source.meta.empty()) {
+            LOG_WARN("Asset '{}' has no meta file, skipping.", asset_info.path);
+            continue;
+        }
+
+        switch (asset_info.type) {
+            case AssetType::Model: {
+                // Same material list and settings `load_model` reads, they are part of the cache key.
+                const auto *meta_str = reinterpret_cast<const c8 *>(source.meta.data());
+                auto meta_json = parse_meta_file(simdjson::padded_string(meta_str, source.meta.size()));
+                if (!meta_json) {
+                    continue;
+                }
+
+                auto model = Model{};
+                if (auto member_json = meta_json->doc["full_precision_vertices"]; !member_json.error()) {
+                    model.full_precision_vertices = member_json.get_bool().value_unsafe();
+                }
+
+                for (auto embedded_material_json : meta_json->doc["embedded_materials"].get_array()) {
+                    auto material_uuid_json = embedded_material_json["uuid"].get_string();
+                    if (material_uuid_json.error()) {
+                        continue;
+                    }
+
+                    if (auto material_uuid = UUID::from_string(material_uuid_json.value_unsafe()); material_uuid.has_value()) {
+                        model.materials.push_back(material_uuid.value());
+                    }
+
+                    auto material_info = read_embedded_material(embedded_material_json);
+                    const auto &material = material_info.material;
+                    add_texture_use(material.albedo_texture, material_info.albedo_texture_info);
+                    add_texture_use(material.normal_texture, material_info.normal_texture_info);
+                    add_texture_use(material.emissive_texture, material_info.emissive_texture_info);
+                    add_texture_use(material.metallic_roughness_texture, material_info.metallic_roughness_texture_info);
+                    add_texture_use(material.occlusion_texture, material_info.occlusion_texture_info);
+                }
+
+                auto cache_key = ls::option<DerivedDataKey>();
+                if (auto source_hash = self.derived_data_cache.hash_file(asset_info.path); source_hash.has_value()) {
+                    cache_key = self.derived_data_cache.make_key(source_hash.value(), ModelFile::params_hash(model));
+                    if (auto derived_data = self.derived_data_cache.get(cache_key.value()); derived_data.has_value()) {
+                        source.data.assign(derived_data->data.begin(), derived_data->data.end());
+                    }
+                }
+
+                if (source.data.empty()) {
+                    auto cooked_primitives = std::vector<CookedPrimitive>();
+                    auto cooked_payloads = std::vector<std::vector<u8>>();
+                    if (!cook_gltf_model(asset_info.path, model, cooked_primitives, cooked_payloads)) {
+                        LOG_ERROR("Failed to cook model '{}', skipping.", asset_info.path);
+                        continue;
+                    }
+
+                    source.data = ModelFile::serialize(model, cooked_primitives);
+                    if (cache_key.has_value()) {
+                        self.derived_data_cache.put(cache_key.value(), source.data);
+                    }
+                }
+
+                source.data_type = AssetPackDataType::Cooked;
+            } break;
+            case AssetType::Texture: {
+                auto file_type = self.to_asset_file_type(asset_info.path);
+                // Embedded textures live in their models.
+                if (file_type != AssetFileType::PNG && file_type != AssetFileType::JPEG && file_type != AssetFileType::KTX2) {
+                    continue;
+                }
+
+                auto params_it = texture_cook_params.find(asset_info.uuid);
+                if (file_type != AssetFileType::KTX2 && params_it != texture_cook_params.end() && !params_it->second.ambiguous) {
+                    // Same parameters `load_texture` reads with
+                    const auto &params = params_it->second;
+                    auto params_hash = TextureFile::params_hash(params.normal, params.alpha_cutoff, self.texture_cook_format);
+                    auto cache_key = ls::option<DerivedDataKey>();
+                    if (auto source_hash = self.derived_data_cache.hash_file(asset_info.path); source_hash.has_value()) {
+                        cache_key = self.derived_data_cache.make_key(source_hash.value(), params_hash);
+                        if (auto derived_data = self.derived_data_cache.get(cache_key.value()); derived_data.has_value()) {
+                            source.data.assign(derived_data->data.begin(), derived_data->data.end());
+                        }
+                    }
+
+                    source.data_type = AssetPackDataType::Cooked;
+                    source.params_hash = params_hash;
+                    if (source.data.empty()) {
+                        auto image_bytes = File::to_bytes(asset_info.path);
+                        source.data = self.texture_cook_format == TextureCookFormat::BC7
+                            ? TextureFile::cook(image_bytes, params.normal, params.alpha_cutoff)
+                            : TextureFile::cook_ktx2(image_bytes, params.normal, params.alpha_cutoff, self.texture_cook_format);
+                        if (source.data.empty()) {
+                            // Decoded on load then
+                            source.data = std::move(image_bytes);
+                            source.data_type = AssetPackDataType::Source;
+                            source.params_hash = 0;
+                        } else if (cache_key.has_value()) {
+                            self.derived_data_cache.put(cache_key.value(), source.data);
+                        }
+                    }
+                } else {
+                    // KTX2 as is, unbound or ambiguous PNG/JPEG are decoded
+                    // on load for whatever they are loaded as.
+                    source.data = File::to_bytes(asset_info.path);
+                }
+            } break;
+            case AssetType::Scene: {
+                source.data = File::to_bytes(asset_info.path);
+            } break;
+            default:;
+        }
+
+        if (source.data.empty()) {
+            LOG_WARN("Asset '{}' is empty, skipping.", asset_info.path);
+            continue;
+        }
+
+        sources.push_back(std::move(source));
+    }
+
+    return AssetPack::write(pack_path, sources, self.texture_cook_format);
+}
+
+auto AssetManager::register_asset(this AssetManager &self, const fs::path &path) -> UUID {
+    ZoneScoped;
+    memory::ScopedStack stack;
+
+    auto meta_json = read_meta_file(path);
+    if (!meta_json) {
+        return UUID(nullptr);
+    }
+
+    auto uuid_json = meta_json->doc["uuid"].get_string();
+    if (uuid_json.error()) {
+        LOG_ERROR("Failed to read asset meta file. `uuid` is missing.");
+        return UUID(nullptr);
+    }
+
+    auto type_json = meta_json->doc["type"].get_number();
+    if (type_json.error()) {
+        LOG_ERROR("Failed to read asset meta file. `type` is missing.");
+        return UUID(nullptr);
+    }
+
+    auto asset_path = path;
+    asset_path.replace_extension("");
+    auto uuid = UUID::from_string(uuid_json.value_unsafe()).value();
+    auto type = static_cast<AssetType>(type_json.value_unsafe().get_uint64());
+
+    if (!self.register_asset(uuid, type, asset_path)) {
+        return UUID(nullptr);
+    }
+
+    return uuid;
+}
+
+auto AssetManager::register_asset(this AssetManager &self, const UUID &uuid, AssetType type, const fs::path &path) -> bool {
+    ZoneScoped;
+
+    auto write_lock = std::unique_lock(self.registry_mutex);
+    auto [asset_it, inserted] = self.registry.try_emplace(uuid);
+    if (!inserted) {
+        if (asset_it != self.registry.end()) {
+            // Tried a reinsert, asset already exists
+            return true;
+        }
+
+        return false;
+    }
+
+    auto &asset = asset_it->second;
+    asset.uuid = uuid;
+    asset.path = path;
+    asset.type = type;
+    self.asset_paths.emplace(ls::pair(asset.path, asset.type), uuid);
+
+    return true;
+}
+
+auto AssetManager::load_asset(this AssetManager &self, const UUID &uuid) -> bool {
+    ZoneScoped;
+
+    auto *asset = self.get_asset(uuid);
+    switch (asset->type) {
+        case AssetType::Model: {
+            return self.load_model(uuid);
+        }
+        case AssetType::Texture: {
+            return self.load_texture(uuid);
+        }
+        case AssetType::Scene: {
+            return self.load_scene(uuid);
+        }
+        default:;
+    }
+
+    return false;
+}
+
+auto AssetManager::unload_asset(this AssetManager &self, const UUID &uuid) -> bool {
+    ZoneScoped;
+
+    // Queued loads didn't take their reference yet, let them finish first.
+    auto load_request = AssetLoadHandle{};
+    {
+        auto lock = std::unique_lock(self.load_requests_mutex);
+        auto request_it = self.load_requests.find(uuid);
+        if (request_it != self.load_requests.end()) {
+            load_request = request_it->second;
+        }
+    }
+
+    if (load_request) {
+        load_request->wait();
+    }
+
+    auto *asset = self.get_asset(uuid);
+    LS_EXPECT(asset);
+    switch (asset->type) {
+        case AssetType::Model: {
+            return self.unload_model(uuid);
+        } break;
+        case AssetType::Texture: {
+            return self.unload_texture(uuid);
+        } break;
+        case AssetType::Scene: {
+            return self.unload_scene(uuid);
+        } break;
+        default:;
+    }
+
+    return false;
+}
+
+auto AssetManager::evict_assets(this AssetManager &self, const std::vector<UUID> &uuids) -> void {
+    ZoneScoped;
+
+    for (const auto &uuid : uuids) {
+        auto *asset = self.get_asset(uuid);
+        if (!asset || !asset->is_loaded()) {
+            continue;
+        }
+
+        switch (asset->type) {
+            case AssetType::Model: {
+                self.free_model(uuid);
+            } break;
+            case AssetType::Texture: {
+                self.free_texture(uuid);
+            } break;
+            default:;
+        }
+    }
+}
+
+auto AssetManager::set_cache_budgets(this AssetManager &self, u64 cpu_budget, u64 gpu_budget) -> void {
+    ZoneScoped;
+
+    auto evicted_uuids = self.asset_cache.set_budgets(cpu_budget, gpu_budget);
+    self.evict_assets(evicted_uuids);
+}
+
+auto AssetLoadRequest::is_done(this AssetLoadRequest &self) -> bool {
+    auto state = self.state.load();
+    return state == AssetLoadState::Resident || state == AssetLoadState::Failed;
+}
+
+auto AssetLoadRequest::wait(this AssetLoadRequest &self) -> void {
+    ZoneScoped;
+
+    auto state = self.state.load();
+    while (state != AssetLoadState::Resident && state != AssetLoadState::Failed) {
+        self.state.wait(state);
+        state = self.state.load();
+    }
+}
+
+auto AssetLoadRequest::on_complete(this AssetLoadRequest &self, AssetLoadCallback callback) -> void {
+    {
+        auto lock = std::unique_lock(self.callbacks_mutex);
+        if (!self.callbacks_dispatched) {
+            self.callbacks.push_back(std::move(callback));
+            return;
+        }
+    }
+
+    callback(self.uuid, self.state.load());
+}
+
+auto AssetManager::load_asset_async(this AssetManager &self, const UUID &uuid, AssetLoadCallback callback) -> AssetLoadHandle {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.load_requests_mutex);
+    auto request_it = self.load_requests.find(uuid);
+    if (request_it != self.load_requests.end() && !request_it->second->is_done()) {
+        auto &request = request_it->second;
+        auto *asset = self.get_asset(uuid);
+        LS_EXPECT(asset);
+        // Loading job takes one reference, rest are taken here.
+        asset->acquire_ref();
+        if (callback) {
+            request->on_complete(std::move(callback));
+        }
+
+        return request;
+    }
+
+    // Finished ones might have failed, or the asset might be unloaded
+    // since. Load again, old request is still dispatched by `poll_loads`.
+    if (request_it != self.load_requests.end()) {
+        self.replaced_load_requests.push_back(std::move(request_it->second));
+        self.load_requests.erase(request_it);
+    }
+
+    auto request = AssetLoadHandle::create();
+    request->uuid = uuid;
+    if (callback) {
+        request->on_complete(std::move(callback));
+    }
+    self.load_requests.emplace(uuid, request);
+
+    auto job = Job::create([&self, request]() {
+        auto loaded = self.load_asset(request->uuid);
+        // Finished by `finish_upload` once its uploads complete.
+        if (loaded && self.get_load_state(request->uuid) == AssetLoadState::Uploading) {
+            return;
+        }
+
+        request->progress = 1.0f;
+        request->state = loaded ? AssetLoadState::Resident : AssetLoadState::Failed;
+        request->state.notify_all();
+    });
+    App::submit_job(std::move(job));
+
+    return request;
+}
+
+auto AssetManager::poll_loads(this AssetManager &self) -> void {
+    ZoneScoped;
+
+    auto done_requests = std::vector<AssetLoadHandle>();
+    {
+        auto lock = std::unique_lock(self.load_requests_mutex);
+        done_requests = std::move(self.replaced_load_requests);
+        self.replaced_load_requests.clear();
+        for (auto it = self.load_requests.begin(); it != self.load_requests.end();) {
+            if (it->second->is_done()) {
+                done_requests.push_back(std::move(it->second));
+                it = self.load_requests.erase(it);
+                continue;
+            }
+
+            ++it;
+        }
+    }
+
+    for (auto &request : done_requests) {
+        auto callbacks = std::vector<AssetLoadCallback>();
+        {
+            auto lock = std::unique_lock(request->callbacks_mutex);
+            request->callbacks_dispatched = true;
+            callbacks = std::move(request->callbacks);
+        }
+
+        auto state = request->state.load();
+        if (state == AssetLoadState::Failed) {
+            LOG_ERROR("Failed to load asset {}.", request->uuid.str());
+        }
+
+        for (auto &callback : callbacks) {
+            callback(request->uuid, state);
+        }
+    }
+}
+
+auto AssetManager::get_load_state(this AssetManager &self, const UUID &uuid) -> AssetLoadState {
+    auto read_lock = std::shared_lock(self.registry_mutex);
+    auto it = self.registry.find(uuid);
+    if (it == self.registry.end()) {
+        return AssetLoadState::None;
+    }
+
+    return it->second.get_load_state();
+}
+
+auto AssetManager::set_load_state(this AssetManager &self, const UUID &uuid, AssetLoadState state, f32 progress) -> void {
+    ZoneScoped;
+
+    {
+        auto read_lock = std::shared_lock(self.registry_mutex);
+        auto it = self.registry.find(uuid);
+        if (it == self.registry.end()) {
+            return;
+        }
+
+        std::atomic_ref(it->second.load_state).store(state);
+    }
+
+    if (state == AssetLoadState::Resident) {
+        ++self.resident_generation;
+    }
+
+    // Final state of requests is set by their job, once `load_asset` returns.
+    if (state == AssetLoadState::Resident || state == AssetLoadState::Failed) {
+        return;
+    }
+
+    auto lock = std::unique_lock(self.load_requests_mutex);
+    auto request_it = self.load_requests.find(uuid);
+    if (request_it != self.load_requests.end() && !request_it->second->is_done()) {
+        request_it->second->state = state;
+        request_it->second->progress = progress;
+    }
+}
+
+auto AssetManager::finish_upload(this AssetManager &self, const UUID &uuid, u64 upload_value) -> void {
+    ZoneScoped;
+
+    auto &transfer_man = App::mod<Device>().transfer_man();
+    transfer_man.on_upload_complete(upload_value, [&self, uuid]() {
+        self.set_load_state(uuid, AssetLoadState::Resident, 1.0f);
+
+        // Materials skip textures that aren't resident yet.
+        auto *asset = self.get_asset(uuid);
+        if (asset && asset->type == AssetType::Texture) {
+            self.set_texture_materials_dirty(uuid);
+        }
+
+        auto lock = std::unique_lock(self.load_requests_mutex);
+        auto request_it = self.load_requests.find(uuid);
+        if (request_it != self.load_requests.end() && !request_it->second->is_done()) {
+            auto &request = request_it->second;
+            request->progress = 1.0f;
+            request->state = AssetLoadState::Resident;
+            request->state.notify_all();
+        }
+    });
+    transfer_man.flush_uploads();
+}
+
+// Meshlets of one cluster DAG level, as they end up in payload.
+struct MeshletLevel {
+    // Triangles of every meshlet in meshlet order, mesh vertex indices.
+    std::vector<u32> indices = {};
+    std::vector<GPU::Meshlet> meshlets = {};
+    std::vector<GPU::Bounds> meshlet_bounds = {};
+    std::vector<GPU::MeshletError> meshlet_errors = {};
+    std::vector<u32> indirect_vertex_indices = {};
+    std::vector<u8> local_triangle_indices = {};
+
+    auto clear(this MeshletLevel &self) -> void {
+        self.indices.clear();
+        self.meshlets.clear();
+        self.meshlet_bounds.clear();
+        self.meshlet_errors.clear();
+        self.indirect_vertex_indices.clear();
+        self.local_triangle_indices.clear();
+    }
+};
+
+// Reused between primitives cooked on the same thread, so large meshes
+// don't hit the allocator for every LOD.
+struct PrimitiveCookScratch {
+    std::vector<u32> remapped_vertices = {};
+    std::vector<glm::vec3> vertices = {};
+    std::vector<glm::vec3> normals = {};
+    std::vector<glm::vec2> texcoords = {};
+    std::vector<std::array<u16, 4>> quantized_positions = {};
+    std::vector<u32> quantized_normals = {};
+    std::vector<u32> quantized_texcoords = {};
+    std::vector<u32> indices = {};
+    std::array<MeshletLevel, GPU::Mesh::MAX_LODS> levels = {};
+
+    // Meshlets using each vertex, `vertex_meshlets[offsets[v]..offsets[v + 1]]`.
+    std::vector<u32> vertex_meshlet_offsets = {};
+    std::vector<u32> vertex_meshlets = {};
+    // Group of each meshlet, `~0` until grouped.
+    std::vector<u32> meshlet_groups = {};
+    // Meshlets of each group, `group_meshlets[offsets[g]..offsets[g + 1]]`.
+    std::vector<u32> group_meshlet_offsets = {};
+    std::vector<u32> group_meshlets = {};
+    // x = meshlet, y = vertices it shares with group.
+    std::vector<glm::uvec2> group_candidates = {};
+
+    // Group local copy of its vertices, simplifier and meshlet builder
+    // allocate per vertex they are given.
+    std::vector<u32> group_vertex_remap = {};
+    std::vector<u32> group_vertices = {};
+    std::vector<glm::vec3> group_positions = {};
+    std::vector<glm::vec3> group_normals = {};
+    std::vector<u32> group_indices = {};
+    std::vector<u32> simplified_indices = {};
+
+    std::vector<meshopt_Meshlet> raw_meshlets = {};
+    std::vector<u32> raw_meshlet_vertices = {};
+    std::vector<u8> raw_meshlet_triangles = {};
+};
+
+// Splits `indices` into meshlets appended to `level`. Indices point into
+// `positions`, `vertex_ids` maps them back to mesh vertices. Every meshlet
+// gets `error`.
+static auto append_meshlets(
+    ls::span<u32> indices,
+    ls::span<glm::vec3> positions,
+    ls::span<u32> vertex_ids,
+    const GPU::MeshletError &error,
+    PrimitiveCookScratch &scratch,
+    MeshletLevel &level
+) -> void {
+    ZoneScoped;
+
+    meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), positions.size());
+
+    // Worst case count
+    auto max_meshlet_count = meshopt_buildMeshletsBound(indices.size(), Model::MAX_MESHLET_INDICES, Model::MAX_MESHLET_PRIMITIVES);
+    auto &raw_meshlets = scratch.raw_meshlets;
+    auto &raw_meshlet_vertices = scratch.raw_meshlet_vertices;
+    auto &raw_meshlet_triangles = scratch.raw_meshlet_triangles;
+    raw_meshlets.resize(max_meshlet_count);
+    raw_meshlet_vertices.resize(max_meshlet_count * Model::MAX_MESHLET_INDICES);
+    raw_meshlet_triangles.resize(max_meshlet_count * Model::MAX_MESHLET_PRIMITIVES * 3);
+
+    auto meshlet_count = meshopt_buildMeshlets(
+        raw_meshlets.data(),
+        raw_meshlet_vertices.data(),
+        raw_meshlet_triangles.data(),
+        indices.data(),
+        indices.size(),
+        reinterpret_cast<const f32 *>(positions.data()),
+        positions.size(),
+        sizeof(glm::vec3),
+        Model::MAX_MESHLET_INDICES,
+        Model::MAX_MESHLET_PRIMITIVES,
+        0.0
+    );
+
+    for (const auto &raw_meshlet : ls::span(raw_meshlets.data(), meshlet_count)) {
+        const auto *meshlet_vertices = &raw_meshlet_vertices[raw_meshlet.vertex_offset];
+        const auto *meshlet_triangles = &raw_meshlet_triangles[raw_meshlet.triangle_offset];
+
+        auto &meshlet = level.meshlets.emplace_back();
+        meshlet.indirect_vertex_index_offset = level.indirect_vertex_indices.size();
+        meshlet.local_triangle_index_offset = level.local_triangle_indices.size();
+        meshlet.vertex_count = raw_meshlet.vertex_count;
+        meshlet.triangle_count = raw_meshlet.triangle_count;
+
+        for (u32 i = 0; i < raw_meshlet.vertex_count; i++) {
+            level.indirect_vertex_indices.push_back(vertex_ids[meshlet_vertices[i]]);
+        }
+
+        // AABB computation
+        auto meshlet_bb_min = glm::vec3(std::numeric_limits<f32>::max());
+        auto meshlet_bb_max = glm::vec3(std::numeric_limits<f32>::lowest());
+        for (u32 i = 0; i < raw_meshlet.triangle_count * 3; i++) {
+            auto local_triangle_index = meshlet_triangles[i];
+            LS_EXPECT(local_triangle_index < raw_meshlet.vertex_count);
+            auto vertex_index = meshlet_vertices[local_triangle_index];
+            LS_EXPECT(vertex_index < positions.size());
+
+            level.local_triangle_indices.push_back(local_triangle_index);
+            level.indices.push_back(vertex_ids[vertex_index]);
+            meshlet_bb_min = glm::min(meshlet_bb_min, positions[vertex_index]);
+            meshlet_bb_max = glm::max(meshlet_bb_max, positions[vertex_index]);
+        }
+
+        // Triangles of every meshlet start 4 byte aligned, padding stays zeroed.
+        level.local_triangle_indices.resize((level.local_triangle_indices.size() + 3_sz) & ~3_sz, 0_u8);
+
+        // Sphere and Cone computation
+        auto sphere_bounds = meshopt_computeMeshletBounds(
+            meshlet_vertices,
+            meshlet_triangles,
+            raw_meshlet.triangle_count,
+            reinterpret_cast<const f32 *>(positions.data()),
+            positions.size(),
+            sizeof(glm::vec3)
+        );
+
+        auto &bounds = level.meshlet_bounds.emplace_back();
+        bounds.aabb_center = (meshlet_bb_max + meshlet_bb_min) * 0.5f;
+        bounds.aabb_extent = meshlet_bb_max - meshlet_bb_min;
+        bounds.sphere_center = glm::make_vec3(sphere_bounds.center);
+        bounds.sphere_radius = sphere_bounds.radius;
+
+        level.meshlet_errors.push_back(error);
+    }
+}
+
+// Greedily groups meshlets of `level` with neighbours they share most
+// vertices with, so group borders and locked edges stay short.
+static auto build_meshlet_groups(const MeshletLevel &level, usize vertex_count, PrimitiveCookScratch &scratch) -> void {
+    ZoneScoped;
+
+    constexpr static auto MESHLET_GROUP_SIZE = 4_sz;
+
+    auto &vertex_meshlet_offsets = scratch.vertex_meshlet_offsets;
+    auto &vertex_meshlets = scratch.vertex_meshlets;
+    vertex_meshlet_offsets.assign(vertex_count + 1, 0_u32);
+    for (const auto &meshlet : level.meshlets) {
+        for (u32 i = 0; i < meshlet.vertex_count; i++) {
+            vertex_meshlet_offsets[level.indirect_vertex_indices[meshlet.indirect_vertex_index_offset + i]] += 1;
+        }
+    }
+
+    // Offsets are end of each range first, filling walks them back to start.
+    for (usize i = 1; i <= vertex_count; i++) {
+        vertex_meshlet_offsets[i] += vertex_meshlet_offsets[i - 1];
+    }
+
+    vertex_meshlets.resize(vertex_meshlet_offsets[vertex_count]);
+    for (u32 meshlet_index = 0; meshlet_index < level.meshlets.size(); meshlet_index++) {
+        const auto &meshlet = level.meshlets[meshlet_index];
+        for (u32 i = 0; i < meshlet.vertex_count; i++) {
+            auto vertex_index = level.indirect_vertex_indices[meshlet.indirect_vertex_index_offset + i];
+            vertex_meshlets[--vertex_meshlet_offsets[vertex_index]] = meshlet_index;
+        }
+    }
+
+    auto &meshlet_groups = scratch.meshlet_groups;
+    auto &group_meshlet_offsets = scratch.group_meshlet_offsets;
+    auto &group_meshlets = scratch.group_meshlets;
+    auto &candidates = scratch.group_candidates;
+    meshlet_groups.assign(level.meshlets.size(), ~0_u32);
+    group_meshlet_offsets.assign(1, 0_u32);
+    group_meshlets.clear();
+    for (u32 seed_index = 0; seed_index < level.meshlets.size(); seed_index++) {
+        if (meshlet_groups[seed_index] != ~0_u32) {
+            continue;
+        }
+
+        auto group_index = static_cast<u32>(group_meshlet_offsets.size() - 1);
+        auto group_offset = group_meshlets.size();
+        meshlet_groups[seed_index] = group_index;
+        group_meshlets.push_back(seed_index);
+        while (group_meshlets.size() - group_offset < MESHLET_GROUP_SIZE) {
+            candidates.clear();
+            for (auto member_offset = group_offset; member_offset < group_meshlets.size(); member_offset++) {
+                const auto &meshlet = level.meshlets[group_meshlets[member_offset]];
+                for (u32 i = 0; i < meshlet.vertex_count; i++) {
+                    auto vertex_index = level.indirect_vertex_indices[meshlet.indirect_vertex_index_offset + i];
+                    for (auto j = vertex_meshlet_offsets[vertex_index]; j < vertex_meshlet_offsets[vertex_index + 1]; j++) {
+                        auto neighbour_index = vertex_meshlets[j];
+                        if (meshlet_groups[neighbour_index] != ~0_u32) {
+                            continue;
+                        }
+
+                        auto it = std::ranges::find_if(candidates, [&](const glm::uvec2 &v) { return v.x == neighbour_index; });
+                        if (it != candidates.end()) {
+                            it->y += 1;
+                        } else {
+                            candidates.emplace_back(neighbour_index, 1_u32);
+                        }
+                    }
+                }
+            }
+
+            if (candidates.empty()) {
+                break;
+            }
+
+            auto best = std::ranges::max_element(candidates, [](const glm::uvec2 &lhs, const glm::uvec2 &rhs) {
+                return lhs.y < rhs.y || (lhs.y == rhs.y && lhs.x > rhs.x);
+            });
+            meshlet_groups[best->x] = group_index;
+            group_meshlets.push_back(best->x);
+        }
+
+        group_meshlet_offsets.push_back(static_cast<u32>(group_meshlets.size()));
+    }
+}
+
+// Grows sphere `center, radius` to contain the other one.
+static auto merge_spheres(glm::vec3 &center, f32 &radius, const glm::vec3 &other_center, f32 other_radius) -> void {
+    auto direction = other_center - center;
+    auto distance = glm::length(direction);
+    if (distance + other_radius <= radius) {
+        return;
+    }
+
+    if (distance + radius <= other_radius) {
+        center = other_center;
+        radius = other_radius;
+        return;
+    }
+
+    auto merged_radius = (radius + distance + other_radius) * 0.5f;
+    center += direction * ((merged_radius - radius) / distance);
+    radius = merged_radius;
+}
+
+// Remaps primitive and builds its cluster DAG. Payload layout is
+// `positions | normals | texcoords | lod0 | lod1 ...` where each lod is a DAG level,
+// `indices | meshlets | meshlet_bounds | meshlet_errors | local_triangle_indices | indirect_vertex_indices`.
+// Vertex streams are quantized unless `full_precision_vertices`, see `GPU::MeshFlag`.
+static auto cook_primitive(
+    ls::span<glm::vec3> primitive_vertices,
+    ls::span<glm::vec3> primitive_normals,
+    ls::span<glm::vec2> primitive_texcoords,
+    ls::span<u32> primitive_indices,
+    bool full_precision_vertices,
+    PrimitiveCookScratch &scratch,
+    GPU::Mesh &gpu_mesh,
+    std::vector<u8> &payload
+) -> void {
+    ZoneScoped;
+
+    auto push_payload = [&payload](const auto &data) -> u64 {
+        auto offset = payload.size();
+        const auto *first = reinterpret_cast<const u8 *>(data.data());
+        payload.insert(payload.end(), first, first + ls::size_bytes(data));
+        return offset;
+    };
+
+    //  ── Geometry remapping ──────────────────────────────────────────────
+    auto &remapped_vertices = scratch.remapped_vertices;
+    remapped_vertices.resize(primitive_vertices.size());
+    auto vertex_count = meshopt_optimizeVertexFetchRemap(
+        remapped_vertices.data(),
+        primitive_indices.data(),
+        primitive_indices.size(),
+        primitive_vertices.size()
+    );
+
+    auto &mesh_vertices = scratch.vertices;
+    mesh_vertices.resize(vertex_count);
+    meshopt_remapVertexBuffer(
+        mesh_vertices.data(),
+        primitive_vertices.data(),
+        primitive_vertices.size(),
+        sizeof(glm::vec3),
+        remapped_vertices.data()
+    );
+
+    auto &mesh_normals = scratch.normals;
+    mesh_normals.resize(vertex_count);
+    meshopt_remapVertexBuffer(
+        mesh_normals.data(),
+        primitive_normals.data(),
+        primitive_normals.size(),
+        sizeof(glm::vec3),
+        remapped_vertices.data()
+    );
+
+    auto &mesh_texcoords = scratch.texcoords;
+    mesh_texcoords.clear();
+    if (!primitive_texcoords.empty()) {
+        mesh_texcoords.resize(vertex_count);
+        meshopt_remapVertexBuffer(
+            mesh_texcoords.data(),
+            primitive_texcoords.data(),
+            primitive_texcoords.size(),
+            sizeof(glm::vec2),
+            remapped_vertices.data()
+        );
+    }
+
+    auto &mesh_indices = scratch.indices;
+    mesh_indices.resize(primitive_indices.size());
+    meshopt_remapIndexBuffer(mesh_indices.data(), primitive_indices.data(), primitive_indices.size(), remapped_vertices.data());
+
+    //  ── Vertex quantization ─────────────────────────────────────────────
+    // 16 bytes a vertex instead of 32. Positions are written back as GPU
+    // decodes them, so simplification and bounds match what gets drawn.
+    gpu_mesh.flags = GPU::MeshFlag::None;
+    if (full_precision_vertices) {
+        gpu_mesh.vertex_positions = push_payload(mesh_vertices);
+        gpu_mesh.vertex_normals = push_payload(mesh_normals);
+    } else {
+        auto position_min = glm::vec3(std::numeric_limits<f32>::max());
+        auto position_max = glm::vec3(std::numeric_limits<f32>::lowest());
+        for (const auto &position : mesh_vertices) {
+            position_min = glm::min(position_min, position);
+            position_max = glm::max(position_max, position);
+        }
+
+        auto position_extent = position_max - position_min;
+        gpu_mesh.vertex_position_offset = position_min;
+        gpu_mesh.vertex_position_scale = position_extent / 65535.0f;
+
+        auto &quantized_positions = scratch.quantized_positions;
+        quantized_positions.resize(vertex_count);
+        for (const auto &[position, quantized_position] : std::views::zip(mesh_vertices, quantized_positions)) {
+            quantized_position = quantize_position(position, position_min, position_extent);
+            position = dequantize_position(quantized_position, gpu_mesh.vertex_position_offset, gpu_mesh.vertex_position_scale);
+        }
+
+        auto &quantized_normals = scratch.quantized_normals;
+        quantized_normals.resize(vertex_count);
+        for (const auto &[normal, quantized_normal] : std::views::zip(mesh_normals, quantized_normals)) {
+            quantized_normal = encode_octahedral_unorm16(normal);
+        }
+
+        gpu_mesh.vertex_positions = push_payload(quantized_positions);
+        gpu_mesh.vertex_normals = push_payload(quantized_normals);
+        gpu_mesh.flags |= GPU::MeshFlag::QuantizedPositions | GPU::MeshFlag::QuantizedNormals;
+    }
+
+    if (!mesh_texcoords.empty()) {
+        // Half floats step by 1/1024 at most below 2, tiling texcoords
+        // beyond that keep full precision.
+        constexpr static auto MAX_HALF_TEXCOORD = 2.0f;
+        auto half_texcoords = !full_precision_vertices && std::ranges::all_of(mesh_texcoords, [](const glm::vec2 &texcoord) {
+            return glm::abs(texcoord.x) < MAX_HALF_TEXCOORD && glm::abs(texcoord.y) < MAX_HALF_TEXCOORD;
+        });
+        if (half_texcoords) {
+            auto &quantized_texcoords = scratch.quantized_texcoords;
+            quantized_texcoords.resize(vertex_count);
+            for (const auto &[texcoord, quantized_texcoord] : std::views::zip(mesh_texcoords, quantized_texcoords)) {
+                quantized_texcoord = quantize_texcoord(texcoord);
+            }
+
+            gpu_mesh.texture_coords = push_payload(quantized_texcoords);
+            gpu_mesh.flags |= GPU::MeshFlag::QuantizedTexCoords;
+        } else {
+            gpu_mesh.texture_coords = push_payload(mesh_texcoords);
+        }
+    }
+
+    //  ── Cluster DAG ─────────────────────────────────────────────────────
+    // Level 0 is the mesh split into meshlets. Each next level groups
+    // meshlets of previous one, simplifies every group to half with its
+    // border locked and splits it into meshlets again. Borders of a group
+    // don't move until next level groups it with others, so any cut through
+    // the DAG is watertight.
+    auto mesh_scale = meshopt_simplifyScale(reinterpret_cast<const f32 *>(mesh_vertices.data()), vertex_count, sizeof(glm::vec3));
+    auto &levels = scratch.levels;
+    for (auto &level : levels) {
+        level.clear();
+    }
+
+    auto &group_vertices = scratch.group_vertices;
+    group_vertices.resize(vertex_count);
+    for (u32 i = 0; i < vertex_count; i++) {
+        group_vertices[i] = i;
+    }
+
+    append_meshlets(mesh_indices, mesh_vertices, group_vertices, {}, scratch, levels[0]);
+    for (const auto &[bounds, error] : std::views::zip(levels[0].meshlet_bounds, levels[0].meshlet_errors)) {
+        error.center = bounds.sphere_center;
+        error.radius = bounds.sphere_radius;
+    }
+
+    auto &group_vertex_remap = scratch.group_vertex_remap;
+    group_vertex_remap.assign(vertex_count, ~0_u32);
+    auto level_count = 1_sz;
+    for (; level_count < GPU::Mesh::MAX_LODS; level_count++) {
+        ZoneNamedN(z, "GPU Meshlet DAG Level", true);
+
+        auto &child_level = levels[level_count - 1];
+        auto &level = levels[level_count];
+        if (child_level.meshlets.size() <= 1) {
+            break;
+        }
+
+        build_meshlet_groups(child_level, vertex_count, scratch);
+        const auto &group_meshlet_offsets = scratch.group_meshlet_offsets;
+        for (usize group_index = 0; group_index + 1 < group_meshlet_offsets.size(); group_index++) {
+            auto members = ls::span(
+                scratch.group_meshlets.data() + group_meshlet_offsets[group_index],
+                group_meshlet_offsets[group_index + 1] - group_meshlet_offsets[group_index]
+            );
+
+            auto &group_positions = scratch.group_positions;
+            auto &group_normals = scratch.group_normals;
+            auto &group_indices = scratch.group_indices;
+            group_vertices.clear();
+            group_positions.clear();
+            group_normals.clear();
+            group_indices.clear();
+
+            // Group error covers every member, so parents never project
+            // smaller than their children.
+            auto group_error = child_level.meshlet_errors[members[0]];
+            for (auto meshlet_index : members) {
+                const auto &meshlet = child_level.meshlets[meshlet_index];
+                const auto &meshlet_error = child_level.meshlet_errors[meshlet_index];
+                merge_spheres(group_error.center, group_error.radius, meshlet_error.center, meshlet_error.radius);
+                group_error.error = ls::max(group_error.error, meshlet_error.error);
+
+                for (u32 i = 0; i < meshlet.triangle_count * 3; i++) {
+                    auto local_triangle_index = child_level.local_triangle_indices[meshlet.local_triangle_index_offset + i];
+                    auto vertex_index = child_level.indirect_vertex_indices[meshlet.indirect_vertex_index_offset + local_triangle_index];
+                    auto &group_vertex_index = group_vertex_remap[vertex_index];
+                    if (group_vertex_index == ~0_u32) {
+                        group_vertex_index = static_cast<u32>(group_vertices.size());
+                        group_vertices.push_back(vertex_index);
+                        group_positions.push_back(mesh_vertices[vertex_index]);
+                        group_normals.push_back(mesh_normals[vertex_index]);
+                    }
+
+                    group_indices.push_back(group_vertex_index);
+                }
+            }
+
+            auto &simplified_indices = scratch.simplified_indices;
+            auto target_index_count = ((group_indices.size() + 5_sz) / 6_sz) * 3_sz;
+            simplified_indices.resize(group_indices.size());
+            constexpr auto TARGET_ERROR = std::numeric_limits<f32>::max();
+            constexpr f32 NORMAL_WEIGHTS[] = { 1.0f, 1.0f, 1.0f };
+
+            auto result_error = 0.0f;
+            auto result_index_count = meshopt_simplifyWithAttributes(
+                simplified_indices.data(),
+                group_indices.data(),
+                group_indices.size(),
+                reinterpret_cast<const f32 *>(group_positions.data()),
+                group_positions.size(),
+                sizeof(glm::vec3),
+                reinterpret_cast<const f32 *>(group_normals.data()),
+                sizeof(glm::vec3),
+                NORMAL_WEIGHTS,
+                ls::count_of(NORMAL_WEIGHTS),
+                nullptr,
+                target_index_count,
+                TARGET_ERROR,
+                meshopt_SimplifyLockBorder,
+                &result_error
+            );
+
+            if (result_index_count != 0 && result_index_count <= target_index_count + target_index_count / 2) {
+                // Error is relative to extent of what simplifier was given.
+                auto group_scale =
+                    meshopt_simplifyScale(reinterpret_cast<const f32 *>(group_positions.data()), group_positions.size(), sizeof(glm::vec3));
+                simplified_indices.resize(result_index_count);
+                group_error.error += result_error * group_scale;
+            } else {
+                // Mostly locked border, carried over as is with no new error.
+                simplified_indices.assign(group_indices.begin(), group_indices.end());
+            }
+
+            for (auto meshlet_index : members) {
+                auto &meshlet_error = child_level.meshlet_errors[meshlet_index];
+                meshlet_error.parent_center = group_error.center;
+                meshlet_error.parent_radius = group_error.radius;
+                meshlet_error.parent_error = group_error.error;
+            }
+
+            append_meshlets(simplified_indices, group_positions, group_vertices, group_error, scratch, level);
+            for (auto vertex_index : group_vertices) {
+                group_vertex_remap[vertex_index] = ~0_u32;
+            }
+        }
+
+        auto level_error = 0.0f;
+        for (const auto &meshlet_error : level.meshlet_errors) {
+            level_error = ls::max(level_error, meshlet_error.error);
+        }
+
+        gpu_mesh.lods[level_count].error = mesh_scale > 0.0f ? level_error / mesh_scale : 0.0f;
+        if (level.indices.size() * 20 > child_level.indices.size() * 17 || gpu_mesh.lods[level_count].error > 0.5f) {
+            // Error bound, or most of the mesh is locked
+            level.clear();
+            gpu_mesh.lods[level_count].error = 0.0f;
+            break;
+        }
+    }
+
+    // Nothing coarser to switch to from top level.
+    for (auto &meshlet_error : levels[level_count - 1].meshlet_errors) {
+        meshlet_error.parent_center = meshlet_error.center;
+        meshlet_error.parent_radius = meshlet_error.radius;
+        meshlet_error.parent_error = std::numeric_limits<f32>::max();
+    }
+
+    auto mesh_bb_min = glm::vec3(std::numeric_limits<f32>::max());
+    auto mesh_bb_max = glm::vec3(std::numeric_limits<f32>::lowest());
+    auto mesh_sphere_center = glm::vec3(0.0f);
+    auto mesh_sphere_radius = -1.0f;
+    for (const auto &bounds : levels[0].meshlet_bounds) {
+        mesh_bb_min = glm::min(mesh_bb_min, bounds.aabb_center - bounds.aabb_extent * 0.5f);
+        mesh_bb_max = glm::max(mesh_bb_max, bounds.aabb_center + bounds.aabb_extent * 0.5f);
+        if (mesh_sphere_radius < 0.0f) {
+            mesh_sphere_center = bounds.sphere_center;
+            mesh_sphere_radius = bounds.sphere_radius;
+        } else {
+            merge_spheres(mesh_sphere_center, mesh_sphere_radius, bounds.sphere_center, bounds.sphere_radius);
+        }
+    }
+
+    gpu_mesh.bounds.aabb_center = (mesh_bb_max + mesh_bb_min) * 0.5f;
+    gpu_mesh.bounds.aabb_extent = mesh_bb_max - mesh_bb_min;
+    gpu_mesh.bounds.sphere_center = mesh_sphere_center;
+    gpu_mesh.bounds.sphere_radius = ls::max(mesh_sphere_radius, 0.0f);
+    gpu_mesh.vertex_count = vertex_count;
+    gpu_mesh.lod_count = level_count;
+
+    for (auto lod_index = 0_sz; lod_index < level_count; lod_index++) {
+        const auto &level = levels[lod_index];
+        auto &cur_lod = gpu_mesh.lods[lod_index];
+        cur_lod.indices = push_payload(level.indices);
+        cur_lod.meshlets = push_payload(level.meshlets);
+        cur_lod.meshlet_bounds = push_payload(level.meshlet_bounds);
+        cur_lod.meshlet_errors = push_payload(level.meshlet_errors);
+        cur_lod.local_triangle_indices = push_payload(level.local_triangle_indices);
+        cur_lod.indirect_vertex_indices = push_payload(level.indirect_vertex_indices);
+
+        cur_lod.indices_count = level.indices.size();
+        cur_lod.meshlet_count = level.meshlets.size();
+        cur_lod.meshlet_bounds_count = level.meshlet_bounds.size();
+        cur_lod.local_triangle_indices_count = level.local_triangle_indices.size();
+        cur_lod.indirect_vertex_indices_count = level.indirect_vertex_indices.size();
+    }
+}
+
+// Parses glTF file and cooks every primitive of it, hierarchy goes into `model`.
+static auto cook_gltf_model(
+    const fs::path &path,
+    Model &model,
+    std::vector<CookedPrimitive> &cooked_primitives,
+    std::vector<std::vector<u8>> &cooked_payloads
+) -> bool {
+    ZoneScoped;
+
+    auto geometry = GLTFGeometry{};
+    auto gltf_model = GLTFModelInfo::parse(path, geometry);
+    if (!gltf_model.has_value()) {
+        return false;
+    }
+
+    for (auto primitive_index = 0_sz; primitive_index < geometry.primitives.size(); primitive_index++) {
+        auto mesh_index = geometry.primitives[primitive_index].mesh_index;
+        if (model.meshes.size() <= mesh_index) {
+            model.meshes.resize(mesh_index + 1);
+        }
+
+        model.meshes[mesh_index].primitive_indices.push_back(static_cast<u32>(primitive_index));
+    }
+
+    //  ── SCENE HIERARCHY ─────────────────────────────────────────────────
+    for (const auto &node : gltf_model->nodes) {
+        model.nodes.push_back(
+            { .name = node.name,
+              .child_indices = node.children,
+              .mesh_index = node.mesh_index,
+              .translation = node.translation,
+              .rotation = node.rotation,
+              .scale = node.scale }
+        );
+    }
+
+    model.default_scene_index = gltf_model->defualt_scene_index.value_or(0_sz);
     for (const auto &scene : gltf_model->scenes) {
-        model->scenes.push_back({ .name = scene.name, .node_indices = scene.node_indices });
+        model.scenes.push_back({ .name = scene.name, .node_indices = scene.node_indices });
     }
 
     //  ── MESH PROCESSING ─────────────────────────────────────────────────
-    auto model_indices = std::move(gltf_callbacks.indices);
-    auto model_vertices = std::move(gltf_callbacks.vertex_positions);
-    auto model_normals = std::move(gltf_callbacks.vertex_normals);
-    auto model_texcoords = std::move(gltf_callbacks.vertex_texcoords);
-
-    // for each model (aka gltf scene):
-    // - for each mesh:
-    // - - for each primitive:
-    // - - - for each lod:
-    // - - - - generate lods
-    // - - - - optimize and remap geometry
-    // - - - - calculate meshlets and bounds
+    // for each primitive:
+    // - for each lod:
+    // - - generate lods
+    // - - optimize and remap geometry
+    // - - calculate meshlets and bounds
     //
-    for (const auto &mesh : model->meshes) {
-        for (auto primitive_index : mesh.primitive_indices) {
-            auto &primitive = model->primitives[primitive_index];
-            auto &gpu_mesh = model->gpu_meshes[primitive_index];
-            auto &gpu_mesh_buffer = model->gpu_mesh_buffers[primitive_index];
-
-            //  ── Geometry remapping ──────────────────────────────────────────────
-            auto primitive_indices = ls::span(model_indices.data() + primitive.index_offset, primitive.index_count);
-            auto primitive_vertices = ls::span(model_vertices.data() + primitive.vertex_offset, primitive.vertex_count);
-            auto primitive_normals = ls::span(model_normals.data() + primitive.vertex_offset, primitive.vertex_count);
-            auto primitive_texcoords = ls::span(model_texcoords.data() + primitive.vertex_offset, primitive.vertex_count);
-
-            auto remapped_vertices = std::vector<u32>(primitive_vertices.size());
-            auto vertex_count = meshopt_optimizeVertexFetchRemap(
-                remapped_vertices.data(),
-                primitive_indices.data(),
-                primitive_indices.size(),
-                primitive.vertex_count
+    // Primitives are independent until upload, each one is a chunk of
+    // `parallel_for` with its own scratch.
+    auto primitive_count = geometry.primitives.size();
+    cooked_primitives.resize(primitive_count);
+    cooked_payloads.resize(primitive_count);
+
+    App::get().job_man.parallel_for(static_cast<u32>(primitive_count), 1, [&](u32 first_primitive, u32 last_primitive) {
+        auto scratch = PrimitiveCookScratch{};
+        for (auto i = first_primitive; i < last_primitive; i++) {
+            const auto &primitive = geometry.primitives[i];
+            auto &cooked_primitive = cooked_primitives[i];
+            auto &payload = cooked_payloads[i];
+            cooked_primitive.material_index = primitive.material_index;
+            cooked_primitive.index_count = primitive.index_count;
+
+            cook_primitive(
+                ls::span<glm::vec3>(geometry.vertex_positions.data() + primitive.vertex_offset, primitive.vertex_count),
+                ls::span<glm::vec3>(geometry.vertex_normals.data() + primitive.vertex_offset, primitive.vertex_count),
+                ls::span<glm::vec2>(geometry.vertex_texcoords.data() + primitive.vertex_offset, primitive.vertex_count),
+                ls::span<u32>(geometry.indices.data() + primitive.index_offset, primitive.index_count),
+                model.full_precision_vertices,
+                scratch,
+                cooked_primitive.gpu_mesh,
+                payload
             );
+            cooked_primitive.payload = ls::span<u8>(payload.data(), payload.size());
+            cooked_primitive.payload_size = payload.size();
+            cooked_primitive.payload_hash = XXH3_64bits(payload.data(), payload.size());
+        }
+    });
 
-            auto mesh_vertices = std::vector<glm::vec3>(vertex_count);
-            meshopt_remapVertexBuffer(
-                mesh_vertices.data(),
-                primitive_vertices.data(),
-                primitive_vertices.size(),
-                sizeof(glm::vec3),
-                remapped_vertices.data()
-            );
+    return true;
+}
 
-            auto mesh_normals = std::vector<glm::vec3>(vertex_count);
-            meshopt_remapVertexBuffer(
-                mesh_normals.data(),
-                primitive_normals.data(),
-                primitive_normals.size(),
-                sizeof(glm::vec3),
-                remapped_vertices.data()
-            );
+// Same payload and resident LODs, same mesh buffer contents. Hashes
+// decoded payload whether it was just cooked or read from cache, so
+// which model loads first doesn't matter. Never 0.
+static auto mesh_buffer_hash(const CookedPrimitive &cooked_primitive, u32 resident_lod_index) -> u64 {
+    auto params = std::array<u64, 3>{ cooked_primitive.payload_size, cooked_primitive.gpu_mesh.vertex_count, resident_lod_index };
+    auto hash = XXH3_64bits_withSeed(params.data(), params.size() * sizeof(u64), cooked_primitive.payload_hash);
 
-            auto mesh_texcoords = std::vector<glm::vec2>();
-            if (!primitive_texcoords.empty()) {
-                mesh_texcoords.resize(vertex_count);
-                meshopt_remapVertexBuffer(
-                    mesh_texcoords.data(),
-                    primitive_texcoords.data(),
-                    primitive_texcoords.size(),
-                    sizeof(glm::vec2),
-                    remapped_vertices.data()
-                );
-            }
+    return hash == 0 ? 1 : hash;
+}
 
-            auto mesh_indices = std::vector<u32>(primitive.index_count);
-            meshopt_remapIndexBuffer(mesh_indices.data(), primitive_indices.data(), primitive_indices.size(), remapped_vertices.data());
+auto AssetManager::load_model(this AssetManager &self, const UUID &uuid) -> bool {
+    ZoneScoped;
+    memory::ScopedStack stack;
 
-            //  ── LOD generation ──────────────────────────────────────────────────
+    auto *asset = self.get_asset(uuid);
+    {
+        auto read_lock = std::shared_lock(self.models_mutex);
+        if (asset->is_loaded()) {
+            // Model is collection of multiple assets and all child
+            // assets must be alive to safely process meshes.
+            // Don't acquire child refs.
+            asset->acquire_ref();
+            self.asset_cache.take(uuid);
 
-            const auto mesh_upload_size = 0 //
-                + ls::size_bytes(mesh_vertices) //
-                + ls::size_bytes(mesh_normals) //
-                + ls::size_bytes(mesh_texcoords);
-            auto upload_size = mesh_upload_size;
+            return true;
+        }
+    }
 
-            ls::pair<vuk::Value<vuk::Buffer>, u64> lod_cpu_buffers[GPU::Mesh::MAX_LODS] = {};
-            auto last_lod_indices = std::vector<u32>();
-            for (auto lod_index = 0_sz; lod_index < GPU::Mesh::MAX_LODS; lod_index++) {
-                ZoneNamedN(z, "GPU Meshlet Generation", true);
+    self.asset_cache.record_miss();
 
-                auto &cur_lod = gpu_mesh.lods[lod_index];
-                auto simplified_indices = std::vector<u32>();
-                if (lod_index == 0) {
-                    simplified_indices = std::vector<u32>(mesh_indices.begin(), mesh_indices.end());
-                } else {
-                    const auto &last_lod = gpu_mesh.lods[lod_index - 1];
-                    auto lod_index_count = ((last_lod_indices.size() + 5_sz) / 6_sz) * 3_sz;
-                    simplified_indices.resize(last_lod_indices.size(), 0_u32);
-                    constexpr auto TARGET_ERROR = std::numeric_limits<f32>::max();
-                    constexpr f32 NORMAL_WEIGHTS[] = { 1.0f, 1.0f, 1.0f };
-
-                    auto result_error = 0.0f;
-                    auto result_index_count = meshopt_simplifyWithAttributes(
-                        simplified_indices.data(),
-                        last_lod_indices.data(),
-                        last_lod_indices.size(),
-                        reinterpret_cast<const f32 *>(mesh_vertices.data()),
-                        mesh_vertices.size(),
-                        sizeof(glm::vec3),
-                        reinterpret_cast<const f32 *>(mesh_normals.data()),
-                        sizeof(glm::vec3),
-                        NORMAL_WEIGHTS,
-                        ls::count_of(NORMAL_WEIGHTS),
-                        nullptr,
-                        lod_index_count,
-                        TARGET_ERROR,
-                        meshopt_SimplifyLockBorder,
-                        &result_error
-                    );
-
-                    cur_lod.error = last_lod.error + result_error;
-                    if (result_index_count > (lod_index_count + lod_index_count / 2) || result_error > 0.5 || result_index_count < 6) {
-                        // Error bound
-                        break;
-                    }
+    auto stage_timer = StageTimer{};
+    auto model_id = self.models.create_slot();
+    asset->model_id = model_id;
+    // Built aside, slot pointers don't survive other loads growing `models`.
+    // Moved into its slot once resident.
+    auto model_storage = Model{};
+    auto *model = &model_storage;
 
-                    simplified_indices.resize(result_index_count);
-                }
+    auto loaded = false;
+    self.set_load_state(uuid, AssetLoadState::Loading, 0.0f);
+    LS_DEFER(&) {
+        if (!loaded) {
+            self.set_load_state(uuid, AssetLoadState::Failed, 0.0f);
+        }
+    };
 
-                gpu_mesh.vertex_count = mesh_vertices.size();
-                gpu_mesh.lod_count += 1;
-                last_lod_indices = simplified_indices;
-
-                meshopt_optimizeVertexCache(simplified_indices.data(), simplified_indices.data(), simplified_indices.size(), vertex_count);
-
-                // Worst case count
-                auto max_meshlet_count =
-                    meshopt_buildMeshletsBound(simplified_indices.size(), Model::MAX_MESHLET_INDICES, Model::MAX_MESHLET_PRIMITIVES);
-                auto raw_meshlets = std::vector<meshopt_Meshlet>(max_meshlet_count);
-                auto indirect_vertex_indices = std::vector<u32>(max_meshlet_count * Model::MAX_MESHLET_INDICES);
-                auto local_triangle_indices = std::vector<u8>(max_meshlet_count * Model::MAX_MESHLET_PRIMITIVES * 3);
-
-                auto meshlet_count = meshopt_buildMeshlets(
-                    raw_meshlets.data(),
-                    indirect_vertex_indices.data(),
-                    local_triangle_indices.data(),
-                    simplified_indices.data(),
-                    simplified_indices.size(),
-                    reinterpret_cast<const f32 *>(mesh_vertices.data()),
-                    mesh_vertices.size(),
-                    sizeof(glm::vec3),
-                    Model::MAX_MESHLET_INDICES,
-                    Model::MAX_MESHLET_PRIMITIVES,
-                    0.0
-                );
+    auto packed_asset = find_packed_asset(self, uuid, *asset);
+    auto meta_json = std::unique_ptr<AssetMetaFile>();
+    if (packed_asset.has_value()) {
+        meta_json = packed_asset->read_meta();
+    } else {
+        fs::path meta_path = asset->path.string() + ".lrasset";
+        meta_json = read_meta_file(meta_path);
+    }
 
-                // Trim meshlets from worst case to current case
-                raw_meshlets.resize(meshlet_count);
-                auto meshlets = std::vector<GPU::Meshlet>(meshlet_count);
-                const auto &last_meshlet = raw_meshlets[meshlet_count - 1];
-                indirect_vertex_indices.resize(last_meshlet.vertex_offset + last_meshlet.vertex_count);
-                local_triangle_indices.resize(last_meshlet.triangle_offset + ((last_meshlet.triangle_count * 3 + 3) & ~3_u32));
-
-                auto mesh_bb_min = glm::vec3(std::numeric_limits<f32>::max());
-                auto mesh_bb_max = glm::vec3(std::numeric_limits<f32>::lowest());
-                auto meshlet_bounds = std::vector<GPU::Bounds>(meshlet_count);
-                for (const auto &[raw_meshlet, meshlet, bounds] : std::views::zip(raw_meshlets, meshlets, meshlet_bounds)) {
-                    // AABB computation
-                    auto meshlet_bb_min = glm::vec3(std::numeric_limits<f32>::max());
-                    auto meshlet_bb_max = glm::vec3(std::numeric_limits<f32>::lowest());
-                    for (u32 i = 0; i < raw_meshlet.triangle_count * 3; i++) {
-                        auto local_triangle_index_offset = raw_meshlet.triangle_offset + i;
-                        LS_EXPECT(local_triangle_index_offset < local_triangle_indices.size());
-                        auto local_triangle_index = local_triangle_indices[local_triangle_index_offset];
-                        LS_EXPECT(local_triangle_index < raw_meshlet.vertex_count);
-                        auto indirect_vertex_index_offset = raw_meshlet.vertex_offset + local_triangle_index;
-                        LS_EXPECT(indirect_vertex_index_offset < indirect_vertex_indices.size());
-                        auto indirect_vertex_index = indirect_vertex_indices[indirect_vertex_index_offset];
-                        LS_EXPECT(indirect_vertex_index < vertex_count);
-
-                        const auto &tri_pos = mesh_vertices[indirect_vertex_index];
-                        meshlet_bb_min = glm::min(meshlet_bb_min, tri_pos);
-                        meshlet_bb_max = glm::max(meshlet_bb_max, tri_pos);
-                    }
+    if (!meta_json) {
+        LOG_ERROR("Model assets require proper meta file.");
+        return false;
+    }
 
-                    // Sphere and Cone computation
-                    auto sphere_bounds = meshopt_computeMeshletBounds(
-                        &indirect_vertex_indices[raw_meshlet.vertex_offset],
-                        &local_triangle_indices[raw_meshlet.triangle_offset],
-                        raw_meshlet.triangle_count,
-                        reinterpret_cast<f32 *>(mesh_vertices.data()),
-                        vertex_count,
-                        sizeof(glm::vec3)
-                    );
-
-                    meshlet.indirect_vertex_index_offset = raw_meshlet.vertex_offset;
-                    meshlet.local_triangle_index_offset = raw_meshlet.triangle_offset;
-                    meshlet.vertex_count = raw_meshlet.vertex_count;
-                    meshlet.triangle_count = raw_meshlet.triangle_count;
-
-                    bounds.aabb_center = (meshlet_bb_max + meshlet_bb_min) * 0.5f;
-                    bounds.aabb_extent = meshlet_bb_max - meshlet_bb_min;
-                    bounds.sphere_center = glm::make_vec3(sphere_bounds.center);
-                    bounds.sphere_radius = sphere_bounds.radius;
-
-                    mesh_bb_min = glm::min(mesh_bb_min, meshlet_bb_min);
-                    mesh_bb_max = glm::max(mesh_bb_max, meshlet_bb_max);
-                }
+    auto asset_path = asset->path;
+    asset->acquire_ref();
+
+    // Below we register new assets, which causes asset pointer to be invalidated.
+    // set this to nullptr so it's obvious when debugging.
+    asset = nullptr;
+
+    //  ── INITIAL PARSING ─────────────────────────────────────────────────
+    if (auto member_json = meta_json->doc["full_precision_vertices"]; !member_json.error()) {
+        model->full_precision_vertices = member_json.get_bool().value_unsafe();
+    }
+
+    auto embedded_textures = std::vector<UUID>();
+    auto embedded_texture_uuids_json = meta_json->doc["embedded_textures"].get_array();
+    for (auto embedded_texture_uuid_json : embedded_texture_uuids_json) {
+        auto embedded_texture_uuid_str = embedded_texture_uuid_json.get_string();
+        if (embedded_texture_uuid_str.error()) {
+            LOG_ERROR("Failed to import model {}! An embedded texture with corrupt UUID.", asset_path);
+            return false;
+        }
+
+        auto embedded_texture_uuid = UUID::from_string(embedded_texture_uuid_str.value_unsafe());
+        if (!embedded_texture_uuid.has_value()) {
+            LOG_ERROR("Failed to import model {}! An embedded texture with corrupt UUID.", asset_path);
+            return false;
+        }
+
+        embedded_textures.push_back(embedded_texture_uuid.value());
+        self.register_asset(embedded_texture_uuid.value(), AssetType::Texture, asset_path);
+    }
 
-                gpu_mesh.bounds.aabb_center = (mesh_bb_max + mesh_bb_min) * 0.5f;
-                gpu_mesh.bounds.aabb_extent = mesh_bb_max - mesh_bb_min;
+    // Load registered UUIDs.
+    auto embedded_materials_json = meta_json->doc["embedded_materials"].get_array();
+    if (embedded_materials_json.error()) {
+        LOG_ERROR("Failed to import model {}! Missing materials filed.", asset_path);
+        return false;
+    }
+
+    auto embedded_material_infos = std::vector<MaterialInfo>();
+    for (auto embedded_material_json : embedded_materials_json) {
+        if (embedded_material_json.error()) {
+            LOG_ERROR("Failed to import model {}! A material with error.", asset_path);
+            return false;
+        }
+
+        if (auto material_uuid_json = embedded_material_json["uuid"]; !material_uuid_json.error()) {
+            auto material_uuid = UUID::from_string(material_uuid_json.value_unsafe());
+            if (!material_uuid.has_value()) {
+                LOG_ERROR("Failed to import model {}! A material with corrupt UUID.", asset_path);
+                return false;
+            }
+
+            self.register_asset(material_uuid.value(), AssetType::Material, asset_path);
+            model->materials.emplace_back(material_uuid.value());
+        }
 
-                auto lod_upload_size = 0 //
-                    + ls::size_bytes(simplified_indices) //
-                    + ls::size_bytes(meshlets) //
-                    + ls::size_bytes(meshlet_bounds) //
-                    + ls::size_bytes(local_triangle_indices) //
-                    + ls::size_bytes(indirect_vertex_indices);
-                auto cpu_lod_buffer = transfer_man.alloc_transient_buffer(vuk::MemoryUsage::eCPUonly, lod_upload_size);
-                auto cpu_lod_ptr = reinterpret_cast<u8 *>(cpu_lod_buffer->mapped_ptr);
+        embedded_material_infos.push_back(read_embedded_material(embedded_material_json));
+    }
+
+    for (const auto &[material_uuid, material_info] : std::views::zip(model->materials, embedded_material_infos)) {
+        self.load_material(material_uuid, material_info);
+    }
 
-                auto upload_offset = 0_u64;
-                cur_lod.indices = upload_offset;
-                std::memcpy(cpu_lod_ptr + upload_offset, simplified_indices.data(), ls::size_bytes(simplified_indices));
-                upload_offset += ls::size_bytes(simplified_indices);
+    stage_timer.lap("meta");
+    self.set_load_state(uuid, AssetLoadState::Loading, 0.1f);
+
+    //  ── COOKED MODEL ────────────────────────────────────────────────────
+    auto cooked_primitives = std::vector<CookedPrimitive>();
+    // Payloads of freshly cooked primitives, otherwise they live in derived data.
+    auto cooked_payloads = std::vector<std::vector<u8>>();
+    auto source_hash = ls::option<u64>();
+    auto cache_key = ls::option<DerivedDataKey>();
+    auto model_file = ls::option<ModelFile>();
+    // LODs can only be streamed in later if cooked model stays in cache.
+    auto streaming_key = ls::option<DerivedDataKey>();
+    if (packed_asset.has_value()) {
+        // Packs have no sources to cook from.
+        auto packed_data = packed_asset->read_data();
+        if (packed_asset->entry->data_type == AssetPackDataType::Cooked && packed_data.has_value()) {
+            model_file = ModelFile::from_data(std::move(packed_data.value()));
+        }
 
-                cur_lod.meshlets = upload_offset;
-                std::memcpy(cpu_lod_ptr + upload_offset, meshlets.data(), ls::size_bytes(meshlets));
-                upload_offset += ls::size_bytes(meshlets);
+        if (!model_file.has_value()) {
+            LOG_ERROR("Packed model '{}' isn't cooked!", asset_path);
+            return false;
+        }
+    } else {
+        source_hash = self.derived_data_cache.hash_file(asset_path);
+    }
 
-                cur_lod.meshlet_bounds = upload_offset;
-                std::memcpy(cpu_lod_ptr + upload_offset, meshlet_bounds.data(), ls::size_bytes(meshlet_bounds));
-                upload_offset += ls::size_bytes(meshlet_bounds);
+    if (source_hash.has_value()) {
+        cache_key = self.derived_data_cache.make_key(source_hash.value(), ModelFile::params_hash(*model));
+        if (auto derived_data = self.derived_data_cache.get(cache_key.value()); derived_data.has_value()) {
+            model_file = ModelFile::from_data(std::move(derived_data.value()));
+        }
+    }
 
-                cur_lod.local_triangle_indices = upload_offset;
-                std::memcpy(cpu_lod_ptr + upload_offset, local_triangle_indices.data(), ls::size_bytes(local_triangle_indices));
-                upload_offset += ls::size_bytes(local_triangle_indices);
+    if (model_file.has_value() && !model_file->read(*model, cooked_primitives)) {
+        LOG_WARN("Cooked model of '{}' is corrupt, cooking again.", asset_path);
+        model->meshes.clear();
+        model->nodes.clear();
+        model->scenes.clear();
+        cooked_primitives.clear();
+        model_file.reset();
+    }
 
-                cur_lod.indirect_vertex_indices = upload_offset;
-                std::memcpy(cpu_lod_ptr + upload_offset, indirect_vertex_indices.data(), ls::size_bytes(indirect_vertex_indices));
-                upload_offset += ls::size_bytes(indirect_vertex_indices);
+    if (!model_file.has_value()) {
+        if (!cook_gltf_model(asset_path, *model, cooked_primitives, cooked_payloads)) {
+            LOG_ERROR("Failed to parse Model '{}'!", asset_path);
+            return false;
+        }
 
-                cur_lod.indices_count = simplified_indices.size();
-                cur_lod.meshlet_count = meshlet_count;
-                cur_lod.meshlet_bounds_count = meshlet_bounds.size();
-                cur_lod.local_triangle_indices_count = local_triangle_indices.size();
-                cur_lod.indirect_vertex_indices_count = indirect_vertex_indices.size();
+        stage_timer.lap("cook");
 
-                lod_cpu_buffers[lod_index] = ls::pair(cpu_lod_buffer, lod_upload_size);
-                upload_size += lod_upload_size;
+        if (cache_key.has_value()) {
+            auto cooked_data = ModelFile::serialize(*model, cooked_primitives);
+            if (self.derived_data_cache.put(cache_key.value(), cooked_data)) {
+                streaming_key = cache_key;
+            } else {
+                LOG_WARN("Failed to cache cooked model '{}', model will be cooked again on next load.", asset_path);
             }
+        }
+
+        stage_timer.lap("write");
+    } else {
+        streaming_key = cache_key;
+        stage_timer.lap("read");
+    }
+
+    //  ── GPU UPLOAD ──────────────────────────────────────────────────────
+    self.set_load_state(uuid, AssetLoadState::Uploading, 0.5f);
+    auto &device = App::mod<Device>();
+    auto &transfer_man = device.transfer_man();
 
-            auto mesh_upload_offset = 0_u64;
-            gpu_mesh_buffer = Buffer::create(device, upload_size, vuk::MemoryUsage::eGPUonly).value();
+    // Payload ranges go into staging memory first, decoding them is spread
+    // over jobs one codec stream at a time.
+    struct PayloadCopy {
+        const CookedPrimitive *primitive = nullptr;
+        u64 offset = 0;
+        u64 size = 0;
+        u8 *dst = nullptr;
+    };
+    auto payload_copies = std::vector<PayloadCopy>();
+    auto push_payload_copy = [&](const CookedPrimitive &cooked_primitive, u64 offset, u64 size, u8 *dst) {
+        auto streams = cooked_primitive.payload_streams(offset, size);
+        if (streams.empty()) {
+            payload_copies.push_back({ .primitive = &cooked_primitive, .offset = offset, .size = size, .dst = dst });
+            return;
+        }
+
+        for (const auto &stream : streams) {
+            payload_copies.push_back({ .primitive = &cooked_primitive, .offset = stream.offset, .size = stream.size, .dst = dst + (stream.offset - offset) });
+        }
+    };
 
-            // Mesh first
-            auto cpu_mesh_buffer = transfer_man.alloc_transient_buffer(vuk::MemoryUsage::eCPUonly, mesh_upload_size);
-            auto cpu_mesh_ptr = reinterpret_cast<u8 *>(cpu_mesh_buffer->mapped_ptr);
+    // Primitives whose mesh buffer is created here, others share one.
+    struct MeshBufferUpload {
+        usize primitive_index = 0;
+        u64 buffer_hash = 0;
+    };
+    auto mesh_buffer_uploads = std::vector<MeshBufferUpload>();
+    auto cpu_mesh_buffers = std::vector<vuk::Value<vuk::Buffer>>();
+    // Shared buffers might still be uploading for the model that created them.
+    auto upload_value = 0_u64;
+    for (auto primitive_index = 0_sz; primitive_index < cooked_primitives.size(); primitive_index++) {
+        const auto &cooked_primitive = cooked_primitives[primitive_index];
+        auto &primitive = model->primitives.emplace_back();
+        auto &gpu_mesh = model->gpu_meshes.emplace_back(cooked_primitive.gpu_mesh);
+        auto &gpu_mesh_buffer = model->gpu_mesh_buffers.emplace_back();
+        auto &gpu_mesh_buffer_hash = model->gpu_mesh_buffer_hashes.emplace_back(0);
+        model->gpu_lod_buffers.emplace_back();
+        model->gpu_lod_buffer_hashes.emplace_back();
+        auto payload_size = cooked_primitive.payload_size;
+
+        auto *material_asset = self.get_asset(model->materials[cooked_primitive.material_index]);
+        primitive.material_id = material_asset->material_id;
+        primitive.vertex_count = gpu_mesh.vertex_count;
+        primitive.index_count = cooked_primitive.index_count;
+
+        // Streamed primitives start with vertex data and coarsest LOD only,
+        // `MeshStreamer` brings finer ones in as they get selected.
+        auto coarsest_lod_index = gpu_mesh.lod_count - 1;
+        auto resident_lod_index = streaming_key.has_value() ? coarsest_lod_index : 0_u32;
+        auto vertex_data_size = gpu_mesh.lods[0].indices;
+        auto resident_lods_offset = MeshStreamer::lod_range(cooked_primitive.gpu_mesh, payload_size, resident_lod_index).n0;
+        auto resident_lods_size = payload_size - resident_lods_offset;
+        auto gpu_mesh_buffer_size = vertex_data_size + resident_lods_size;
+
+        auto buffer_hash = mesh_buffer_hash(cooked_primitive, resident_lod_index);
+        {
+            auto lock = std::unique_lock(self.mesh_buffers_mutex);
+            auto shared_mesh_buffer_it = self.shared_mesh_buffers.find(buffer_hash);
+            if (shared_mesh_buffer_it != self.shared_mesh_buffers.end()) {
+                auto &shared_mesh_buffer = shared_mesh_buffer_it->second;
+                shared_mesh_buffer.ref_count++;
+                gpu_mesh_buffer = shared_mesh_buffer.buffer;
+                gpu_mesh_buffer_hash = buffer_hash;
+                upload_value = ls::max(upload_value, shared_mesh_buffer.upload_value);
+            }
+        }
 
-            auto gpu_mesh_bda = gpu_mesh_buffer.device_address();
-            gpu_mesh.vertex_positions = gpu_mesh_bda + mesh_upload_offset;
-            std::memcpy(cpu_mesh_ptr + mesh_upload_offset, mesh_vertices.data(), ls::size_bytes(mesh_vertices));
-            mesh_upload_offset += ls::size_bytes(mesh_vertices);
+        if (gpu_mesh_buffer_hash == 0) {
+            gpu_mesh_buffer = Buffer::create(device, gpu_mesh_buffer_size, vuk::MemoryUsage::eGPUonly).value();
+            mesh_buffer_uploads.push_back({ .primitive_index = primitive_index, .buffer_hash = buffer_hash });
+            auto &cpu_mesh_buffer = cpu_mesh_buffers.emplace_back(transfer_man.alloc_staging_buffer(gpu_mesh_buffer_size));
+            auto *cpu_mesh_ptr = reinterpret_cast<u8 *>(cpu_mesh_buffer->mapped_ptr);
+            push_payload_copy(cooked_primitive, 0, vertex_data_size, cpu_mesh_ptr);
+            push_payload_copy(cooked_primitive, resident_lods_offset, resident_lods_size, cpu_mesh_ptr + vertex_data_size);
+        }
 
-            gpu_mesh.vertex_normals = gpu_mesh_bda + mesh_upload_offset;
-            std::memcpy(cpu_mesh_ptr + mesh_upload_offset, mesh_normals.data(), ls::size_bytes(mesh_normals));
-            mesh_upload_offset += ls::size_bytes(mesh_normals);
+        // Payload offsets to device addresses
+        auto gpu_mesh_bda = gpu_mesh_buffer.device_address();
+        gpu_mesh.vertex_positions += gpu_mesh_bda;
+        gpu_mesh.vertex_normals += gpu_mesh_bda;
+        if (gpu_mesh.texture_coords != 0) {
+            gpu_mesh.texture_coords += gpu_mesh_bda;
+        }
 
-            if (!mesh_texcoords.empty()) {
-                gpu_mesh.texture_coords = gpu_mesh_bda + mesh_upload_offset;
-                std::memcpy(cpu_mesh_ptr + mesh_upload_offset, mesh_texcoords.data(), ls::size_bytes(mesh_texcoords));
-                mesh_upload_offset += ls::size_bytes(mesh_texcoords);
+        gpu_mesh.finest_resident_lod = resident_lod_index;
+        for (auto lod_index = 0_u32; lod_index < gpu_mesh.lod_count; lod_index++) {
+            auto &lod = gpu_mesh.lods[lod_index];
+            if (lod_index < resident_lod_index) {
+                lod.indices = 0;
+                lod.meshlets = 0;
+                lod.meshlet_bounds = 0;
+                lod.meshlet_errors = 0;
+                lod.local_triangle_indices = 0;
+                lod.indirect_vertex_indices = 0;
+                continue;
             }
 
-            auto gpu_mesh_buffer_handle = device.buffer(gpu_mesh_buffer.id());
-            auto gpu_mesh_subrange = vuk::discard_buf("mesh", gpu_mesh_buffer_handle->subrange(0, mesh_upload_size));
-            gpu_mesh_subrange = transfer_man.upload(std::move(cpu_mesh_buffer), std::move(gpu_mesh_subrange));
-            transfer_man.wait_on(std::move(gpu_mesh_subrange));
+            MeshStreamer::relocate_lod(lod, resident_lods_offset, gpu_mesh_bda + vertex_data_size);
+        }
 
-            for (auto lod_index = 0_sz; lod_index < gpu_mesh.lod_count; lod_index++) {
-                auto &&[lod_cpu_buffer, lod_upload_size] = lod_cpu_buffers[lod_index];
-                auto &lod = gpu_mesh.lods[lod_index];
+        self.mesh_streamer.add_primitive(
+            uuid,
+            static_cast<u32>(primitive_index),
+            streaming_key,
+            cooked_primitive.gpu_mesh,
+            payload_size,
+            resident_lod_index
+        );
+    }
 
-                lod.indices += gpu_mesh_bda + mesh_upload_offset;
-                lod.meshlets += gpu_mesh_bda + mesh_upload_offset;
-                lod.meshlet_bounds += gpu_mesh_bda + mesh_upload_offset;
-                lod.local_triangle_indices += gpu_mesh_bda + mesh_upload_offset;
-                lod.indirect_vertex_indices += gpu_mesh_bda + mesh_upload_offset;
+    {
+        ZoneScopedN("Decode Mesh Payloads");
+        auto decode_failed = std::atomic<bool>(false);
+        App::get().job_man.parallel_for(static_cast<u32>(payload_copies.size()), 1, [&](u32 first_copy, u32 last_copy) {
+            for (auto i = first_copy; i < last_copy; i++) {
+                const auto &copy = payload_copies[i];
+                if (!copy.primitive->read_payload(copy.offset, { copy.dst, copy.size })) {
+                    decode_failed = true;
+                }
+            }
+        });
 
-                auto gpu_lod_subrange = vuk::discard_buf("mesh lod subrange", gpu_mesh_buffer_handle->subrange(mesh_upload_offset, lod_upload_size));
-                gpu_lod_subrange = transfer_man.upload(std::move(lod_cpu_buffer), std::move(gpu_lod_subrange));
-                transfer_man.wait_on(std::move(gpu_lod_subrange));
+        if (decode_failed) {
+            LOG_ERROR("Failed to decode geometry of model '{}'!", asset_path);
+            transfer_man.discard_staging(cpu_mesh_buffers);
+            self.release_mesh_buffers(*model);
+            self.mesh_streamer.remove_model(uuid);
+            return false;
+        }
+    }
 
-                mesh_upload_offset += lod_upload_size;
+    stage_timer.lap("decode");
+
+    // Every primitive goes into the same upload batch, model becomes
+    // resident once the last one completes.
+    for (auto upload_index = 0_sz; upload_index < mesh_buffer_uploads.size(); upload_index++) {
+        const auto &mesh_buffer_upload = mesh_buffer_uploads[upload_index];
+        auto &cpu_mesh_buffer = cpu_mesh_buffers[upload_index];
+        auto primitive_index = mesh_buffer_upload.primitive_index;
+        auto gpu_mesh_buffer_size = cpu_mesh_buffer->size;
+        auto &gpu_mesh_buffer = model->gpu_mesh_buffers[primitive_index];
+        auto gpu_mesh_buffer_handle = device.buffer(gpu_mesh_buffer.id());
+        auto gpu_mesh_subrange = vuk::discard_buf("mesh", gpu_mesh_buffer_handle->subrange(0, gpu_mesh_buffer_size));
+        gpu_mesh_subrange = transfer_man.upload(std::move(cpu_mesh_buffer), std::move(gpu_mesh_subrange), transfer_man.transfer_domain());
+        // Buffers are shared between queue families, release only makes
+        // writes visible to graphics queue.
+        gpu_mesh_subrange = gpu_mesh_subrange.as_released(vuk::Access::eMemoryRead, vuk::DomainFlagBits::eGraphicsQueue);
+        auto buffer_upload_value = transfer_man.batch_upload(std::move(gpu_mesh_subrange), gpu_mesh_buffer_size);
+        upload_value = ls::max(upload_value, buffer_upload_value);
+
+        // Models loading the same primitive from now on use this one. When
+        // another model got there first, this one stays with this model.
+        {
+            auto lock = std::unique_lock(self.mesh_buffers_mutex);
+            auto shared_mesh_buffer = SharedMeshBuffer{ .buffer = gpu_mesh_buffer, .upload_value = buffer_upload_value, .ref_count = 1 };
+            if (self.shared_mesh_buffers.try_emplace(mesh_buffer_upload.buffer_hash, shared_mesh_buffer).second) {
+                model->gpu_mesh_buffer_hashes[primitive_index] = mesh_buffer_upload.buffer_hash;
             }
         }
+
+        auto upload_progress = static_cast<f32>(upload_index + 1) / static_cast<f32>(mesh_buffer_uploads.size());
+        self.set_load_state(uuid, AssetLoadState::Uploading, 0.5f + 0.5f * upload_progress);
     }
 
+    stage_timer.lap("record upload");
+    LOG_TRACE("Loaded model {}. ({})", uuid.str(), stage_timer.to_string());
+
+    *self.models.slot(model_id) = std::move(model_storage);
+    loaded = true;
+    self.finish_upload(uuid, upload_value);
+
     return true;
 }
 
+static auto model_cpu_size(const Model &model) -> u64 {
+    auto size = sizeof(Model) + ls::size_bytes(model.embedded_textures) + ls::size_bytes(model.materials) + ls::size_bytes(model.primitives)
+        + ls::size_bytes(model.gpu_meshes) + ls::size_bytes(model.gpu_mesh_buffers) + ls::size_bytes(model.gpu_mesh_buffer_hashes)
+        + ls::size_bytes(model.gpu_lod_buffers) + ls::size_bytes(model.gpu_lod_buffer_hashes);
+    for (const auto &mesh : model.meshes) {
+        size += sizeof(Model::Mesh) + mesh.name.size() + ls::size_bytes(mesh.primitive_indices);
+    }
+
+    for (const auto &node : model.nodes) {
+        size += sizeof(Model::Node) + node.name.size() + ls::size_bytes(node.child_indices);
+    }
+
+    for (const auto &scene : model.scenes) {
+        size += sizeof(Model::Scene) + scene.name.size() + ls::size_bytes(scene.node_indices);
+    }
+
+    return size;
+}
+
+// Shared mesh buffers are split between models sharing them.
+static auto model_gpu_size(AssetManager &self, const Model &model) -> u64 {
+    auto size = 0_u64;
+    auto lock = std::unique_lock(self.mesh_buffers_mutex);
+    auto add_buffer_size = [&](const Buffer &buffer, u64 buffer_hash) {
+        auto shared_mesh_buffer_it = buffer_hash ? self.shared_mesh_buffers.find(buffer_hash) : self.shared_mesh_buffers.end();
+        auto share_count = shared_mesh_buffer_it != self.shared_mesh_buffers.end() ? ls::max(shared_mesh_buffer_it->second.ref_count, 1_u64) : 1_u64;
+        size += buffer.data_size() / share_count;
+    };
+
+    for (const auto &[buffer, buffer_hash] : std::views::zip(model.gpu_mesh_buffers, model.gpu_mesh_buffer_hashes)) {
+        add_buffer_size(buffer, buffer_hash);
+    }
+
+    for (const auto &[lod_buffers, lod_buffer_hashes] : std::views::zip(model.gpu_lod_buffers, model.gpu_lod_buffer_hashes)) {
+        for (const auto &[buffer, buffer_hash] : std::views::zip(lod_buffers, lod_buffer_hashes)) {
+            if (buffer) {
+                add_buffer_size(buffer, buffer_hash);
+            }
+        }
+    }
+
+    return size;
+}
+
 auto AssetManager::unload_model(this AssetManager &self, const UUID &uuid) -> bool {
     ZoneScoped;
 
@@ -1018,61 +2602,342 @@ auto AssetManager::unload_model(this AssetManager &self, const UUID &uuid) -> bo
         return false;
     }
 
-    auto *model = self.get_model(asset->model_id);
-    for (auto &v : model->materials) {
-        self.unload_material(v);
-    }
+    // Materials and textures stay referenced while model is cached.
+    auto *model = self.get_model(asset->model_id);
+    auto evicted_uuids = self.asset_cache.insert(uuid, model_cpu_size(*model), model_gpu_size(self, *model));
+    self.evict_assets(evicted_uuids);
+
+    return true;
+}
+
+auto AssetManager::free_model(this AssetManager &self, const UUID &uuid) -> void {
+    ZoneScoped;
+
+    auto model_id = ModelID::Invalid;
+    {
+        // Loads take references under this lock, model could have been
+        // taken back since it was evicted.
+        auto write_lock = std::unique_lock(self.models_mutex);
+        auto *asset = self.get_asset(uuid);
+        if (!asset || !asset->is_loaded() || asset->ref_count != 0) {
+            return;
+        }
+
+        model_id = std::exchange(asset->model_id, ModelID::Invalid);
+    }
+
+    auto *model = self.get_model(model_id);
+    for (auto &v : model->materials) {
+        self.unload_material(v);
+    }
+
+    self.release_mesh_buffers(*model);
+
+    LOG_TRACE("Freed model {}.", uuid.str());
+
+    self.mesh_streamer.remove_model(uuid);
+    self.models.destroy_slot(model_id);
+}
+
+auto AssetManager::release_mesh_buffers(this AssetManager &self, Model &model) -> void {
+    ZoneScoped;
+
+    auto &device = App::mod<Device>();
+    auto lock = std::unique_lock(self.mesh_buffers_mutex);
+    auto release_buffer = [&](const Buffer &buffer, u64 buffer_hash) {
+        auto shared_mesh_buffer_it = buffer_hash ? self.shared_mesh_buffers.find(buffer_hash) : self.shared_mesh_buffers.end();
+        if (shared_mesh_buffer_it != self.shared_mesh_buffers.end()) {
+            if (--shared_mesh_buffer_it->second.ref_count != 0) {
+                return;
+            }
+
+            self.shared_mesh_buffers.erase(shared_mesh_buffer_it);
+        }
+
+        device.destroy(buffer.id());
+    };
+
+    for (const auto &[buffer, buffer_hash] : std::views::zip(model.gpu_mesh_buffers, model.gpu_mesh_buffer_hashes)) {
+        release_buffer(buffer, buffer_hash);
+    }
+
+    for (const auto &[lod_buffers, lod_buffer_hashes] : std::views::zip(model.gpu_lod_buffers, model.gpu_lod_buffer_hashes)) {
+        for (const auto &[buffer, buffer_hash] : std::views::zip(lod_buffers, lod_buffer_hashes)) {
+            if (buffer) {
+                release_buffer(buffer, buffer_hash);
+            }
+        }
+    }
+
+    model.gpu_mesh_buffers.clear();
+    model.gpu_mesh_buffer_hashes.clear();
+    model.gpu_lod_buffers.clear();
+    model.gpu_lod_buffer_hashes.clear();
+}
+
+// Same source bytes loaded with the same parameters end up as the same
+// GPU texture. Never 0.
+static auto texture_content_hash(u64 source_hash, const TextureInfo &info, TextureCookFormat cook_format) -> u64 {
+    auto params = std::array<u32, 5>{
+        static_cast<u32>(info.use_srgb),
+        static_cast<u32>(info.kind),
+        std::bit_cast<u32>(info.alpha_cutoff),
+        static_cast<u32>(info.streamed),
+        static_cast<u32>(cook_format),
+    };
+    auto hash = XXH3_64bits_withSeed(params.data(), params.size() * sizeof(u32), source_hash);
+
+    return hash == 0 ? 1 : hash;
+}
+
+auto AssetManager::load_texture(this AssetManager &self, const UUID &uuid, const TextureInfo &info) -> bool {
+    ZoneScoped;
+    memory::ScopedStack stack;
+
+    auto asset_path = fs::path{};
+    auto packed_asset = ls::option<PackedAsset>();
+
+    {
+        auto read_lock = std::shared_lock(self.textures_mutex);
+        auto *asset = self.get_asset(uuid);
+        LS_EXPECT(asset);
+        asset->acquire_ref();
+        if (asset->is_loaded()) {
+            self.asset_cache.take(uuid);
+            return true;
+        }
+
+        asset_path = asset->path;
+        packed_asset = find_packed_asset(self, uuid, *asset);
+    }
+
+    self.asset_cache.record_miss();
+
+    auto loaded = false;
+    // `SharedTexture` this load is the first of, 0 when there is none.
+    auto shared_content_hash = 0_u64;
+    self.set_load_state(uuid, AssetLoadState::Loading, 0.0f);
+    LS_DEFER(&) {
+        if (loaded) {
+            return;
+        }
+
+        self.set_load_state(uuid, AssetLoadState::Failed, 0.0f);
+        if (shared_content_hash == 0) {
+            return;
+        }
+
+        // Assets waiting on this load fail with it.
+        auto waiting_uuids = std::vector<UUID>();
+        {
+            auto write_lock = std::unique_lock(self.textures_mutex);
+            auto shared_texture_it = self.shared_textures.find(shared_content_hash);
+            if (shared_texture_it != self.shared_textures.end()) {
+                waiting_uuids.assign(shared_texture_it->second.uuids.begin() + 1, shared_texture_it->second.uuids.end());
+                self.shared_textures.erase(shared_texture_it);
+            }
+
+            self.get_asset(uuid)->content_hash = 0;
+            for (const auto &waiting_uuid : waiting_uuids) {
+                self.get_asset(waiting_uuid)->content_hash = 0;
+            }
+        }
+
+        for (const auto &waiting_uuid : waiting_uuids) {
+            self.set_load_state(waiting_uuid, AssetLoadState::Failed, 0.0f);
+
+            auto lock = std::unique_lock(self.load_requests_mutex);
+            auto request_it = self.load_requests.find(waiting_uuid);
+            if (request_it != self.load_requests.end() && !request_it->second->is_done()) {
+                request_it->second->state = AssetLoadState::Failed;
+                request_it->second->state.notify_all();
+            }
+        }
+    };
+
+    auto stage_timer = StageTimer{};
+    auto file_data = std::vector<u8>();
+    auto raw_data = ls::span<u8>(const_cast<u8 *>(info.embedded_data.data()), info.embedded_data.size());
+    // Hash of source bytes, embedded or packed ones are hashed here.
+    auto source_hash = ls::option<u64>();
+    auto file_type = info.file_type;
+    // Levels of uncompressed KTX2 files are read straight into staging,
+    // only header is read here.
+    auto ktx_file = File{};
+    auto ktx_header = ls::option<KTX2ImageInfo>();
+    // Cooked textures come from derived data cache, levels are copied into
+    // staging as they are.
+    auto texture_file = ls::option<TextureFile>();
+    auto cache_key = ls::option<DerivedDataKey>();
+    // Source files in packs, `raw_data` points into it.
+    auto packed_data = ls::option<DerivedData>();
+    // PNG/JPEG textures cooked into KTX2, `raw_data` points into it.
+    auto cooked_ktx2 = ls::option<DerivedData>();
+    if (info.embedded_data.empty()) {
+        if (!asset_path.has_extension()) {
+            LOG_ERROR("Trying to load texture \"{}\" without a file extension.", asset_path);
+            return false;
+        }
+
+        file_type = self.to_asset_file_type(asset_path);
+        if (packed_asset.has_value()) {
+            packed_data = packed_asset->read_data();
+            if (!packed_data.has_value()) {
+                LOG_ERROR("Failed to read packed texture '{}'!", asset_path);
+                return false;
+            }
+
+            source_hash = XXH3_64bits(packed_data->data.data(), packed_data->data.size());
+            if (packed_asset->entry->data_type == AssetPackDataType::Cooked) {
+                // Packs have no sources to cook another variant from.
+                auto cook_format = packed_asset->pack->texture_cook_format;
+                auto params_hash = TextureFile::params_hash(info.kind == TextureKind::Normal, info.alpha_cutoff, cook_format);
+                if (packed_asset->entry->params_hash != params_hash) {
+                    LOG_WARN("Packed texture '{}' was cooked for another material slot, loading it as is.", asset_path);
+                }
+
+                if (cook_format == TextureCookFormat::BC7) {
+                    texture_file = TextureFile::from_data(std::move(packed_data.value()));
+                    if (!texture_file.has_value()) {
+                        LOG_ERROR("Packed texture '{}' is corrupt!", asset_path);
+                        return false;
+                    }
+
+                    file_type = AssetFileType::Binary;
+                } else {
+                    cooked_ktx2 = std::move(packed_data.value());
+                    raw_data = cooked_ktx2->data;
+                    file_type = AssetFileType::KTX2;
+                }
+            } else {
+                raw_data = packed_data->data;
+            }
+        } else {
+            source_hash = self.derived_data_cache.hash_file(asset_path);
+        }
+
+        if (!packed_asset.has_value() && (file_type == AssetFileType::PNG || file_type == AssetFileType::JPEG)) {
+            // Same parameters `import_asset` cooks with
+            auto normal = info.kind == TextureKind::Normal;
+            if (source_hash.has_value()) {
+                cache_key = self.derived_data_cache.make_key(source_hash.value(), TextureFile::params_hash(normal, info.alpha_cutoff, self.texture_cook_format));
+                if (auto derived_data = self.derived_data_cache.get(cache_key.value()); derived_data.has_value()) {
+                    if (self.texture_cook_format == TextureCookFormat::BC7) {
+                        texture_file = TextureFile::from_data(std::move(derived_data.value()));
+                    } else {
+                        cooked_ktx2 = std::move(derived_data.value());
+                    }
+                }
+            }
+
+            if (texture_file.has_value()) {
+                file_type = AssetFileType::Binary;
+            } else if (cooked_ktx2.has_value()) {
+                // Can't stream, there is no `TextureFile` to stream from.
+                cache_key.reset();
+                raw_data = cooked_ktx2->data;
+                file_type = AssetFileType::KTX2;
+            } else {
+                cache_key.reset();
+                // Decoded below this time, next load gets the cooked one
+                self.cook_texture(asset_path, normal, info.alpha_cutoff);
+            }
+        }
+
+        if (file_type == AssetFileType::KTX2 && !packed_asset.has_value() && !cooked_ktx2.has_value()) {
+            ktx_file = File(asset_path, FileAccess::Read);
+            if (ktx_file) {
+                ktx_header = KTX2ImageInfo::read_header(ktx_file);
+                if (ktx_header.has_value() && ktx_header->needs_transcoding) {
+                    ktx_header.reset();
+                }
+            }
+        }
+
+        if (!ktx_header.has_value() && !texture_file.has_value() && !packed_asset.has_value() && !cooked_ktx2.has_value()) {
+            file_data = File::to_bytes(asset_path);
+            if (file_data.empty()) {
+                LOG_ERROR("Error reading '{}'. Invalid texture file? Notice the question mark.", asset_path);
+                return false;
+            }
 
-    auto &device = App::mod<Device>();
-    for (const auto &buffer : model->gpu_mesh_buffers) {
-        device.destroy(buffer.id());
+            raw_data = file_data;
+        }
+    } else {
+        source_hash = XXH3_64bits(raw_data.data(), raw_data.size());
     }
 
-    self.models.destroy_slot(asset->model_id);
-    asset->model_id = ModelID::Invalid;
+    stage_timer.lap("read");
 
-    return true;
-}
-
-auto AssetManager::load_texture(this AssetManager &self, const UUID &uuid, const TextureInfo &info) -> bool {
-    ZoneScoped;
-    memory::ScopedStack stack;
+    //  ── SHARED TEXTURE ──────────────────────────────────────────────────
+    if (source_hash.has_value()) {
+        auto content_hash = texture_content_hash(source_hash.value(), info, self.texture_cook_format);
+        auto write_lock = std::unique_lock(self.textures_mutex);
+        auto &shared_texture = self.shared_textures[content_hash];
+        if (std::ranges::find(shared_texture.uuids, uuid) != shared_texture.uuids.end()) {
+            // Another call is already loading this asset, it becomes
+            // resident with that one.
+            loaded = true;
+            self.set_load_state(uuid, AssetLoadState::Uploading, 0.5f);
+            if (shared_texture.texture_id == TextureID::Invalid) {
+                return true;
+            }
 
-    auto asset_path = fs::path{};
+            // Texture exists already, its upload might even be complete.
+            auto upload_value = shared_texture.upload_value;
+            write_lock.unlock();
+            self.finish_upload(uuid, upload_value);
 
-    {
-        auto read_lock = std::shared_lock(self.textures_mutex);
-        auto *asset = self.get_asset(uuid);
-        LS_EXPECT(asset);
-        asset->acquire_ref();
-        if (asset->is_loaded()) {
             return true;
         }
 
-        asset_path = asset->path;
-    }
+        auto *asset = self.get_asset(uuid);
+        asset->content_hash = content_hash;
+        shared_texture.uuids.push_back(uuid);
+        if (shared_texture.uuids.size() > 1) {
+            // Finished by whoever loads it, or already has been.
+            loaded = true;
+            self.set_load_state(uuid, AssetLoadState::Uploading, 0.5f);
+            if (shared_texture.texture_id == TextureID::Invalid) {
+                return true;
+            }
 
-    auto raw_data = info.embedded_data;
-    auto file_type = info.file_type;
-    if (info.embedded_data.empty()) {
-        if (!asset_path.has_extension()) {
-            LOG_ERROR("Trying to load texture \"{}\" without a file extension.", asset_path);
-            return false;
-        }
+            asset->texture_id = shared_texture.texture_id;
+            auto upload_value = shared_texture.upload_value;
+            auto shared_uuid = shared_texture.uuids[0];
+            write_lock.unlock();
 
-        raw_data = File::to_bytes(asset_path);
-        if (raw_data.empty()) {
-            LOG_ERROR("Error reading '{}'. Invalid texture file? Notice the question mark.", asset_path);
-            return false;
+            LOG_TRACE("Loaded texture {}, same as {}.", uuid.str(), shared_uuid.str());
+            self.finish_upload(uuid, upload_value);
+
+            return true;
         }
 
-        file_type = self.to_asset_file_type(asset_path);
+        shared_content_hash = content_hash;
     }
 
     auto format = vuk::Format::eUndefined;
+    // Srgb variant of `format` when it is, libktx transcodes the same way.
+    auto ktx_transcode_format = vuk::Format::eUndefined;
     auto extent = vuk::Extent3D{};
     auto mip_level_count = 1_u32;
+    // Streamed textures start with their mip tail, see `TextureStreamer`.
+    auto first_mip = 0_u32;
     switch (file_type) {
+        case AssetFileType::Binary: {
+            const auto &texture_header = texture_file->header().texture_header;
+            extent = texture_header.extent;
+            format = texture_header.format;
+            if (format == vuk::Format::eBc7UnormBlock && info.use_srgb) {
+                format = vuk::Format::eBc7SrgbBlock;
+            }
+            mip_level_count = texture_header.mip_level_count;
+            // Finer levels are streamed from derived data cache, packed
+            // textures don't have an entry there.
+            if (info.streamed && cache_key.has_value()) {
+                first_mip = TextureStreamer::mip_tail_level(extent, mip_level_count);
+            }
+        } break;
         case AssetFileType::PNG:
         case AssetFileType::JPEG: {
             auto image_info = STBImageInfo::parse_info(raw_data);
@@ -1081,16 +2946,40 @@ auto AssetManager::load_texture(this AssetManager &self, const UUID &uuid, const
             }
             extent = image_info->extent;
             format = info.use_srgb ? vuk::Format::eR8G8B8A8Srgb : vuk::Format::eR8G8B8A8Unorm;
-            mip_level_count = static_cast<u32>(glm::floor(glm::log2(static_cast<f32>(ls::max(extent.width, extent.height)))) + 1);
+            mip_level_count = MipChain::level_count(extent);
         } break;
         case AssetFileType::KTX2: {
-            auto image_info = KTX2ImageInfo::parse_info(raw_data);
+            auto image_info = ktx_header.has_value() ? ktx_header : KTX2ImageInfo::parse_info(raw_data);
             if (!image_info.has_value()) {
                 return false;
             }
             extent = image_info->base_extent;
-            format = info.use_srgb ? vuk::Format::eBc7SrgbBlock : vuk::Format::eBc7UnormBlock;
             mip_level_count = image_info->mip_level_count;
+            if (!image_info->needs_transcoding) {
+                // Stored formats are uploaded as they are.
+                format = image_info->format;
+                if (format == vuk::Format::eBc7UnormBlock && info.use_srgb) {
+                    format = vuk::Format::eBc7SrgbBlock;
+                }
+
+                break;
+            }
+
+            // Normals and masks don't need channels they don't use, BC5
+            // and BC4 are half the size of BC7 and keep more precision.
+            // Two component normals are encoded with Y in alpha slice,
+            // which is where BC5 takes its second channel from.
+            auto channel_count = 4_u32;
+            if (info.kind == TextureKind::Normal && image_info->component_count == 2) {
+                channel_count = 2;
+            } else if (info.kind == TextureKind::Mask) {
+                channel_count = 1;
+            }
+
+            format = KTX2ImageInfo::choose_transcode_format(channel_count, info.use_srgb, [](vuk::Format candidate) {
+                return App::mod<Device>().is_sampled_format_supported(candidate);
+            });
+            ktx_transcode_format = format;
         } break;
         default: {
             LOG_ERROR("Failed to load texture '{}', invalid extension.", asset_path);
@@ -1122,17 +3011,18 @@ auto AssetManager::load_texture(this AssetManager &self, const UUID &uuid, const
         .format = format,
         .usage = vuk::ImageUsageFlagBits::eSampled | vuk::ImageUsageFlagBits::eTransferSrc,
         .type = vuk::ImageType::e2D,
-        .extent = extent,
+        .extent = TextureStreamer::level_extent(extent, first_mip),
         .slice_count = 1,
-        .mip_count = mip_level_count,
+        .mip_count = mip_level_count - first_mip,
         .name = stack.format("{} Image", rel_path),
+        .is_concurrent = true,
     };
     auto image = Image::create(device, image_info).value();
 
     auto subresource_range = vuk::ImageSubresourceRange{
         .aspectMask = vuk::ImageAspectFlagBits::eColor,
         .baseMipLevel = 0,
-        .levelCount = mip_level_count,
+        .levelCount = mip_level_count - first_mip,
         .baseArrayLayer = 0,
         .layerCount = 1,
     };
@@ -1144,53 +3034,129 @@ auto AssetManager::load_texture(this AssetManager &self, const UUID &uuid, const
     };
     auto image_view = ImageView::create(device, image, image_view_info).value();
     auto dst_attachment = image_view.discard(device, "dst image", vuk::ImageUsageFlagBits::eTransferDst);
+    stage_timer.lap("create");
+    self.set_load_state(uuid, AssetLoadState::Uploading, 0.5f);
+
+    auto upload_value = 0_u64;
+    auto upload_size = TextureStreamer::levels_size(format, extent, first_mip, mip_level_count);
+    // Staging of levels, given back to ring when load fails before upload.
+    auto staging_buffers = std::vector<vuk::Value<vuk::Buffer>>();
+    LS_DEFER(&) {
+        if (upload_value == 0) {
+            transfer_man.discard_staging(staging_buffers);
+        }
+    };
 
     switch (file_type) {
+        case AssetFileType::Binary: {
+            ZoneScopedN("Read Cooked Texture");
+            auto uploaded_attachment = TextureStreamer::upload_levels(device, texture_file.value(), std::move(dst_attachment), format, first_mip);
+            if (!uploaded_attachment.has_value()) {
+                LOG_ERROR("Failed to upload cooked texture '{}'!", asset_path);
+                return false;
+            }
+
+            upload_value = transfer_man.batch_upload(std::move(uploaded_attachment.value()), upload_size);
+            stage_timer.lap("record upload");
+        } break;
         case AssetFileType::PNG:
         case AssetFileType::JPEG: {
             ZoneScopedN("Parse STB");
-            auto parsed_image = STBImageInfo::parse(raw_data);
-            if (!parsed_image.has_value()) {
+            // Decoded into staging of base level, mips are written next to
+            // it. Nothing is copied after stb.
+            auto levels = std::vector<ls::span<u8>>(mip_level_count);
+            for (u32 level = 0; level < mip_level_count; level++) {
+                auto level_extent = TextureStreamer::level_extent(extent, level);
+                auto buffer = transfer_man.alloc_image_buffer(format, level_extent);
+                levels[level] = { reinterpret_cast<u8 *>(buffer->mapped_ptr), vuk::compute_image_size(format, level_extent) };
+                staging_buffers.push_back(buffer);
+
+                // Copy is recorded, it executes after level is written.
+                auto dst_mip = dst_attachment.mip(level);
+                dst_mip = transfer_man.upload(std::move(buffer), std::move(dst_mip), transfer_man.transfer_domain());
+            }
+
+            if (!STBImageInfo::parse_into(raw_data, levels[0])) {
+                return false;
+            }
+
+            stage_timer.lap("decode");
+
+            // Mips are filtered on CPU with the same code cooking uses,
+            // GPU blits can't filter in linear space or keep alpha coverage.
+            auto mip_chain_info = MipChainInfo{
+                .extent = extent,
+                .filter = info.kind == TextureKind::Normal ? MipFilter::Box : MipFilter::Kaiser,
+                .srgb = info.use_srgb,
+                .normal = info.kind == TextureKind::Normal,
+                .alpha_cutoff = info.alpha_cutoff,
+            };
+            if (!MipChain::generate_into(mip_chain_info, levels)) {
                 return false;
             }
 
-            auto image_data = std::move(parsed_image->data);
-            auto buffer = transfer_man.alloc_image_buffer(format, extent);
-            std::memcpy(buffer->mapped_ptr, image_data.data(), image_data.size());
+            stage_timer.lap("mips");
 
-            dst_attachment = vuk::copy(std::move(buffer), std::move(dst_attachment));
-            dst_attachment = vuk::generate_mips(std::move(dst_attachment), 0, mip_level_count - 1);
-            dst_attachment.as_released(vuk::Access::eFragmentSampled, vuk::DomainFlagBits::eGraphicsQueue);
-            transfer_man.wait_on(std::move(dst_attachment));
+            dst_attachment = dst_attachment.as_released(vuk::Access::eFragmentSampled, vuk::DomainFlagBits::eGraphicsQueue);
+            upload_value = transfer_man.batch_upload(std::move(dst_attachment), upload_size);
+            stage_timer.lap("record upload");
         } break;
         case AssetFileType::KTX2: {
             ZoneScopedN("Parse KTX");
-            auto parsed_image = KTX2ImageInfo::parse(raw_data);
-            if (!parsed_image.has_value()) {
-                return false;
-            }
-            auto image_data = std::move(parsed_image->data);
-
-            for (u32 level = 0; level < parsed_image->mip_level_count; level++) {
-                ZoneScoped;
-                ZoneTextF("Upload KTX mip %u", level);
-                auto mip_data_offset = parsed_image->per_level_offsets[level];
-                auto level_extent = vuk::Extent3D{
-                    .width = parsed_image->base_extent.width >> level,
-                    .height = parsed_image->base_extent.height >> level,
-                    .depth = 1,
-                };
-                auto size = vuk::compute_image_size(format, level_extent);
+            auto alloc_level = [&](u32 level, vuk::Extent3D level_extent) -> ls::span<u8> {
                 auto buffer = transfer_man.alloc_image_buffer(format, level_extent);
+                auto buffer_size = vuk::compute_image_size(format, level_extent);
+                auto *buffer_ptr = reinterpret_cast<u8 *>(buffer->mapped_ptr);
+                staging_buffers.push_back(buffer);
 
-                // TODO, WARN: size param might not be safe. Check with asan.
-                std::memcpy(buffer->mapped_ptr, image_data.data() + mip_data_offset, size);
+                // Copy is recorded, it executes after level is written.
                 auto dst_mip = dst_attachment.mip(level);
-                vuk::copy(std::move(buffer), std::move(dst_mip));
+                dst_mip = transfer_man.upload(std::move(buffer), std::move(dst_mip), transfer_man.transfer_domain());
+
+                return { buffer_ptr, buffer_size };
+            };
+
+            if (ktx_header.has_value()) {
+                for (u32 level = 0; level < ktx_header->mip_level_count; level++) {
+                    ZoneScoped;
+                    ZoneTextF("Read KTX mip %u", level);
+                    auto level_extent = vuk::Extent3D{
+                        .width = ls::max(extent.width >> level, 1_u32),
+                        .height = ls::max(extent.height >> level, 1_u32),
+                        .depth = 1,
+                    };
+                    auto dst = alloc_level(level, level_extent);
+                    auto level_size = ktx_header->per_level_sizes[level];
+                    if (dst.size_bytes() < level_size) {
+                        LOG_ERROR("KTX2 level {} of '{}' doesn't match its format!", level, asset_path);
+                        return false;
+                    }
+
+                    ktx_file.seek(static_cast<i64>(ktx_header->per_level_offsets[level]));
+                    if (ktx_file.read(dst.data(), level_size) != level_size) {
+                        LOG_ERROR("Failed to read KTX2 level {} of '{}'!", level, asset_path);
+                        return false;
+                    }
+                }
+
+                stage_timer.lap("read levels");
+            } else {
+                auto parsed = KTX2ImageInfo::parse_into(raw_data, ktx_transcode_format, [&](u32 level, vuk::Extent3D level_extent, usize) -> ls::span<u8> {
+                    ZoneScoped;
+                    ZoneTextF("Upload KTX mip %u", level);
+
+                    return alloc_level(level, level_extent);
+                });
+                if (!parsed) {
+                    return false;
+                }
+
+                stage_timer.lap("transcode");
             }
 
             dst_attachment = dst_attachment.as_released(vuk::Access::eFragmentSampled, vuk::DomainFlagBits::eGraphicsQueue);
-            transfer_man.wait_on(std::move(dst_attachment));
+            upload_value = transfer_man.batch_upload(std::move(dst_attachment), upload_size);
+            stage_timer.lap("record upload");
         } break;
         default: {
             LOG_ERROR("Failed to load texture '{}', invalid extension.", asset_path);
@@ -1198,13 +3164,37 @@ auto AssetManager::load_texture(this AssetManager &self, const UUID &uuid, const
         }
     }
 
+    // Assets that came for the same texture while it was loading.
+    auto waiting_uuids = std::vector<UUID>();
     {
         auto write_lock = std::unique_lock(self.textures_mutex);
         auto *asset = self.get_asset(uuid);
         asset->texture_id = self.textures.create_slot(Texture{ .image = image, .image_view = image_view, .sampler = sampler });
+        if (shared_content_hash != 0) {
+            auto &shared_texture = self.shared_textures[shared_content_hash];
+            shared_texture.texture_id = asset->texture_id;
+            shared_texture.upload_value = upload_value;
+            waiting_uuids.assign(shared_texture.uuids.begin() + 1, shared_texture.uuids.end());
+            for (const auto &waiting_uuid : waiting_uuids) {
+                self.get_asset(waiting_uuid)->texture_id = asset->texture_id;
+            }
+        }
+    }
+
+    // Textures that can't stream still count against the budget.
+    if (info.streamed && first_mip != 0) {
+        self.texture_streamer.add_texture(uuid, cache_key, format, extent, mip_level_count, first_mip);
+    } else {
+        self.texture_streamer.add_texture(uuid, ls::nullopt, format, extent, mip_level_count, 0);
     }
 
-    LOG_TRACE("Loaded texture {}.", uuid.str());
+    LOG_TRACE("Loaded texture {}. ({})", uuid.str(), stage_timer.to_string());
+
+    loaded = true;
+    self.finish_upload(uuid, upload_value);
+    for (const auto &waiting_uuid : waiting_uuids) {
+        self.finish_upload(waiting_uuid, upload_value);
+    }
 
     return true;
 }
@@ -1217,18 +3207,110 @@ auto AssetManager::unload_texture(this AssetManager &self, const UUID &uuid) ->
         return false;
     }
 
+    auto gpu_size = 0_u64;
+    {
+        auto read_lock = std::shared_lock(self.textures_mutex);
+        const auto &image = self.textures.slot(asset->texture_id)->image;
+        gpu_size = TextureStreamer::levels_size(image.format(), image.extent(), 0, image.mip_count());
+        // Shared textures are split between assets sharing them.
+        auto shared_texture_it = self.shared_textures.find(asset->content_hash);
+        if (shared_texture_it != self.shared_textures.end() && !shared_texture_it->second.uuids.empty()) {
+            gpu_size /= shared_texture_it->second.uuids.size();
+        }
+    }
+
+    auto evicted_uuids = self.asset_cache.insert(uuid, sizeof(Texture), gpu_size);
+    self.evict_assets(evicted_uuids);
+
+    return true;
+}
+
+auto AssetManager::free_texture(this AssetManager &self, const UUID &uuid) -> void {
+    ZoneScoped;
+
+    auto texture_id = TextureID::Invalid;
+    auto content_hash = 0_u64;
+    {
+        // Loads take references under this lock, texture could have been
+        // taken back since it was evicted.
+        auto write_lock = std::unique_lock(self.textures_mutex);
+        auto *asset = self.get_asset(uuid);
+        if (!asset || !asset->is_loaded() || asset->ref_count != 0) {
+            return;
+        }
+
+        texture_id = std::exchange(asset->texture_id, TextureID::Invalid);
+        content_hash = std::exchange(asset->content_hash, 0_u64);
+    }
+
+    if (!self.release_shared_texture(uuid, content_hash)) {
+        LOG_TRACE("Freed texture {}, still shared.", uuid.str());
+        return;
+    }
+
     auto &device = App::mod<Device>();
-    auto *texture = self.get_texture(asset->texture_id);
+    auto write_lock = std::unique_lock(self.textures_mutex);
+    auto *texture = self.textures.slot(texture_id);
     device.destroy(texture->image_view.id());
     device.destroy(texture->image.id());
     device.destroy(texture->sampler.id());
 
-    LOG_TRACE("Unloaded texture {}.", uuid.str());
+    LOG_TRACE("Freed texture {}.", uuid.str());
 
-    self.textures.destroy_slot(asset->texture_id);
-    asset->texture_id = TextureID::Invalid;
+    self.textures.destroy_slot(texture_id);
+}
 
-    return true;
+auto AssetManager::release_shared_texture(this AssetManager &self, const UUID &uuid, u64 content_hash) -> bool {
+    ZoneScoped;
+
+    // Streamer locks textures while swapping images, it is called unlocked.
+    auto is_last = true;
+    auto new_stream_uuid = ls::option<UUID>();
+    {
+        auto write_lock = std::unique_lock(self.textures_mutex);
+        auto shared_texture_it = self.shared_textures.find(content_hash);
+        if (shared_texture_it != self.shared_textures.end()) {
+            auto &uuids = shared_texture_it->second.uuids;
+            auto uuid_it = std::ranges::find(uuids, uuid);
+            // Streamer knows texture by the first one.
+            auto was_stream_uuid = uuid_it == uuids.begin();
+            if (uuid_it != uuids.end()) {
+                uuids.erase(uuid_it);
+            }
+
+            is_last = uuids.empty();
+            if (is_last) {
+                self.shared_textures.erase(shared_texture_it);
+            } else if (was_stream_uuid) {
+                new_stream_uuid = uuids[0];
+            }
+        }
+    }
+
+    if (is_last) {
+        self.texture_streamer.remove_texture(uuid);
+    } else if (new_stream_uuid.has_value()) {
+        self.texture_streamer.rename_texture(uuid, new_stream_uuid.value());
+    }
+
+    return is_last;
+}
+
+auto AssetManager::get_texture_stream_uuid(this AssetManager &self, const UUID &uuid) -> UUID {
+    ZoneScoped;
+
+    auto read_lock = std::shared_lock(self.textures_mutex);
+    auto *asset = self.get_asset(uuid);
+    if (!asset || asset->content_hash == 0) {
+        return uuid;
+    }
+
+    auto shared_texture_it = self.shared_textures.find(asset->content_hash);
+    if (shared_texture_it == self.shared_textures.end() || shared_texture_it->second.uuids.empty()) {
+        return uuid;
+    }
+
+    return shared_texture_it->second.uuids[0];
 }
 
 auto AssetManager::is_texture_loaded(this AssetManager &self, const UUID &uuid) -> bool {
@@ -1421,15 +3503,32 @@ auto AssetManager::load_scene(this AssetManager &self, const UUID &uuid) -> bool
 
     asset->scene_id = self.scenes.create_slot(std::make_unique<Scene>());
     auto *scene = self.scenes.slot(asset->scene_id)->get();
+    auto scene_path = asset->path;
+    auto packed_asset = find_packed_asset(self, uuid, *asset);
 
-    if (!scene->init("unnamed_scene")) {
-        return false;
-    }
+    auto import_scene = [&]() {
+        if (!packed_asset.has_value()) {
+            return scene->import_from_file(scene_path);
+        }
+
+        auto packed_data = packed_asset->read_data();
+        if (!packed_data.has_value()) {
+            LOG_ERROR("Failed to read packed scene '{}'!", scene_path);
+            return false;
+        }
 
-    if (!scene->import_from_file(asset->path)) {
+        return scene->import_from_data(std::string_view(reinterpret_cast<const c8 *>(packed_data->data.data()), packed_data->data.size()));
+    };
+
+    // Assets of the scene load on their own, scene only waits for its entities.
+    self.set_load_state(uuid, AssetLoadState::Loading, 0.0f);
+    if (!scene->init("unnamed_scene") || !import_scene()) {
+        self.set_load_state(uuid, AssetLoadState::Failed, 0.0f);
         return false;
     }
 
+    self.set_load_state(uuid, AssetLoadState::Resident, 1.0f);
+
     return true;
 }
 
@@ -1511,6 +3610,9 @@ auto AssetManager::export_scene(this AssetManager &self, const UUID &uuid, JsonW
     LS_EXPECT(scene);
     write_scene_asset_meta(json, scene);
 
+    // Don't hot reload what we just wrote
+    self.file_watcher.suppress(path);
+
     return scene->export_to_file(path);
 }
 
@@ -1524,10 +3626,22 @@ auto AssetManager::delete_asset(this AssetManager &self, const UUID &uuid) -> vo
 
     if (asset->is_loaded()) {
         asset->ref_count = ls::min(asset->ref_count, 1_u64);
-        self.unload_asset(uuid);
+        if (asset->ref_count != 0) {
+            self.unload_asset(uuid);
+        }
+
+        // Deleted assets don't stay cached.
+        if (self.asset_cache.remove(uuid)) {
+            self.evict_assets({ uuid });
+        }
 
         {
             auto write_lock = std::unique_lock(self.registry_mutex);
+            auto path_it = self.asset_paths.find(ls::pair(asset->path, asset->type));
+            if (path_it != self.asset_paths.end() && path_it->second == uuid) {
+                self.asset_paths.erase(path_it);
+            }
+
             self.registry.erase(uuid);
         }
     }
@@ -1535,6 +3649,223 @@ auto AssetManager::delete_asset(this AssetManager &self, const UUID &uuid) -> vo
     // LOG_TRACE("Deleted asset {}.", uuid.str());
 }
 
+auto AssetManager::watch_project(this AssetManager &self, const fs::path &path) -> bool {
+    ZoneScoped;
+
+    self.file_watcher.destroy();
+    return self.file_watcher.init(path);
+}
+
+auto AssetManager::poll_file_changes(this AssetManager &self) -> std::vector<FileEvent> {
+    ZoneScoped;
+
+    auto events = self.file_watcher.poll();
+    for (const auto &event : events) {
+        if (event.action_mask & FileActionMask::Directory) {
+            continue;
+        }
+
+        const auto &path = event.file_name;
+        auto file_type = self.to_asset_file_type(path);
+        if (file_type == AssetFileType::Meta) {
+            if (event.action_mask & FileActionMask::Create) {
+                self.register_asset(path);
+            }
+
+            continue;
+        }
+
+        auto asset_type = self.to_asset_type(file_type);
+        if (asset_type == AssetType::None) {
+            continue;
+        }
+
+        auto uuid = self.find_asset(path, asset_type);
+        if (event.action_mask & FileActionMask::Delete) {
+            // Removing alive assets from under the scenes would leave dangling
+            // IDs. Keep them, whoever owns the asset decides what to do.
+            if (uuid) {
+                LOG_WARN("Source of asset {} ('{}') is deleted.", uuid.str(), path);
+            }
+
+            continue;
+        }
+
+        if (!uuid) {
+            // Scenes are only created through the editor, don't guess.
+            if (asset_type != AssetType::Scene) {
+                self.import_asset(path);
+            }
+
+            continue;
+        }
+
+        // Changed textures are cooked again by their reload, with the
+        // parameters they are loaded with.
+        auto *asset = self.get_asset(uuid);
+        if (asset && asset->is_loaded()) {
+            LOG_INFO("Reloading {} asset '{}'.", self.to_asset_type_sv(asset_type), path);
+            self.reload_asset(uuid);
+        }
+    }
+
+    return events;
+}
+
+auto AssetManager::reload_asset(this AssetManager &self, const UUID &uuid) -> bool {
+    ZoneScoped;
+
+    auto *asset = self.get_asset(uuid);
+    if (!asset || !asset->is_loaded()) {
+        return false;
+    }
+
+    // Would race with its loading job, changes are picked up on next event.
+    if (!asset->is_resident()) {
+        return false;
+    }
+
+    // Resources of old asset might still be in use by in flight frames.
+    auto &device = App::mod<Device>();
+    device.wait();
+
+    // Load into fresh slots like a regular load, then swap contents with old
+    // slots and release what's left. Refcount belongs to the old slot.
+    auto ref_count = asset->ref_count;
+    switch (asset->type) {
+        case AssetType::Model: {
+            auto old_model_id = asset->model_id;
+            asset->model_id = ModelID::Invalid;
+            asset->ref_count = 0;
+            if (!self.load_model(uuid)) {
+                asset = self.get_asset(uuid);
+                asset->model_id = old_model_id;
+                asset->ref_count = ref_count;
+                // Old contents are still there
+                self.set_load_state(uuid, AssetLoadState::Resident, 1.0f);
+                return false;
+            }
+
+            // Old slot takes new contents right away, they must be on GPU.
+            device.transfer_man().wait_uploads();
+
+            asset = self.get_asset(uuid);
+            auto new_model_id = asset->model_id;
+            std::swap(*self.models.slot(old_model_id), *self.models.slot(new_model_id));
+
+            auto *stale_model = self.models.slot(new_model_id);
+            for (const auto &material_uuid : stale_model->materials) {
+                self.unload_material(material_uuid);
+            }
+
+            self.release_mesh_buffers(*stale_model);
+
+            self.models.destroy_slot(new_model_id);
+            asset->model_id = old_model_id;
+            asset->ref_count = ref_count;
+
+            self.set_models_dirty();
+        } break;
+        case AssetType::Texture: {
+            // Leaves its shared texture first, otherwise load would find
+            // itself there. Others sharing it keep old contents.
+            auto old_texture_id = asset->texture_id;
+            auto old_content_hash = asset->content_hash;
+            {
+                auto write_lock = std::unique_lock(self.textures_mutex);
+                asset->texture_id = TextureID::Invalid;
+                asset->content_hash = 0;
+                asset->ref_count = 0;
+            }
+
+            auto is_old_texture_unused = self.release_shared_texture(uuid, old_content_hash);
+
+            if (!self.load_texture(uuid)) {
+                auto write_lock = std::unique_lock(self.textures_mutex);
+                asset = self.get_asset(uuid);
+                asset->texture_id = old_texture_id;
+                asset->content_hash = old_content_hash;
+                asset->ref_count = ref_count;
+                // Old contents are still there, not streamed anymore if
+                // nothing else shared them.
+                if (old_content_hash != 0) {
+                    auto &shared_texture = self.shared_textures[old_content_hash];
+                    shared_texture.texture_id = old_texture_id;
+                    shared_texture.uuids.push_back(uuid);
+                }
+
+                self.set_load_state(uuid, AssetLoadState::Resident, 1.0f);
+                return false;
+            }
+
+            device.transfer_man().wait_uploads();
+
+            {
+                auto write_lock = std::unique_lock(self.textures_mutex);
+                if (is_old_texture_unused) {
+                    auto *stale_texture = self.textures.slot(old_texture_id);
+                    device.destroy(stale_texture->image_view.id());
+                    device.destroy(stale_texture->image.id());
+                    device.destroy(stale_texture->sampler.id());
+                    self.textures.destroy_slot(old_texture_id);
+                }
+
+                asset = self.get_asset(uuid);
+                asset->ref_count = ref_count;
+            }
+
+            // Materials store bindless image indices, they are changed now.
+            self.set_texture_materials_dirty(uuid);
+        } break;
+        case AssetType::Scene: {
+            auto old_scene_id = asset->scene_id;
+            asset->scene_id = SceneID::Invalid;
+            asset->ref_count = 0;
+
+            // Import new scene before destroying old one, shared assets
+            // would otherwise hit zero refs and get unloaded in between.
+            if (!self.load_scene(uuid)) {
+                asset = self.get_asset(uuid);
+                asset->scene_id = old_scene_id;
+                asset->ref_count = ref_count;
+                // Old contents are still there
+                self.set_load_state(uuid, AssetLoadState::Resident, 1.0f);
+                return false;
+            }
+
+            asset = self.get_asset(uuid);
+            auto new_scene_id = asset->scene_id;
+            std::swap(*self.scenes.slot(old_scene_id), *self.scenes.slot(new_scene_id));
+
+            auto *stale_scene = self.get_scene(new_scene_id);
+            stale_scene->destroy();
+            self.scenes.destroy_slot(new_scene_id);
+            asset->scene_id = old_scene_id;
+            asset->ref_count = ref_count;
+        } break;
+        default: {
+            return false;
+        }
+    }
+
+    LOG_TRACE("Reloaded asset {}.", uuid.str());
+
+    return true;
+}
+
+auto AssetManager::find_asset(this AssetManager &self, const fs::path &path, AssetType type) -> UUID {
+    ZoneScoped;
+
+    // Embedded assets share the path of their parent, so type is required.
+    auto read_lock = std::shared_lock(self.registry_mutex);
+    auto it = self.asset_paths.find(ls::pair(path, type));
+    if (it == self.asset_paths.end()) {
+        return UUID(nullptr);
+    }
+
+    return it->second;
+}
+
 auto AssetManager::get_asset(this AssetManager &self, const UUID &uuid) -> Asset * {
     ZoneScoped;
 
@@ -1664,6 +3995,56 @@ auto AssetManager::set_material_dirty(this AssetManager &self, MaterialID materi
     self.dirty_materials.emplace_back(material_id);
 }
 
+auto AssetManager::set_models_dirty(this AssetManager &self) -> void {
+    ZoneScoped;
+
+    for (auto &scene : self.scenes.slots_unsafe()) {
+        if (scene) {
+            scene->models_dirty = true;
+        }
+    }
+}
+
+auto AssetManager::set_texture_materials_dirty(this AssetManager &self, const UUID &uuid) -> void {
+    ZoneScoped;
+
+    // Materials refer to every asset sharing the texture by its own UUID.
+    auto texture_uuids = std::vector<UUID>{ uuid };
+    {
+        auto read_lock = std::shared_lock(self.textures_mutex);
+        auto *asset = self.get_asset(uuid);
+        auto shared_texture_it = asset ? self.shared_textures.find(asset->content_hash) : self.shared_textures.end();
+        if (shared_texture_it != self.shared_textures.end() && !shared_texture_it->second.uuids.empty()) {
+            texture_uuids = shared_texture_it->second.uuids;
+        }
+    }
+
+    auto uses_texture = [&](const UUID &texture_uuid) {
+        return std::ranges::find(texture_uuids, texture_uuid) != texture_uuids.end();
+    };
+
+    auto dirty_material_ids = std::vector<MaterialID>();
+    {
+        auto read_lock = std::shared_lock(self.registry_mutex);
+        for (const auto &[material_uuid, material_asset] : self.registry) {
+            if (material_asset.type != AssetType::Material || !material_asset.is_loaded()) {
+                continue;
+            }
+
+            auto *material = self.materials.slot(material_asset.material_id);
+            if (uses_texture(material->albedo_texture) || uses_texture(material->normal_texture) || uses_texture(material->emissive_texture) ||
+                uses_texture(material->metallic_roughness_texture) || uses_texture(material->occlusion_texture))
+            {
+                dirty_material_ids.push_back(material_asset.material_id);
+            }
+        }
+    }
+
+    for (auto material_id : dirty_material_ids) {
+        self.set_material_dirty(material_id);
+    }
+}
+
 auto AssetManager::get_dirty_material_ids(this AssetManager &self) -> std::vector<MaterialID> {
     ZoneScoped;
 
@@ -1,18 +1,43 @@
 #pragma once
 
+#include "Engine/Asset/AssetCache.hh"
 #include "Engine/Asset/AssetFile.hh"
+#include "Engine/Asset/AssetPack.hh"
+#include "Engine/Asset/DerivedDataCache.hh"
+#include "Engine/Asset/MeshStreamer.hh"
 #include "Engine/Asset/Model.hh"
+#include "Engine/Asset/RegistrySnapshot.hh"
+#include "Engine/Asset/TextureFile.hh"
+#include "Engine/Asset/TextureStreamer.hh"
 #include "Engine/Asset/UUID.hh"
 
+#include "Engine/Core/Arc.hh"
+
+#include "Engine/OS/FileWatcher.hh"
+
 #include "Engine/Util/JsonWriter.hh"
 
 #include "Engine/Scene/Scene.hh"
 
 namespace lr {
+// Only moves forward, except for `Failed` which can happen at any point.
+enum class AssetLoadState : u32 {
+    None = 0,
+    Queued,
+    Loading,
+    Uploading,
+    Resident,
+    Failed,
+};
+
 struct Asset {
     UUID uuid = {};
     fs::path path = {};
     AssetType type = AssetType::None;
+    // Index of the pack it's loaded from, set once by `mount_pack`.
+    ls::option<u32> pack_index = ls::nullopt;
+    // Assets its meta file refers to, embedded textures and materials of models.
+    std::vector<UUID> dependencies = {};
     union {
         ModelID model_id = ModelID::Invalid;
         TextureID texture_id;
@@ -20,13 +45,28 @@ struct Asset {
         SceneID scene_id;
     };
 
-    // Reference count of loads
+    // Reference count of loads, loaded ones without any are cached. See
+    // `AssetCache`.
     u64 ref_count = 0;
+    // Textures, source bytes and parameters they are loaded with. Assets
+    // with the same one share a GPU texture, see `SharedTexture`.
+    u64 content_hash = 0;
+    // Written by loading threads, use `get_load_state`.
+    AssetLoadState load_state = AssetLoadState::None;
 
     auto is_loaded() const -> bool {
         return model_id != ModelID::Invalid;
     }
 
+    // Loaded and every GPU resource of it is ready to use.
+    auto is_resident() const -> bool {
+        return get_load_state() == AssetLoadState::Resident;
+    }
+
+    auto get_load_state() const -> AssetLoadState {
+        return std::atomic_ref(const_cast<AssetLoadState &>(load_state)).load();
+    }
+
     auto acquire_ref() -> void {
         ++std::atomic_ref(ref_count);
     }
@@ -36,18 +76,75 @@ struct Asset {
     }
 };
 
+using AssetLoadCallback = std::function<void(const UUID &uuid, AssetLoadState state)>;
+
+// Shared between whoever asked for the load and the job doing it.
+// Callbacks run on the thread that calls `AssetManager::poll_loads`,
+// usually the main thread, so they are free to touch scenes and UI.
+struct AssetLoadRequest : ManagedObj {
+    UUID uuid = {};
+    std::atomic<AssetLoadState> state = AssetLoadState::Queued;
+    // 0 to 1, rough estimate of how far along the current load is.
+    std::atomic<f32> progress = 0.0f;
+
+    std::mutex callbacks_mutex = {};
+    std::vector<AssetLoadCallback> callbacks = {};
+    bool callbacks_dispatched = false;
+
+    // Either resident or failed.
+    auto is_done(this AssetLoadRequest &) -> bool;
+    // Blocks until `is_done`, don't call from loading jobs.
+    auto wait(this AssetLoadRequest &) -> void;
+    // Runs immediately when request is already dispatched.
+    auto on_complete(this AssetLoadRequest &, AssetLoadCallback callback) -> void;
+};
+using AssetLoadHandle = Arc<AssetLoadRequest>;
+
+// Same image loaded the same way by several texture assets, usually
+// models that embed the same file. Every one of them keeps its UUID,
+// their `texture_id` is the same slot.
+struct SharedTexture {
+    TextureID texture_id = TextureID::Invalid;
+    u64 upload_value = 0;
+    // Each asset once. First one loads the texture and is the one
+    // `TextureStreamer` knows it by. Ones after it that came while it was
+    // loading get `texture_id` when it is done.
+    std::vector<UUID> uuids = {};
+};
+
+// Cooked primitives with the same payload, models that instance the same
+// mesh or import the same file. Vertex data and resident LODs live in one
+// buffer, streamed finer LODs in one each.
+struct SharedMeshBuffer {
+    Buffer buffer = {};
+    u64 upload_value = 0;
+    u64 ref_count = 0;
+};
+
 using AssetRegistry = ankerl::unordered_dense::map<UUID, Asset>;
 struct AssetManager {
     constexpr static auto MODULE_NAME = "Asset Manager";
 
     fs::path root_path = fs::current_path();
     AssetRegistry registry = {};
+    // Guarded by `registry_mutex`, see `find_asset`. Embedded assets share
+    // the path of their parent, first one registered is the one found.
+    ankerl::unordered_dense::map<ls::pair<fs::path, AssetType>, UUID> asset_paths = {};
 
     std::shared_mutex registry_mutex = {};
+    // Loads take references of loaded models under it, eviction checks
+    // them again under it before freeing.
+    std::shared_mutex models_mutex = {};
     SlotMap<Model, ModelID> models = {};
 
     std::shared_mutex textures_mutex = {};
     SlotMap<Texture, TextureID> textures = {};
+    // Keyed by `Asset::content_hash`, guarded by `textures_mutex`.
+    ankerl::unordered_dense::map<u64, SharedTexture> shared_textures = {};
+
+    std::mutex mesh_buffers_mutex = {};
+    // Keyed by `Model::gpu_mesh_buffer_hashes` and `Model::gpu_lod_buffer_hashes`.
+    ankerl::unordered_dense::map<u64, SharedMeshBuffer> shared_mesh_buffers = {};
 
     std::shared_mutex materials_mutex = {};
     SlotMap<Material, MaterialID> materials = {};
@@ -55,11 +152,41 @@ struct AssetManager {
 
     SlotMap<std::unique_ptr<Scene>, SceneID> scenes = {};
 
+    FileWatcher file_watcher = {};
+
+    std::mutex load_requests_mutex = {};
+    // In flight loads and finished ones waiting for `poll_loads`.
+    ankerl::unordered_dense::map<UUID, AssetLoadHandle> load_requests = {};
+    // Finished requests a new load of the same asset took the place of.
+    std::vector<AssetLoadHandle> replaced_load_requests = {};
+    // Bumped every time an asset becomes resident.
+    std::atomic<u64> resident_generation = 0;
+
+    DerivedDataCache derived_data_cache = {};
+    // Read only after mounting, mount before anything starts loading.
+    std::vector<AssetPack> packs = {};
+
+    // Project `import_project` was last called with.
+    fs::path registry_snapshot_root = {};
+    RegistrySnapshot registry_snapshot = {};
+    std::mutex cook_mutex = {};
+    ankerl::unordered_dense::set<fs::path> cooking_textures = {};
+    // Project setting, editor persists it in the project file. KTX2 cooked
+    // textures don't stream, they are transcoded for the device on every
+    // load instead.
+    TextureCookFormat texture_cook_format = TextureCookFormat::BC7;
+
+    TextureStreamer texture_streamer = {};
+    MeshStreamer mesh_streamer = {};
+    AssetCache asset_cache = {};
+
     auto init(this AssetManager &) -> bool;
     auto destroy(this AssetManager &) -> void;
 
     auto asset_root_path(this AssetManager &, AssetType type) -> fs::path;
     auto to_asset_file_type(this AssetManager &, const fs::path &path) -> AssetFileType;
+    // Type of asset a source file is registered as, `None` for meta files.
+    auto to_asset_type(this AssetManager &, AssetFileType file_type) -> AssetType;
     auto to_asset_type_sv(this AssetManager &, AssetType type) -> std::string_view;
     auto get_registry(this AssetManager &) -> const AssetRegistry &;
 
@@ -75,9 +202,33 @@ struct AssetManager {
     // If a valid meta file exists in the same path as importing asset, this
     // function will act like `register_asset`. Otherwise this function will
     // act like `create_asset` which creates new unique handle to asset with
-    // meta file in the same path.
-    auto import_asset(this AssetManager &, const fs::path &path) -> UUID;
+    // meta file in the same path. `texture_info` is the material slot a
+    // new PNG/JPEG texture is imported for, it gets cooked for it right
+    // away. Without it, texture is cooked on its first load.
+    auto import_asset(this AssetManager &, const fs::path &path, ls::option<TextureInfo> texture_info = ls::nullopt) -> UUID;
+    // Only directories that changed since last import are listed again,
+    // see `RegistrySnapshot`.
     auto import_project(this AssetManager &, const fs::path &path) -> void;
+    // Also stores source hashes computed since last import. Called on
+    // `import_project` and `destroy`.
+    auto save_registry_snapshot(this AssetManager &) -> bool;
+    // Moves derived data cache into `<path>/.cache`, cooked assets then
+    // stay with the project.
+    auto open_project_cache(this AssetManager &, const fs::path &path) -> bool;
+    // Registers every asset of the pack as if it was imported from
+    // `project_path`. Assets registered from loose files are loaded from
+    // the pack from now on, ones of an earlier pack stay with it. Mount
+    // after `import_project` and before anything loads.
+    auto mount_pack(this AssetManager &, const fs::path &project_path, const fs::path &pack_path) -> bool;
+    // Imports the project and writes every model, texture and scene of it
+    // into a single `AssetPack`. Models and PNG/JPEG textures are packed
+    // cooked, they get cooked here when derived data cache doesn't have them.
+    // Textures are cooked for the material slots that bind them, ones bound
+    // nowhere or in different ways are packed as source.
+    auto pack_project(this AssetManager &, const fs::path &project_path, const fs::path &pack_path) -> bool;
+    // Cooks PNG/JPEG texture into `texture_cook_format` in background,
+    // unless derived data cache already has it.
+    auto cook_texture(this AssetManager &, const fs::path &path, bool normal = false, f32 alpha_cutoff = 0.0f) -> void;
 
     //  ── Registered Assets ───────────────────────────────────────────────
     // Assets that already exist in project root and have meta file with
@@ -92,14 +243,42 @@ struct AssetManager {
     // Load contents of registered assets.
     //
     auto load_asset(this AssetManager &, const UUID &uuid) -> bool;
+    // Models and textures without references left go into `asset_cache`,
+    // they are freed once it evicts them.
     auto unload_asset(this AssetManager &, const UUID &uuid) -> bool;
+    // Frees assets `asset_cache` evicted, ones loaded again since are kept.
+    auto evict_assets(this AssetManager &, const std::vector<UUID> &uuids) -> void;
+    // Cached assets that don't fit anymore are evicted right away.
+    auto set_cache_budgets(this AssetManager &, u64 cpu_budget, u64 gpu_budget) -> void;
+
+    // Same as `load_asset` but in a job, caller never blocks. Asking for
+    // an asset that is already loading returns the same request, every
+    // call still holds its own reference.
+    auto load_asset_async(this AssetManager &, const UUID &uuid, AssetLoadCallback callback = {}) -> AssetLoadHandle;
+    // Dispatches callbacks of finished loads, call once per frame.
+    auto poll_loads(this AssetManager &) -> void;
+    auto get_load_state(this AssetManager &, const UUID &uuid) -> AssetLoadState;
+    auto set_load_state(this AssetManager &, const UUID &uuid, AssetLoadState state, f32 progress) -> void;
+    // Asset stays `Uploading` until transfer manager completes `upload_value`,
+    // loading threads don't wait for GPU.
+    auto finish_upload(this AssetManager &, const UUID &uuid, u64 upload_value) -> void;
 
     auto load_model(this AssetManager &, const UUID &uuid) -> bool;
     auto unload_model(this AssetManager &, const UUID &uuid) -> bool;
+    // Does nothing when model got referenced again since it was evicted.
+    auto free_model(this AssetManager &, const UUID &uuid) -> void;
+    // Destroys mesh and streamed LOD buffers of `model` that no other model shares.
+    auto release_mesh_buffers(this AssetManager &, Model &model) -> void;
 
     auto load_texture(this AssetManager &, const UUID &uuid, const TextureInfo &info = {}) -> bool;
     auto unload_texture(this AssetManager &, const UUID &uuid) -> bool;
+    auto free_texture(this AssetManager &, const UUID &uuid) -> void;
     auto is_texture_loaded(this AssetManager &, const UUID &uuid) -> bool;
+    // Drops `uuid` from its `SharedTexture`, true when it was the last one
+    // and GPU texture has to be destroyed. Locks `textures_mutex`.
+    auto release_shared_texture(this AssetManager &, const UUID &uuid, u64 content_hash) -> bool;
+    // UUID `TextureStreamer` streams texture `uuid` under.
+    auto get_texture_stream_uuid(this AssetManager &, const UUID &uuid) -> UUID;
 
     auto load_material(this AssetManager &, const UUID &uuid, const MaterialInfo &info) -> bool;
     auto unload_material(this AssetManager &, const UUID &uuid) -> bool;
@@ -120,6 +299,18 @@ struct AssetManager {
 
     auto delete_asset(this AssetManager &, const UUID &uuid) -> void;
 
+    //  ── Hot Reload ──────────────────────────────────────────────────────
+    // Changes under watched root are polled once per frame. Loaded assets
+    // whose source file changed are reimported and swapped into their
+    // existing slots, IDs held by scenes and materials stay valid. Textures
+    // can share slots, they get a new one, materials refer to them by UUID.
+    // New files get imported, everything else is left untouched.
+    //
+    auto watch_project(this AssetManager &, const fs::path &path) -> bool;
+    auto poll_file_changes(this AssetManager &) -> std::vector<FileEvent>;
+    auto reload_asset(this AssetManager &, const UUID &uuid) -> bool;
+    auto find_asset(this AssetManager &, const fs::path &path, AssetType type) -> UUID;
+
     auto get_asset(this AssetManager &, const UUID &uuid) -> Asset *;
     auto get_model(this AssetManager &, const UUID &uuid) -> Model *;
     auto get_model(this AssetManager &, ModelID model_id) -> Model *;
@@ -130,7 +321,12 @@ struct AssetManager {
     auto get_scene(this AssetManager &, const UUID &uuid) -> Scene *;
     auto get_scene(this AssetManager &, SceneID scene_id) -> Scene *;
 
+    // GPU meshes are copied into scenes, they have to be rebuilt when models change.
+    auto set_models_dirty(this AssetManager &) -> void;
     auto set_material_dirty(this AssetManager &, MaterialID material_id) -> void;
+    // Every loaded material that uses texture `uuid` or one sharing its GPU
+    // texture, their bindless indices changed.
+    auto set_texture_materials_dirty(this AssetManager &, const UUID &uuid) -> void;
     auto get_dirty_material_ids(this AssetManager &) -> std::vector<MaterialID>;
 };
 } // namespace lr
@@ -0,0 +1,115 @@
+#include "Engine/Asset/AssetCache.hh"
+
+namespace lr {
+auto AssetCache::insert(this AssetCache &self, const UUID &uuid, u64 cpu_size, u64 gpu_size) -> std::vector<UUID> {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    auto [asset_it, inserted] = self.assets.try_emplace(uuid);
+    auto &asset = asset_it->second;
+    if (!inserted) {
+        self.cpu_size -= asset.cpu_size;
+        self.gpu_size -= asset.gpu_size;
+    }
+
+    asset = { .cpu_size = cpu_size, .gpu_size = gpu_size, .release_index = self.release_counter++ };
+    self.cpu_size += cpu_size;
+    self.gpu_size += gpu_size;
+
+    return self.evict();
+}
+
+auto AssetCache::take(this AssetCache &self, const UUID &uuid) -> bool {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    if (!self.erase(uuid)) {
+        return false;
+    }
+
+    self.hit_count++;
+
+    return true;
+}
+
+auto AssetCache::remove(this AssetCache &self, const UUID &uuid) -> bool {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    return self.erase(uuid);
+}
+
+auto AssetCache::record_miss(this AssetCache &self) -> void {
+    auto lock = std::unique_lock(self.mutex);
+    self.miss_count++;
+}
+
+auto AssetCache::set_budgets(this AssetCache &self, u64 cpu_budget, u64 gpu_budget) -> std::vector<UUID> {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    self.cpu_budget = cpu_budget;
+    self.gpu_budget = gpu_budget;
+
+    return self.evict();
+}
+
+auto AssetCache::stats(this AssetCache &self) -> AssetCacheStats {
+    auto lock = std::unique_lock(self.mutex);
+    return {
+        .cpu_budget = self.cpu_budget,
+        .gpu_budget = self.gpu_budget,
+        .cpu_size = self.cpu_size,
+        .gpu_size = self.gpu_size,
+        .cached_count = static_cast<u32>(self.assets.size()),
+        .hit_count = self.hit_count,
+        .miss_count = self.miss_count,
+        .eviction_count = self.eviction_count,
+    };
+}
+
+auto AssetCache::erase(this AssetCache &self, const UUID &uuid) -> bool {
+    auto asset_it = self.assets.find(uuid);
+    if (asset_it == self.assets.end()) {
+        return false;
+    }
+
+    self.cpu_size -= asset_it->second.cpu_size;
+    self.gpu_size -= asset_it->second.gpu_size;
+    self.assets.erase(asset_it);
+
+    return true;
+}
+
+auto AssetCache::evict(this AssetCache &self) -> std::vector<UUID> {
+    ZoneScoped;
+
+    auto is_over_budget = [&]() {
+        return self.cpu_size > self.cpu_budget || self.gpu_size > self.gpu_budget;
+    };
+
+    auto evicted_uuids = std::vector<UUID>();
+    if (!is_over_budget()) {
+        return evicted_uuids;
+    }
+
+    auto candidates = std::vector<ls::pair<u64, UUID>>();
+    candidates.reserve(self.assets.size());
+    for (const auto &[uuid, asset] : self.assets) {
+        candidates.emplace_back(asset.release_index, uuid);
+    }
+
+    std::ranges::sort(candidates, {}, &ls::pair<u64, UUID>::n0);
+    for (const auto &[release_index, uuid] : candidates) {
+        if (!is_over_budget()) {
+            break;
+        }
+
+        self.erase(uuid);
+        self.eviction_count++;
+        evicted_uuids.push_back(uuid);
+    }
+
+    return evicted_uuids;
+}
+} // namespace lr
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Engine/Asset/UUID.hh"
+
+namespace lr {
+struct AssetCacheStats {
+    u64 cpu_budget = 0;
+    u64 gpu_budget = 0;
+    u64 cpu_size = 0;
+    u64 gpu_size = 0;
+    u32 cached_count = 0;
+    // Loads that took a cached asset back
+    u64 hit_count = 0;
+    // Loads that started from scratch
+    u64 miss_count = 0;
+    u64 eviction_count = 0;
+};
+
+// Models and textures that lost their last reference stay loaded here,
+// loading them again takes them back as they are. Switching back and forth
+// between scenes doesn't reload everything they share. Once CPU or GPU
+// budget is exceeded, assets released longest ago are evicted first.
+//
+// Only bookkeeping lives here, `AssetManager` frees what gets evicted.
+// Budgets of 0 disable caching.
+struct AssetCache {
+    constexpr static u64 DEFAULT_CPU_BUDGET = 256_u64 * 1024 * 1024;
+    constexpr static u64 DEFAULT_GPU_BUDGET = 1_u64 * 1024 * 1024 * 1024;
+
+    struct CachedAsset {
+        u64 cpu_size = 0;
+        u64 gpu_size = 0;
+        // Lowest one is evicted first.
+        u64 release_index = 0;
+    };
+
+    u64 cpu_budget = DEFAULT_CPU_BUDGET;
+    u64 gpu_budget = DEFAULT_GPU_BUDGET;
+
+    std::mutex mutex = {};
+    ankerl::unordered_dense::map<UUID, CachedAsset> assets = {};
+    u64 release_counter = 0;
+    u64 cpu_size = 0;
+    u64 gpu_size = 0;
+    u64 hit_count = 0;
+    u64 miss_count = 0;
+    u64 eviction_count = 0;
+
+    // Asset has no references left. Returns assets evicted to make room,
+    // `uuid` itself when it doesn't fit at all.
+    auto insert(this AssetCache &, const UUID &uuid, u64 cpu_size, u64 gpu_size) -> std::vector<UUID>;
+    // Asset is referenced again, true when it was cached.
+    auto take(this AssetCache &, const UUID &uuid) -> bool;
+    // Same as `take` without counting a hit, for assets going away.
+    auto remove(this AssetCache &, const UUID &uuid) -> bool;
+    auto record_miss(this AssetCache &) -> void;
+    // Returns assets evicted to fit new budgets.
+    auto set_budgets(this AssetCache &, u64 cpu_budget, u64 gpu_budget) -> std::vector<UUID>;
+    auto stats(this AssetCache &) -> AssetCacheStats;
+
+private:
+    // Caller holds `mutex` for both.
+    auto erase(this AssetCache &, const UUID &uuid) -> bool;
+    auto evict(this AssetCache &) -> std::vector<UUID>;
+};
+} // namespace lr
@@ -0,0 +1,18 @@
+#include "Engine/Asset/AssetFile.hh"
+
+namespace lr {
+auto is_asset_file_header_valid(ls::span<u8> file_data, AssetType type, u16 version) -> bool {
+    ZoneScoped;
+
+    if (file_data.size() < sizeof(AssetFileHeader)) {
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const AssetFileHeader *>(file_data.data());
+    if (std::memcmp(header->magic, AssetFileHeader{}.magic, sizeof(header->magic)) != 0 || header->type != type) {
+        return false;
+    }
+
+    return header->version == version;
+}
+} // namespace lr
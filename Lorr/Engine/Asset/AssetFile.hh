@@ -33,9 +33,29 @@ enum class AssetFileFlags : u64 {
 };
 consteval void enable_bitmask(AssetFileFlags);
 
+// Offsets are from the beginning of the data, see `TextureFile`.
 struct TextureAssetFileHeader {
     vuk::Extent3D extent = {};
     vuk::Format format = vuk::Format::eUndefined;
+    u32 mip_level_count = 0;
+    u64 levels_offset = 0;
+};
+
+// Offsets are from the beginning of the data, see `ModelFile`.
+struct ModelAssetFileHeader {
+    u32 primitive_count = 0;
+    u32 mesh_count = 0;
+    u32 node_count = 0;
+    u32 scene_count = 0;
+    u32 material_count = 0;
+    u32 default_scene_index = 0;
+    u64 primitives_offset = 0;
+    u64 meshes_offset = 0;
+    u64 nodes_offset = 0;
+    u64 scenes_offset = 0;
+    u64 materials_offset = 0;
+    u64 indices_offset = 0;
+    u64 strings_offset = 0;
 };
 
 struct AssetFileHeader {
@@ -45,7 +65,28 @@ struct AssetFileHeader {
     AssetType type = AssetType::None;
     union {
         TextureAssetFileHeader texture_header = {};
+        ModelAssetFileHeader model_header;
     };
 };
 
+// Sections of cooked files are aligned to this.
+constexpr static auto ASSET_FILE_ALIGNMENT = 16_u64;
+constexpr auto align_asset_file_offset(u64 offset) -> u64 {
+    return (offset + ASSET_FILE_ALIGNMENT - 1) & ~(ASSET_FILE_ALIGNMENT - 1);
+}
+
+// Bounds checked view of `count` elements at `offset` of a cooked file.
+template<typename T>
+auto get_asset_file_section(ls::span<u8> file_data, u64 offset, u64 count) -> ls::option<ls::span<T>> {
+    if (offset > file_data.size() || count > (file_data.size() - offset) / sizeof(T)) {
+        return ls::nullopt;
+    }
+
+    return ls::span<T>(reinterpret_cast<T *>(file_data.data() + offset), count);
+}
+
+// Staleness is handled by `DerivedDataCache` keys, this only guards
+// against reading something that isn't a cooked file of `type`.
+auto is_asset_file_header_valid(ls::span<u8> file_data, AssetType type, u16 version) -> bool;
+
 } // namespace lr
@@ -0,0 +1,277 @@
+#include "Engine/Asset/AssetPack.hh"
+
+#include "Engine/Memory/Compression.hh"
+
+#include <xxhash.h>
+
+namespace lr {
+static auto hash_uuid(const std::array<u8, 16> &uuid_bytes) -> u64 {
+    return XXH3_64bits(uuid_bytes.data(), uuid_bytes.size());
+}
+
+static auto align_chunk_offset(u64 offset) -> u64 {
+    return (offset + AssetPack::CHUNK_ALIGNMENT - 1) & ~(AssetPack::CHUNK_ALIGNMENT - 1);
+}
+
+auto AssetPack::open(const fs::path &path) -> ls::option<AssetPack> {
+    ZoneScoped;
+
+    auto pack = AssetPack{};
+    pack.path = path;
+    pack.mapped = MappedFile(path);
+    auto file_data = pack.mapped.data;
+    if (!pack.mapped || file_data.size() < sizeof(AssetPackHeader)) {
+        LOG_ERROR("Failed to open asset pack '{}'!", path);
+        return ls::nullopt;
+    }
+
+    const auto *header = reinterpret_cast<const AssetPackHeader *>(file_data.data());
+    if (std::memcmp(header->magic, AssetPackHeader{}.magic, sizeof(header->magic)) != 0 || header->version != VERSION) {
+        LOG_ERROR("'{}' is not an asset pack of version {}.", path, VERSION);
+        return ls::nullopt;
+    }
+
+    auto slots = get_asset_file_section<AssetPackEntry>(file_data, header->slots_offset, header->slot_count);
+    auto strings = get_asset_file_section<c8>(file_data, header->strings_offset, header->strings_size);
+    if (!slots.has_value() || !strings.has_value() || !std::has_single_bit(header->slot_count)) {
+        LOG_ERROR("Asset pack '{}' is corrupt!", path);
+        return ls::nullopt;
+    }
+
+    pack.slots = slots.value();
+    pack.strings = std::string_view(strings->data(), strings->size());
+    pack.entry_count = header->entry_count;
+    pack.texture_cook_format = header->texture_cook_format;
+
+    return pack;
+}
+
+auto AssetPack::write(const fs::path &path, ls::span<AssetPackSource> sources, TextureCookFormat texture_cook_format) -> bool {
+    ZoneScoped;
+
+    // At most half full, misses end at an empty slot quickly.
+    auto slot_count = std::bit_ceil(ls::max(static_cast<u32>(sources.size()) * 2, 1_u32));
+    auto slots = std::vector<AssetPackEntry>(slot_count);
+    auto strings = std::string();
+    auto entry_count = 0_u32;
+    // Slot of every source, duplicates get none.
+    auto source_slot_indices = std::vector<ls::option<u64>>(sources.size());
+
+    for (const auto &[source, source_slot_index] : std::views::zip(sources, source_slot_indices)) {
+        const auto &uuid_bytes = source.uuid.bytes();
+        auto slot_index = hash_uuid(uuid_bytes) & (slot_count - 1);
+        while (slots[slot_index].type != AssetType::None) {
+            if (std::memcmp(slots[slot_index].uuid, uuid_bytes.data(), uuid_bytes.size()) == 0) {
+                break;
+            }
+
+            slot_index = (slot_index + 1) & (slot_count - 1);
+        }
+
+        auto &entry = slots[slot_index];
+        if (entry.type != AssetType::None) {
+            LOG_WARN("Asset {} is packed twice, '{}' is skipped.", source.uuid.str(), source.path);
+            continue;
+        }
+
+        source_slot_index = slot_index;
+        std::memcpy(entry.uuid, uuid_bytes.data(), uuid_bytes.size());
+        entry.type = source.type;
+        entry.data_type = source.data_type;
+        entry.params_hash = source.params_hash;
+        entry.path_offset = static_cast<u32>(strings.size());
+        entry.path_length = static_cast<u32>(source.path.size());
+        strings += source.path;
+        entry_count++;
+    }
+
+    auto header = AssetPackHeader{
+        .entry_count = entry_count,
+        .slot_count = slot_count,
+        .texture_cook_format = texture_cook_format,
+    };
+    header.slots_offset = align_asset_file_offset(sizeof(AssetPackHeader));
+    header.strings_offset = align_asset_file_offset(header.slots_offset + slot_count * sizeof(AssetPackEntry));
+    header.strings_size = strings.size();
+
+    // Written next to the old pack and renamed over it once complete.
+    auto temp_path = path;
+    temp_path += ".tmp";
+    File file(temp_path, FileAccess::Write);
+    if (!file) {
+        LOG_ERROR("Failed to open file '{}' for writing!", temp_path);
+        return false;
+    }
+
+    auto file_offset = 0_u64;
+    auto padding = std::vector<u8>(CHUNK_ALIGNMENT, 0);
+    auto write_padding = [&](u64 aligned_offset) {
+        while (file_offset < aligned_offset) {
+            auto size = ls::min(aligned_offset - file_offset, CHUNK_ALIGNMENT);
+            auto written_size = file.write(padding.data(), size);
+            if (written_size == 0) {
+                return false;
+            }
+
+            file_offset += written_size;
+        }
+
+        return true;
+    };
+
+    // Table is written last, chunk offsets aren't known until then.
+    if (!write_padding(align_chunk_offset(header.strings_offset + header.strings_size))) {
+        LOG_ERROR("Failed to write asset pack '{}'!", temp_path);
+        return false;
+    }
+
+    auto total_size = 0_u64;
+    auto write_chunk = [&](AssetPackChunk &chunk, ls::span<u8> data) -> bool {
+        chunk.offset = file_offset;
+        chunk.size = data.size();
+
+        auto compressed_data = std::vector<u8>();
+        if (!data.empty()) {
+            auto compressor = CompressorLZ4();
+            compressed_data = compressor.compress(data.data(), data.size());
+        }
+
+        // Same rule as derived data, block compressed data is kept as is.
+        auto stored_data = data;
+        if (!compressed_data.empty() && compressed_data.size() < data.size() - data.size() / 10) {
+            chunk.compression = AssetPackCompression::LZ4;
+            stored_data = ls::span<u8>(compressed_data.data(), compressed_data.size());
+        }
+
+        chunk.stored_size = stored_data.size();
+        total_size += data.size();
+        if (!stored_data.empty() && file.write(stored_data.data(), stored_data.size()) != stored_data.size()) {
+            return false;
+        }
+
+        file_offset += stored_data.size();
+
+        return write_padding(align_chunk_offset(file_offset));
+    };
+
+    for (const auto &[source, source_slot_index] : std::views::zip(sources, source_slot_indices)) {
+        if (!source_slot_index.has_value()) {
+            continue;
+        }
+
+        auto &entry = slots[source_slot_index.value()];
+        if (!write_chunk(entry.meta, source.meta) || !write_chunk(entry.data, source.data)) {
+            LOG_ERROR("Failed to write asset pack '{}'!", temp_path);
+            return false;
+        }
+    }
+
+    auto write_at = [&](u64 offset, const void *data, u64 size) {
+        file.seek(static_cast<i64>(offset));
+        return size == 0 || file.write(data, size) == size;
+    };
+
+    auto table_written = write_at(0, &header, sizeof(AssetPackHeader))
+        && write_at(header.slots_offset, slots.data(), slots.size() * sizeof(AssetPackEntry))
+        && write_at(header.strings_offset, strings.data(), strings.size());
+    if (!table_written) {
+        LOG_ERROR("Failed to write asset pack '{}'!", temp_path);
+        return false;
+    }
+    file.close();
+
+    auto ec = std::error_code{};
+    fs::rename(temp_path, path, ec);
+    if (ec) {
+        LOG_ERROR("Failed to move asset pack to '{}'! {}", path, ec.message());
+        fs::remove(temp_path, ec);
+        return false;
+    }
+
+    LOG_INFO(
+        "Packed {} assets into '{}', {} MiB ({} MiB uncompressed).",
+        entry_count,
+        path,
+        file_offset / (1024 * 1024),
+        total_size / (1024 * 1024)
+    );
+
+    return true;
+}
+
+auto AssetPack::find(this const AssetPack &self, const UUID &uuid) -> const AssetPackEntry * {
+    ZoneScoped;
+
+    if (self.slots.empty()) {
+        return nullptr;
+    }
+
+    const auto &uuid_bytes = uuid.bytes();
+    auto slot_mask = self.slots.size() - 1;
+    auto slot_index = hash_uuid(uuid_bytes) & slot_mask;
+    for (auto probe_count = 0_sz; probe_count < self.slots.size(); probe_count++) {
+        const auto &entry = self.slots[slot_index];
+        if (entry.type == AssetType::None) {
+            return nullptr;
+        }
+
+        if (std::memcmp(entry.uuid, uuid_bytes.data(), uuid_bytes.size()) == 0) {
+            return &entry;
+        }
+
+        slot_index = (slot_index + 1) & slot_mask;
+    }
+
+    return nullptr;
+}
+
+auto AssetPack::entry_uuid(this const AssetPack &, const AssetPackEntry &entry) -> UUID {
+    auto uuid_bytes = std::array<u8, 16>{};
+    std::memcpy(uuid_bytes.data(), entry.uuid, uuid_bytes.size());
+
+    return UUID::from_bytes(uuid_bytes);
+}
+
+auto AssetPack::entry_path(this const AssetPack &self, const AssetPackEntry &entry) -> std::string_view {
+    if (entry.path_offset > self.strings.size() || entry.path_length > self.strings.size() - entry.path_offset) {
+        return {};
+    }
+
+    return self.strings.substr(entry.path_offset, entry.path_length);
+}
+
+auto AssetPack::read(this const AssetPack &self, const AssetPackChunk &chunk) -> ls::option<DerivedData> {
+    ZoneScoped;
+
+    auto stored_data = get_asset_file_section<u8>(self.mapped.data, chunk.offset, chunk.stored_size);
+    if (!stored_data.has_value()) {
+        LOG_ERROR("Chunk at {} of asset pack '{}' is out of bounds!", chunk.offset, self.path);
+        return ls::nullopt;
+    }
+
+    auto derived_data = DerivedData{};
+    switch (chunk.compression) {
+        case AssetPackCompression::None: {
+            if (chunk.size != chunk.stored_size) {
+                return ls::nullopt;
+            }
+
+            derived_data.data = stored_data.value();
+        } break;
+        case AssetPackCompression::LZ4: {
+            derived_data.decompressed.resize(chunk.size);
+            if (!CompressorLZ4::decompress(stored_data->data(), stored_data->size(), derived_data.decompressed.data(), chunk.size)) {
+                LOG_ERROR("Chunk at {} of asset pack '{}' is corrupt!", chunk.offset, self.path);
+                return ls::nullopt;
+            }
+
+            derived_data.data = ls::span<u8>(derived_data.decompressed.data(), derived_data.decompressed.size());
+        } break;
+        default: {
+            return ls::nullopt;
+        }
+    }
+
+    return derived_data;
+}
+} // namespace lr
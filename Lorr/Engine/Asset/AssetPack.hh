@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Engine/Asset/AssetFile.hh"
+#include "Engine/Asset/DerivedDataCache.hh"
+#include "Engine/Asset/TextureFile.hh"
+#include "Engine/Asset/UUID.hh"
+
+namespace lr {
+enum class AssetPackCompression : u32 {
+    None = 0,
+    LZ4,
+};
+
+// What `data` chunk of an entry holds.
+enum class AssetPackDataType : u32 {
+    None = 0,
+    // Source file as is, loaded the same way a loose file would be.
+    Source,
+    // `TextureFile` or `ModelFile`, same thing derived data cache holds.
+    Cooked,
+};
+
+struct AssetPackChunk {
+    u64 offset = 0;
+    u64 size = 0;
+    u64 stored_size = 0;
+    AssetPackCompression compression = AssetPackCompression::None;
+    u32 padding = 0;
+};
+
+// Slot of the table of contents, empty slots have `AssetType::None`.
+struct AssetPackEntry {
+    u8 uuid[16] = {};
+    AssetType type = AssetType::None;
+    AssetPackDataType data_type = AssetPackDataType::None;
+    // Project relative path in string pool
+    u32 path_offset = 0;
+    u32 path_length = 0;
+    // `params_hash` of `Cooked` data, cooked textures are only valid for
+    // the parameters they were cooked with.
+    u64 params_hash = 0;
+    AssetPackChunk meta = {};
+    AssetPackChunk data = {};
+};
+
+// Input of `AssetPack::write`.
+struct AssetPackSource {
+    UUID uuid = {};
+    AssetType type = AssetType::None;
+    AssetPackDataType data_type = AssetPackDataType::None;
+    u64 params_hash = 0;
+    std::string path = {};
+    std::vector<u8> meta = {};
+    std::vector<u8> data = {};
+};
+
+// Whole project in a single file, opening it is one mapping instead of a
+// directory walk and a meta file read per asset.
+//
+// AssetPackHeader
+// AssetPackEntry[slot_count] -- Open addressing, linear probing from XXH3 of UUID
+// c8[]                       -- String pool
+// u8[]                       -- Chunks, each one starts at `CHUNK_ALIGNMENT`
+//
+// Chunks are compressed on their own, ones that don't compress well are
+// stored as is and used straight from the mapping.
+struct AssetPack {
+    constexpr static u16 VERSION = 2;
+    constexpr static auto EXTENSION = std::string_view(".lrpak");
+    constexpr static auto DEFAULT_FILE_NAME = std::string_view("project.lrpak");
+    constexpr static u64 CHUNK_ALIGNMENT = 4096;
+
+    fs::path path = {};
+    MappedFile mapped = {};
+    ls::span<AssetPackEntry> slots = {};
+    std::string_view strings = {};
+    u32 entry_count = 0;
+    TextureCookFormat texture_cook_format = TextureCookFormat::BC7;
+
+    // Returns nullopt when file isn't a pack of current version.
+    static auto open(const fs::path &path) -> ls::option<AssetPack>;
+    static auto write(const fs::path &path, ls::span<AssetPackSource> sources, TextureCookFormat texture_cook_format) -> bool;
+
+    auto find(this const AssetPack &, const UUID &uuid) -> const AssetPackEntry *;
+    auto entry_uuid(this const AssetPack &, const AssetPackEntry &entry) -> UUID;
+    auto entry_path(this const AssetPack &, const AssetPackEntry &entry) -> std::string_view;
+    // Uncompressed chunks point into the mapping, they stay valid as long
+    // as the pack does.
+    auto read(this const AssetPack &, const AssetPackChunk &chunk) -> ls::option<DerivedData>;
+};
+
+// First bytes of an `AssetPack` file.
+struct AssetPackHeader {
+    c8 magic[4] = { 'L', 'P', 'A', 'K' };
+    u16 version = AssetPack::VERSION;
+    u16 padding = 0;
+    u32 entry_count = 0;
+    // Always power of two
+    u32 slot_count = 0;
+    u64 slots_offset = 0;
+    u64 strings_offset = 0;
+    u64 strings_size = 0;
+    // What `Cooked` PNG/JPEG textures are cooked into.
+    TextureCookFormat texture_cook_format = TextureCookFormat::BC7;
+    u32 padding_1 = 0;
+};
+} // namespace lr
@@ -0,0 +1,378 @@
+#include "Engine/Asset/DerivedDataCache.hh"
+
+#include "Engine/Asset/AssetFile.hh"
+
+#include "Engine/Memory/Compression.hh"
+
+#include <xxhash.h>
+
+#include <charconv>
+#include <thread>
+
+namespace lr {
+enum class DerivedDataCompression : u32 {
+    None = 0,
+    LZ4,
+};
+
+struct DerivedDataFileHeader {
+    c8 magic[4] = { 'L', 'D', 'D', 'C' };
+    DerivedDataCompression compression = DerivedDataCompression::None;
+    u64 size = 0;
+    u64 stored_size = 0;
+};
+
+// Data is aligned, uncompressed entries are used straight from mapping.
+constexpr static auto DERIVED_DATA_OFFSET = align_asset_file_offset(sizeof(DerivedDataFileHeader));
+
+auto DerivedDataKey::str() const -> std::string {
+    return fmt::format("{:016x}{:016x}", this->high, this->low);
+}
+
+auto DerivedDataCache::init(this DerivedDataCache &self, const fs::path &root_path, u64 max_size) -> bool {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    self.root_path = root_path;
+    self.max_size = max_size;
+    self.entries.clear();
+    self.source_hashes.clear();
+    self.total_size = 0;
+    self.access_counter = 0;
+
+    auto ec = std::error_code{};
+    fs::create_directories(root_path, ec);
+    if (ec) {
+        LOG_ERROR("Failed to create derived data cache at '{}'! {}", root_path, ec.message());
+        self.root_path.clear();
+        return false;
+    }
+
+    struct ScannedEntry {
+        DerivedDataKey key = {};
+        u64 size = 0;
+        fs::file_time_type time = {};
+    };
+    auto scanned_entries = std::vector<ScannedEntry>();
+    for (const auto &entry : fs::directory_iterator(root_path, ec)) {
+        const auto &path = entry.path();
+        // Leftovers of writes that never finished
+        if (path.extension() == ".tmp") {
+            fs::remove(path, ec);
+            continue;
+        }
+
+        auto stem = path.stem().string();
+        if (path.extension() != EXTENSION || stem.size() != 32) {
+            continue;
+        }
+
+        auto key = DerivedDataKey{};
+        auto high_result = std::from_chars(stem.data(), stem.data() + 16, key.high, 16);
+        auto low_result = std::from_chars(stem.data() + 16, stem.data() + 32, key.low, 16);
+        if (high_result.ec != std::errc{} || low_result.ec != std::errc{}) {
+            continue;
+        }
+
+        auto size = entry.file_size(ec);
+        auto time = entry.last_write_time(ec);
+        if (ec) {
+            continue;
+        }
+
+        scanned_entries.push_back({ .key = key, .size = size, .time = time });
+    }
+
+    // Least recently used first
+    std::ranges::sort(scanned_entries, {}, &ScannedEntry::time);
+    for (const auto &scanned_entry : scanned_entries) {
+        self.entries.emplace(scanned_entry.key, Entry{ .size = scanned_entry.size, .last_access = self.access_counter++ });
+        self.total_size += scanned_entry.size;
+    }
+
+    LOG_INFO("Derived data cache at '{}', {} entries, {} MiB.", root_path, self.entries.size(), self.total_size / (1024 * 1024));
+
+    return true;
+}
+
+auto DerivedDataCache::is_open(this DerivedDataCache &self) -> bool {
+    auto lock = std::unique_lock(self.mutex);
+    return !self.root_path.empty();
+}
+
+auto DerivedDataCache::hash_file(this DerivedDataCache &self, const fs::path &path) -> ls::option<u64> {
+    ZoneScoped;
+
+    auto ec = std::error_code{};
+    auto size = fs::file_size(path, ec);
+    if (ec) {
+        return ls::nullopt;
+    }
+
+    auto time = fs::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) {
+        return ls::nullopt;
+    }
+
+    {
+        auto lock = std::unique_lock(self.mutex);
+        auto it = self.source_hashes.find(path);
+        if (it != self.source_hashes.end() && it->second.size == size && it->second.time == time) {
+            return it->second.hash;
+        }
+    }
+
+    auto hash = XXH3_64bits(nullptr, 0);
+    if (size != 0) {
+        auto mapped = MappedFile(path);
+        if (!mapped) {
+            return ls::nullopt;
+        }
+
+        hash = XXH3_64bits(mapped.data.data(), mapped.data.size());
+    }
+
+    auto lock = std::unique_lock(self.mutex);
+    self.source_hashes.insert_or_assign(path, SourceHash{ .size = size, .time = time, .hash = hash });
+
+    return hash;
+}
+
+auto DerivedDataCache::get_source_hash(this DerivedDataCache &self, const fs::path &path) -> ls::option<SourceHash> {
+    auto lock = std::unique_lock(self.mutex);
+    auto it = self.source_hashes.find(path);
+    if (it == self.source_hashes.end()) {
+        return ls::nullopt;
+    }
+
+    return it->second;
+}
+
+auto DerivedDataCache::set_source_hash(this DerivedDataCache &self, const fs::path &path, const SourceHash &source_hash) -> void {
+    auto lock = std::unique_lock(self.mutex);
+    self.source_hashes.insert_or_assign(path, source_hash);
+}
+
+auto DerivedDataCache::make_key(this DerivedDataCache &, u64 source_hash, u64 params_hash) -> DerivedDataKey {
+    struct {
+        u64 source_hash = 0;
+        u64 params_hash = 0;
+        u32 engine_version = 0;
+        u32 padding = 0;
+    } key_data = { .source_hash = source_hash, .params_hash = params_hash, .engine_version = ENGINE_DERIVED_DATA_VERSION };
+
+    auto hash = XXH3_128bits(&key_data, sizeof(key_data));
+    return { .low = hash.low64, .high = hash.high64 };
+}
+
+auto DerivedDataCache::contains(this DerivedDataCache &self, const DerivedDataKey &key) -> bool {
+    auto lock = std::unique_lock(self.mutex);
+    return self.entries.contains(key);
+}
+
+auto DerivedDataCache::get(this DerivedDataCache &self, const DerivedDataKey &key) -> ls::option<DerivedData> {
+    ZoneScoped;
+
+    auto entry_path = fs::path{};
+    {
+        auto lock = std::unique_lock(self.mutex);
+        auto it = self.entries.find(key);
+        if (it == self.entries.end()) {
+            ++self.miss_count;
+            return ls::nullopt;
+        }
+
+        it->second.last_access = self.access_counter++;
+        entry_path = self.to_entry_path(key);
+    }
+
+    auto derived_data = DerivedData{};
+    auto forget_entry = [&self, &key, &entry_path, &derived_data]() {
+        LOG_WARN("Derived data '{}' is corrupt, removing.", entry_path);
+        derived_data.mapped.unmap();
+        auto lock = std::unique_lock(self.mutex);
+        auto it = self.entries.find(key);
+        if (it != self.entries.end()) {
+            self.total_size -= it->second.size;
+            self.entries.erase(it);
+        }
+
+        auto ec = std::error_code{};
+        fs::remove(entry_path, ec);
+        ++self.miss_count;
+    };
+
+    derived_data.mapped = MappedFile(entry_path);
+    auto file_data = derived_data.mapped.data;
+    if (!derived_data.mapped || file_data.size() < DERIVED_DATA_OFFSET) {
+        forget_entry();
+        return ls::nullopt;
+    }
+
+    const auto *header = reinterpret_cast<const DerivedDataFileHeader *>(file_data.data());
+    auto stored_data = get_asset_file_section<u8>(file_data, DERIVED_DATA_OFFSET, header->stored_size);
+    if (std::memcmp(header->magic, DerivedDataFileHeader{}.magic, sizeof(header->magic)) != 0 || !stored_data.has_value()) {
+        forget_entry();
+        return ls::nullopt;
+    }
+
+    switch (header->compression) {
+        case DerivedDataCompression::None: {
+            if (header->size != header->stored_size) {
+                forget_entry();
+                return ls::nullopt;
+            }
+
+            derived_data.data = stored_data.value();
+        } break;
+        case DerivedDataCompression::LZ4: {
+            derived_data.decompressed.resize(header->size);
+            if (!CompressorLZ4::decompress(stored_data->data(), stored_data->size(), derived_data.decompressed.data(), header->size)) {
+                forget_entry();
+                return ls::nullopt;
+            }
+
+            derived_data.data = ls::span<u8>(derived_data.decompressed.data(), derived_data.decompressed.size());
+            // Nothing to keep mapped
+            derived_data.mapped.unmap();
+        } break;
+        default: {
+            forget_entry();
+            return ls::nullopt;
+        }
+    }
+
+    // Persist access order, see `init`. Fails on some platforms while
+    // file is mapped, order is then only kept in memory.
+    auto ec = std::error_code{};
+    fs::last_write_time(entry_path, fs::file_time_type::clock::now(), ec);
+
+    ++self.hit_count;
+    self.hit_bytes += derived_data.data.size();
+
+    return derived_data;
+}
+
+auto DerivedDataCache::put(this DerivedDataCache &self, const DerivedDataKey &key, ls::span<u8> data) -> bool {
+    ZoneScoped;
+
+    if (!self.is_open()) {
+        return false;
+    }
+
+    auto header = DerivedDataFileHeader{ .size = data.size() };
+    auto compressed_data = std::vector<u8>();
+    if (!data.empty()) {
+        auto compressor = CompressorLZ4();
+        compressed_data = compressor.compress(data.data(), data.size());
+    }
+
+    // Entries that barely compress (block compressed textures) are stored
+    // as is, reading them is then just a mapping.
+    auto stored_data = data;
+    if (!compressed_data.empty() && compressed_data.size() < data.size() - data.size() / 10) {
+        header.compression = DerivedDataCompression::LZ4;
+        stored_data = ls::span<u8>(compressed_data.data(), compressed_data.size());
+    }
+    header.stored_size = stored_data.size();
+
+    auto contents = std::vector<u8>(DERIVED_DATA_OFFSET + stored_data.size(), 0);
+    std::memcpy(contents.data(), &header, sizeof(DerivedDataFileHeader));
+    if (!stored_data.empty()) {
+        std::memcpy(contents.data() + DERIVED_DATA_OFFSET, stored_data.data(), stored_data.size());
+    }
+
+    auto entry_path = fs::path{};
+    {
+        auto lock = std::unique_lock(self.mutex);
+        entry_path = self.to_entry_path(key);
+    }
+
+    // Renamed over the old entry once complete, readers never see half of it.
+    auto temp_path = entry_path;
+    temp_path += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        File file(temp_path, FileAccess::Write);
+        if (!file) {
+            LOG_ERROR("Failed to open file '{}' for writing!", temp_path);
+            return false;
+        }
+
+        if (file.write(contents.data(), contents.size()) != contents.size()) {
+            LOG_ERROR("Failed to write derived data '{}'!", temp_path);
+            return false;
+        }
+    }
+
+    auto ec = std::error_code{};
+    fs::rename(temp_path, entry_path, ec);
+    if (ec) {
+        LOG_ERROR("Failed to move derived data to '{}'! {}", entry_path, ec.message());
+        fs::remove(temp_path, ec);
+        return false;
+    }
+
+    self.compressed_bytes_saved += data.size() - stored_data.size();
+
+    auto lock = std::unique_lock(self.mutex);
+    auto &entry = self.entries[key];
+    self.total_size -= entry.size;
+    self.total_size += contents.size();
+    entry.size = contents.size();
+    entry.last_access = self.access_counter++;
+    self.evict(key);
+
+    return true;
+}
+
+auto DerivedDataCache::stats(this DerivedDataCache &self) -> DerivedDataCacheStats {
+    return {
+        .hit_count = self.hit_count.load(),
+        .miss_count = self.miss_count.load(),
+        .hit_bytes = self.hit_bytes.load(),
+        .compressed_bytes_saved = self.compressed_bytes_saved.load(),
+    };
+}
+
+auto DerivedDataCache::to_entry_path(this DerivedDataCache &self, const DerivedDataKey &key) -> fs::path {
+    auto entry_path = self.root_path / key.str();
+    entry_path += EXTENSION;
+
+    return entry_path;
+}
+
+auto DerivedDataCache::evict(this DerivedDataCache &self, const DerivedDataKey &keep_key) -> void {
+    ZoneScoped;
+
+    if (self.total_size <= self.max_size) {
+        return;
+    }
+
+    auto lru_entries = std::vector<ls::pair<u64, DerivedDataKey>>();
+    for (const auto &[key, entry] : self.entries) {
+        if (key != keep_key) {
+            lru_entries.emplace_back(entry.last_access, key);
+        }
+    }
+    std::ranges::sort(lru_entries, {}, &ls::pair<u64, DerivedDataKey>::n0);
+
+    auto evicted_count = 0_sz;
+    for (const auto &[last_access, key] : lru_entries) {
+        if (self.total_size <= self.max_size) {
+            break;
+        }
+
+        // Entries still mapped by a reader may fail to be removed on some
+        // platforms, they are picked up again on next `init`.
+        auto ec = std::error_code{};
+        fs::remove(self.to_entry_path(key), ec);
+
+        auto it = self.entries.find(key);
+        self.total_size -= it->second.size;
+        self.entries.erase(it);
+        evicted_count++;
+    }
+
+    LOG_TRACE("Evicted {} derived data entries, cache is at {} MiB.", evicted_count, self.total_size / (1024 * 1024));
+}
+} // namespace lr
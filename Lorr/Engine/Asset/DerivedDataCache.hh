@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Engine/OS/File.hh"
+
+namespace lr {
+// Hashed into every key, bump to drop every cache entry at once.
+constexpr static u32 ENGINE_DERIVED_DATA_VERSION = 1;
+
+struct DerivedDataKey {
+    u64 low = 0;
+    u64 high = 0;
+
+    auto str() const -> std::string;
+
+    constexpr auto operator==(const DerivedDataKey &) const -> bool = default;
+};
+
+// Entry of the cache. Stored uncompressed entries point into the mapping,
+// compressed ones are decompressed into `decompressed`.
+struct DerivedData {
+    MappedFile mapped = {};
+    std::vector<u8> decompressed = {};
+    ls::span<u8> data = {};
+};
+
+struct DerivedDataCacheStats {
+    u64 hit_count = 0;
+    u64 miss_count = 0;
+    // Bytes served from cache that didn't have to be processed again.
+    u64 hit_bytes = 0;
+    // Difference between uncompressed and stored size of written entries.
+    u64 compressed_bytes_saved = 0;
+};
+} // namespace lr
+
+template<>
+struct ankerl::unordered_dense::hash<lr::DerivedDataKey> {
+    using is_avalanching = void;
+    u64 operator()(const lr::DerivedDataKey &key) const noexcept {
+        return key.low ^ key.high;
+    }
+};
+
+namespace lr {
+// Results of asset processing (cooked models, textures...) keyed by hash of
+// source contents, hash of processing parameters and engine version. Same
+// input never gets processed twice, even across renames or projects that
+// share files.
+//
+// Every entry is a single `<key>.ddc` file under `root_path`. Entries that
+// compress well are LZ4 compressed, others are stored as is and mapped
+// directly. When total size goes above `max_size`, least recently used
+// entries are evicted. Access order survives restarts through file mtimes.
+//
+// Thread safe.
+struct DerivedDataCache {
+    constexpr static auto DEFAULT_MAX_SIZE = 4_u64 * 1024 * 1024 * 1024;
+    constexpr static auto EXTENSION = std::string_view(".ddc");
+
+    struct Entry {
+        u64 size = 0;
+        u64 last_access = 0;
+    };
+
+    struct SourceHash {
+        u64 size = 0;
+        i64 time = 0;
+        u64 hash = 0;
+    };
+
+    fs::path root_path = {};
+    u64 max_size = DEFAULT_MAX_SIZE;
+
+    std::mutex mutex = {};
+    ankerl::unordered_dense::map<DerivedDataKey, Entry> entries = {};
+    // Source files are hashed once until they change.
+    ankerl::unordered_dense::map<fs::path, SourceHash> source_hashes = {};
+    u64 total_size = 0;
+    u64 access_counter = 0;
+
+    std::atomic<u64> hit_count = 0;
+    std::atomic<u64> miss_count = 0;
+    std::atomic<u64> hit_bytes = 0;
+    std::atomic<u64> compressed_bytes_saved = 0;
+
+    auto init(this DerivedDataCache &, const fs::path &root_path, u64 max_size = DEFAULT_MAX_SIZE) -> bool;
+    auto is_open(this DerivedDataCache &) -> bool;
+
+    auto hash_file(this DerivedDataCache &, const fs::path &path) -> ls::option<u64>;
+    // Hashes known from earlier runs, `hash_file` still checks their size
+    // and time before trusting them.
+    auto get_source_hash(this DerivedDataCache &, const fs::path &path) -> ls::option<SourceHash>;
+    auto set_source_hash(this DerivedDataCache &, const fs::path &path, const SourceHash &source_hash) -> void;
+    auto make_key(this DerivedDataCache &, u64 source_hash, u64 params_hash) -> DerivedDataKey;
+
+    // Doesn't count as an access.
+    auto contains(this DerivedDataCache &, const DerivedDataKey &key) -> bool;
+    auto get(this DerivedDataCache &, const DerivedDataKey &key) -> ls::option<DerivedData>;
+    auto put(this DerivedDataCache &, const DerivedDataKey &key, ls::span<u8> data) -> bool;
+
+    auto stats(this DerivedDataCache &) -> DerivedDataCacheStats;
+
+private:
+    auto to_entry_path(this DerivedDataCache &, const DerivedDataKey &key) -> fs::path;
+    auto evict(this DerivedDataCache &, const DerivedDataKey &keep_key) -> void;
+};
+} // namespace lr
@@ -0,0 +1,457 @@
+#include "Engine/Asset/MeshStreamer.hh"
+
+#include "Engine/Asset/Asset.hh"
+#include "Engine/Asset/ModelFile.hh"
+
+#include "Engine/Core/App.hh"
+
+#include "Engine/Graphics/VulkanDevice.hh"
+
+#include <xxhash.h>
+
+namespace lr {
+static auto resident_size(const MeshStreamer::StreamedPrimitive &primitive) -> u64 {
+    auto size = primitive.fixed_size;
+    if (primitive.key.has_value()) {
+        for (u32 lod_index = primitive.resident_lod; lod_index + 1 < primitive.lod_count; lod_index++) {
+            size += primitive.lod_sizes[lod_index];
+        }
+    }
+
+    return size;
+}
+
+auto MeshStreamer::destroy(this MeshStreamer &self, AssetManager &asset_man) -> void {
+    ZoneScoped;
+
+    auto in_flight_count = self.in_flight_count.load();
+    while (in_flight_count != 0) {
+        self.in_flight_count.wait(in_flight_count);
+        in_flight_count = self.in_flight_count.load();
+    }
+
+    auto &device = App::mod<Device>();
+    auto lock = std::unique_lock(self.mutex);
+    for (const auto &finished_lod : self.finished_lods) {
+        self.release_lod_buffer(asset_man, finished_lod.buffer, finished_lod.buffer_hash);
+    }
+
+    for (const auto &retired_buffer : self.retired_buffers) {
+        device.destroy(retired_buffer.buffer.id());
+    }
+
+    self.finished_lods.clear();
+    self.retired_buffers.clear();
+    self.primitives.clear();
+}
+
+auto MeshStreamer::lod_range(const GPU::Mesh &cooked_mesh, u64 payload_size, u32 lod_index) -> ls::pair<u64, u64> {
+    auto offset = cooked_mesh.lods[lod_index].indices;
+    auto end = lod_index + 1 < cooked_mesh.lod_count ? cooked_mesh.lods[lod_index + 1].indices : payload_size;
+
+    return { offset, end - offset };
+}
+
+auto MeshStreamer::relocate_lod(GPU::MeshLOD &lod, u64 src_offset, u64 dst_address) -> void {
+    lod.indices = lod.indices - src_offset + dst_address;
+    lod.meshlets = lod.meshlets - src_offset + dst_address;
+    lod.meshlet_bounds = lod.meshlet_bounds - src_offset + dst_address;
+    lod.meshlet_errors = lod.meshlet_errors - src_offset + dst_address;
+    lod.local_triangle_indices = lod.local_triangle_indices - src_offset + dst_address;
+    lod.indirect_vertex_indices = lod.indirect_vertex_indices - src_offset + dst_address;
+}
+
+auto MeshStreamer::lod_buffer_hash(u64 payload_hash, u32 lod_index) -> u64 {
+    auto params = std::array<u64, 2>{ ~0_u64, lod_index };
+    auto hash = XXH3_64bits_withSeed(params.data(), params.size() * sizeof(u64), payload_hash);
+
+    return hash == 0 ? 1 : hash;
+}
+
+auto MeshStreamer::add_primitive(
+    this MeshStreamer &self,
+    const UUID &model_uuid,
+    u32 primitive_index,
+    ls::option<DerivedDataKey> key,
+    const GPU::Mesh &cooked_mesh,
+    u64 payload_size,
+    u32 resident_lod
+) -> void {
+    ZoneScoped;
+
+    auto primitive = StreamedPrimitive{
+        .key = key,
+        .lod_count = cooked_mesh.lod_count,
+        .resident_lod = resident_lod,
+        .wanted_lod = resident_lod,
+        .version = 0,
+    };
+
+    for (u32 lod_index = 0; lod_index < cooked_mesh.lod_count; lod_index++) {
+        primitive.lod_sizes[lod_index] = lod_range(cooked_mesh, payload_size, lod_index).n1;
+    }
+
+    // Vertex data and coarsest LOD never leave.
+    primitive.fixed_size = payload_size;
+    if (key.has_value()) {
+        primitive.fixed_size = cooked_mesh.lods[0].indices + primitive.lod_sizes[cooked_mesh.lod_count - 1];
+    }
+
+    auto lock = std::unique_lock(self.mutex);
+    primitive.version = ++self.version_counter;
+    self.primitives.insert_or_assign(PrimitiveKey(model_uuid, primitive_index), primitive);
+}
+
+auto MeshStreamer::remove_model(this MeshStreamer &self, const UUID &model_uuid) -> void {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    std::erase_if(self.primitives, [&](const auto &entry) { return entry.first.n0 == model_uuid; });
+}
+
+auto MeshStreamer::request(this MeshStreamer &self, const UUID &model_uuid, u32 primitive_index, u32 lod_index) -> void {
+    auto lock = std::unique_lock(self.mutex);
+    auto it = self.primitives.find(PrimitiveKey(model_uuid, primitive_index));
+    if (it == self.primitives.end() || !it->second.key.has_value()) {
+        return;
+    }
+
+    // Same primitive can be in multiple scenes, finest one wins for this frame.
+    auto &primitive = it->second;
+    if (primitive.demand_frame != self.frame_index) {
+        primitive.wanted_lod = lod_index;
+        primitive.demand_frame = self.frame_index;
+    } else {
+        primitive.wanted_lod = ls::min(primitive.wanted_lod, lod_index);
+    }
+}
+
+auto MeshStreamer::update(this MeshStreamer &self, AssetManager &asset_man) -> void {
+    ZoneScoped;
+
+    auto &device = App::mod<Device>();
+    auto lock = std::unique_lock(self.mutex);
+    self.frame_index++;
+
+    //  ── FINISHED LODS ───────────────────────────────────────────────────
+    auto models_changed = false;
+    for (auto &finished_lod : self.finished_lods) {
+        const auto &[model_uuid, primitive_index] = finished_lod.primitive;
+        auto primitive_it = self.primitives.find(finished_lod.primitive);
+        auto *model_asset = asset_man.get_asset(model_uuid);
+        auto is_alive = primitive_it != self.primitives.end() && primitive_it->second.version == finished_lod.version && model_asset
+            && model_asset->is_resident();
+        if (!is_alive) {
+            self.release_lod_buffer(asset_man, finished_lod.buffer, finished_lod.buffer_hash);
+            continue;
+        }
+
+        auto &primitive = primitive_it->second;
+        primitive.in_flight = false;
+        // Evicted while it was in flight
+        if (finished_lod.lod_index + 1 != primitive.resident_lod) {
+            self.release_lod_buffer(asset_man, finished_lod.buffer, finished_lod.buffer_hash);
+            continue;
+        }
+
+        auto *model = asset_man.get_model(model_asset->model_id);
+        auto &gpu_mesh = model->gpu_meshes[primitive_index];
+        gpu_mesh.lods[finished_lod.lod_index] = finished_lod.gpu_lod;
+        gpu_mesh.finest_resident_lod = finished_lod.lod_index;
+        model->gpu_lod_buffers[primitive_index][finished_lod.lod_index] = finished_lod.buffer;
+        model->gpu_lod_buffer_hashes[primitive_index][finished_lod.lod_index] = finished_lod.buffer_hash;
+        primitive.resident_lod = finished_lod.lod_index;
+        models_changed = true;
+    }
+    self.finished_lods.clear();
+
+    // Frames in flight might still read retired buffers.
+    std::erase_if(self.retired_buffers, [&](const RetiredBuffer &retired_buffer) {
+        if (self.frame_index < retired_buffer.frame_index + device.frame_count() + 1) {
+            return false;
+        }
+
+        device.destroy(retired_buffer.buffer.id());
+        return true;
+    });
+
+    //  ── DEMAND ──────────────────────────────────────────────────────────
+    struct Candidate {
+        PrimitiveKey key = {};
+        StreamedPrimitive *primitive = nullptr;
+    };
+    auto candidates = std::vector<Candidate>();
+    auto total_size = 0_u64;
+    for (auto &[primitive_key, primitive] : self.primitives) {
+        total_size += resident_size(primitive);
+        if (!primitive.key.has_value()) {
+            continue;
+        }
+
+        // Requests of last frame, feedback of `cull_meshes`.
+        auto was_requested = primitive.demand_frame + 1 == self.frame_index;
+        if (was_requested && primitive.wanted_lod < primitive.resident_lod) {
+            primitive.request_frame_count++;
+        } else {
+            primitive.request_frame_count = 0;
+        }
+
+        candidates.push_back({ .key = primitive_key, .primitive = &primitive });
+    }
+
+    //  ── EVICTION ────────────────────────────────────────────────────────
+    // Not seen for longest, then furthest away gives up its finest LOD first.
+    std::ranges::sort(candidates, [](const Candidate &lhs, const Candidate &rhs) {
+        if (lhs.primitive->demand_frame != rhs.primitive->demand_frame) {
+            return lhs.primitive->demand_frame < rhs.primitive->demand_frame;
+        }
+
+        return lhs.primitive->wanted_lod > rhs.primitive->wanted_lod;
+    });
+
+    while (total_size > self.budget) {
+        auto evicted = false;
+        for (auto &candidate : candidates) {
+            auto &primitive = *candidate.primitive;
+            if (primitive.in_flight || primitive.resident_lod + 1 >= primitive.lod_count) {
+                continue;
+            }
+
+            auto lod_size = primitive.lod_sizes[primitive.resident_lod];
+            if (!self.evict(asset_man, candidate.key, primitive)) {
+                continue;
+            }
+
+            total_size -= lod_size;
+            evicted = true;
+            models_changed = true;
+            if (total_size <= self.budget) {
+                break;
+            }
+        }
+
+        // Only coarsest LODs left
+        if (!evicted) {
+            break;
+        }
+    }
+
+    //  ── SCHEDULE ────────────────────────────────────────────────────────
+    // Most recently seen first, evicted ones sort last and don't come back
+    // until they are requested again.
+    for (auto &candidate : std::views::reverse(candidates)) {
+        auto &primitive = *candidate.primitive;
+        if (self.in_flight_count.load() >= MAX_IN_FLIGHT_COUNT) {
+            break;
+        }
+
+        if (primitive.in_flight || primitive.request_frame_count < REQUEST_THRESHOLD_FRAMES || primitive.resident_lod == 0) {
+            continue;
+        }
+
+        // Would only push something else out
+        auto lod_size = primitive.lod_sizes[primitive.resident_lod - 1];
+        if (total_size + lod_size > self.budget) {
+            continue;
+        }
+
+        total_size += lod_size;
+        self.stream(asset_man, candidate.key, primitive);
+    }
+
+    lock.unlock();
+
+    if (models_changed) {
+        asset_man.set_models_dirty();
+    }
+}
+
+auto MeshStreamer::stats(this MeshStreamer &self) -> MeshStreamingStats {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    auto stats = MeshStreamingStats{ .budget = self.budget, .in_flight_count = self.in_flight_count.load() };
+    for (const auto &[primitive_key, primitive] : self.primitives) {
+        stats.resident_size += resident_size(primitive);
+        stats.fixed_size += primitive.fixed_size;
+        if (primitive.key.has_value()) {
+            stats.streamed_primitive_count++;
+        }
+    }
+
+    return stats;
+}
+
+auto MeshStreamer::stream(this MeshStreamer &self, AssetManager &asset_man, const PrimitiveKey &primitive_key, StreamedPrimitive &primitive)
+    -> void {
+    ZoneScoped;
+
+    primitive.in_flight = true;
+    ++self.in_flight_count;
+
+    auto job = Job::create([&self,
+                            &asset_man,
+                            primitive_key,
+                            key = primitive.key.value(),
+                            lod_index = primitive.resident_lod - 1,
+                            version = primitive.version]() {
+        ZoneScopedN("Stream Mesh LOD");
+
+        // Queued ones stay in flight until their upload completes.
+        auto is_queued = false;
+        auto finish = [&self]() {
+            --self.in_flight_count;
+            self.in_flight_count.notify_all();
+        };
+        LS_DEFER(&) {
+            if (!is_queued) {
+                finish();
+            }
+        };
+
+        // Cache entry got evicted, stay at what we have.
+        auto cancel = [&]() {
+            auto lock = std::unique_lock(self.mutex);
+            auto it = self.primitives.find(primitive_key);
+            if (it != self.primitives.end() && it->second.version == version) {
+                it->second.in_flight = false;
+                it->second.key.reset();
+            }
+        };
+
+        auto model_file = ls::option<ModelFile>();
+        if (auto derived_data = asset_man.derived_data_cache.get(key); derived_data.has_value()) {
+            model_file = ModelFile::from_data(std::move(derived_data.value()));
+        }
+
+        auto cooked_primitive = ls::option<CookedPrimitive>();
+        if (model_file.has_value()) {
+            cooked_primitive = model_file->read_primitive(primitive_key.n1);
+        }
+
+        if (!cooked_primitive.has_value() || lod_index >= cooked_primitive->gpu_mesh.lod_count) {
+            LOG_WARN("Mesh LODs of model {} can't be streamed, cooked data is gone.", primitive_key.n0.str());
+            cancel();
+            return;
+        }
+
+        auto &device = App::mod<Device>();
+        auto &transfer_man = device.transfer_man();
+        auto [lod_offset, lod_size] = lod_range(cooked_primitive->gpu_mesh, cooked_primitive->payload_size, lod_index);
+
+        // Another model with the same primitive might have it resident.
+        auto buffer_hash = lod_buffer_hash(cooked_primitive->payload_hash, lod_index);
+        auto buffer = Buffer{};
+        auto upload_value = 0_u64;
+        {
+            auto lock = std::unique_lock(asset_man.mesh_buffers_mutex);
+            auto shared_buffer_it = asset_man.shared_mesh_buffers.find(buffer_hash);
+            if (shared_buffer_it != asset_man.shared_mesh_buffers.end()) {
+                shared_buffer_it->second.ref_count++;
+                buffer = shared_buffer_it->second.buffer;
+                upload_value = shared_buffer_it->second.upload_value;
+            }
+        }
+
+        if (!buffer) {
+            auto cpu_buffer = transfer_man.alloc_staging_buffer(lod_size);
+            if (!cooked_primitive->read_payload(lod_offset, { reinterpret_cast<u8 *>(cpu_buffer->mapped_ptr), lod_size })) {
+                LOG_WARN("Mesh LODs of model {} can't be streamed, cooked data is corrupt.", primitive_key.n0.str());
+                transfer_man.discard_staging(cpu_buffer);
+                cancel();
+                return;
+            }
+
+            buffer = Buffer::create(device, lod_size, vuk::MemoryUsage::eGPUonly).value();
+
+            auto buffer_handle = device.buffer(buffer.id());
+            auto subrange = vuk::discard_buf("mesh lod", buffer_handle->subrange(0, lod_size));
+            subrange = transfer_man.upload(std::move(cpu_buffer), std::move(subrange), transfer_man.transfer_domain());
+            subrange = subrange.as_released(vuk::Access::eMemoryRead, vuk::DomainFlagBits::eGraphicsQueue);
+            upload_value = transfer_man.batch_upload(std::move(subrange), lod_size);
+
+            // Others wait for the same upload.
+            auto lock = std::unique_lock(asset_man.mesh_buffers_mutex);
+            auto shared_buffer = SharedMeshBuffer{ .buffer = buffer, .upload_value = upload_value, .ref_count = 1 };
+            if (!asset_man.shared_mesh_buffers.try_emplace(buffer_hash, shared_buffer).second) {
+                buffer_hash = 0;
+            }
+        }
+
+        auto gpu_lod = cooked_primitive->gpu_mesh.lods[lod_index];
+        relocate_lod(gpu_lod, lod_offset, buffer.device_address());
+
+        // Swapped in by `update` once it is on GPU, worker doesn't wait for it.
+        auto finished_lod = StreamedLOD{
+            .primitive = primitive_key,
+            .version = version,
+            .lod_index = lod_index,
+            .gpu_lod = gpu_lod,
+            .buffer = buffer,
+            .buffer_hash = buffer_hash,
+        };
+        is_queued = true;
+        transfer_man.on_upload_complete(upload_value, [&self, finished_lod, finish]() {
+            {
+                auto lock = std::unique_lock(self.mutex);
+                self.finished_lods.push_back(finished_lod);
+            }
+
+            finish();
+        });
+        transfer_man.flush_uploads();
+    });
+    App::submit_job(std::move(job));
+}
+
+auto MeshStreamer::evict(this MeshStreamer &self, AssetManager &asset_man, const PrimitiveKey &primitive_key, StreamedPrimitive &primitive)
+    -> bool {
+    ZoneScoped;
+
+    const auto &[model_uuid, primitive_index] = primitive_key;
+    auto *model_asset = asset_man.get_asset(model_uuid);
+    if (!model_asset || !model_asset->is_resident()) {
+        return false;
+    }
+
+    auto *model = asset_man.get_model(model_asset->model_id);
+    auto lod_index = primitive.resident_lod;
+    auto &gpu_mesh = model->gpu_meshes[primitive_index];
+    auto &buffer = model->gpu_lod_buffers[primitive_index][lod_index];
+    auto &buffer_hash = model->gpu_lod_buffer_hashes[primitive_index][lod_index];
+    self.release_lod_buffer(asset_man, buffer, buffer_hash);
+    buffer = {};
+    buffer_hash = 0;
+
+    // Counts stay, `cull_meshes` never picks it anyway.
+    auto &gpu_lod = gpu_mesh.lods[lod_index];
+    gpu_lod.indices = 0;
+    gpu_lod.meshlets = 0;
+    gpu_lod.meshlet_bounds = 0;
+    gpu_lod.meshlet_errors = 0;
+    gpu_lod.local_triangle_indices = 0;
+    gpu_lod.indirect_vertex_indices = 0;
+    gpu_mesh.finest_resident_lod = lod_index + 1;
+    primitive.resident_lod = lod_index + 1;
+
+    return true;
+}
+
+auto MeshStreamer::release_lod_buffer(this MeshStreamer &self, AssetManager &asset_man, const Buffer &buffer, u64 buffer_hash) -> void {
+    ZoneScoped;
+
+    if (buffer_hash != 0) {
+        auto lock = std::unique_lock(asset_man.mesh_buffers_mutex);
+        auto shared_buffer_it = asset_man.shared_mesh_buffers.find(buffer_hash);
+        if (shared_buffer_it != asset_man.shared_mesh_buffers.end()) {
+            if (--shared_buffer_it->second.ref_count != 0) {
+                return;
+            }
+
+            asset_man.shared_mesh_buffers.erase(shared_buffer_it);
+        }
+    }
+
+    self.retired_buffers.push_back({ .frame_index = self.frame_index, .buffer = buffer });
+}
+} // namespace lr
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Engine/Asset/DerivedDataCache.hh"
+#include "Engine/Asset/Model.hh"
+
+namespace lr {
+struct AssetManager;
+
+struct MeshStreamingStats {
+    u64 budget = 0;
+    u64 resident_size = 0;
+    // Part of `resident_size` that can't be streamed out.
+    u64 fixed_size = 0;
+    u32 streamed_primitive_count = 0;
+    u32 in_flight_count = 0;
+};
+
+// Keeps LODs that are actually selected resident. Streamed primitives start
+// with vertex data and their coarsest LOD, so objects show up right away.
+// `cull_meshes` reports finest LOD it selected for every visible mesh and
+// once a LOD that isn't resident keeps getting selected it's streamed in
+// from derived data cache, one level at a time. When the budget is
+// exceeded, fine LODs of meshes that are far away or out of sight are
+// dropped first.
+//
+// Every LOD finer than the coarsest one lives in its own buffer, shared
+// through `AssetManager::shared_mesh_buffers` by primitives with the same
+// payload. GPU side LOD selection is clamped to `GPU::Mesh::finest_resident_lod`.
+// Demand and updates are expected from the main thread, LODs are read in
+// jobs and go into upload batches. `update` swaps them in once their
+// upload completes.
+struct MeshStreamer {
+    constexpr static u64 DEFAULT_BUDGET = 1_u64 * 1024 * 1024 * 1024;
+    // Frames in a row a LOD has to be selected before it's streamed in,
+    // LODs flickering around a threshold stay out.
+    constexpr static u32 REQUEST_THRESHOLD_FRAMES = 4;
+    constexpr static u32 MAX_IN_FLIGHT_COUNT = 8;
+
+    using PrimitiveKey = ls::pair<UUID, u32>;
+
+    struct StreamedPrimitive {
+        // Primitives not coming from derived data cache have every LOD.
+        ls::option<DerivedDataKey> key = ls::nullopt;
+        u32 lod_count = 0;
+        // Finest level currently resident
+        u32 resident_lod = 0;
+        // Finest level selected in `demand_frame`
+        u32 wanted_lod = 0;
+        u32 request_frame_count = 0;
+        u64 demand_frame = 0;
+        u64 fixed_size = 0;
+        u64 lod_sizes[GPU::Mesh::MAX_LODS] = {};
+        // Bumped when primitive is added again, results of older jobs are dropped.
+        u64 version = 0;
+        bool in_flight = false;
+    };
+
+    struct StreamedLOD {
+        PrimitiveKey primitive = {};
+        u64 version = 0;
+        u32 lod_index = 0;
+        GPU::MeshLOD gpu_lod = {};
+        Buffer buffer = {};
+        // 0 when another job shared the same LOD first.
+        u64 buffer_hash = 0;
+    };
+
+    struct RetiredBuffer {
+        u64 frame_index = 0;
+        Buffer buffer = {};
+    };
+
+    u64 budget = DEFAULT_BUDGET;
+    u64 frame_index = 0;
+    u64 version_counter = 0;
+
+    std::mutex mutex = {};
+    ankerl::unordered_dense::map<PrimitiveKey, StreamedPrimitive> primitives = {};
+    std::vector<StreamedLOD> finished_lods = {};
+    std::vector<RetiredBuffer> retired_buffers = {};
+    std::atomic<u32> in_flight_count = 0;
+
+    auto destroy(this MeshStreamer &, AssetManager &asset_man) -> void;
+
+    // Payload range of `lod_index` in a cooked primitive, LODs are laid
+    // out one after another after vertex data. See `cook_primitive`.
+    static auto lod_range(const GPU::Mesh &cooked_mesh, u64 payload_size, u32 lod_index) -> ls::pair<u64, u64>;
+    // Moves addresses of `lod` from `src_offset` to `dst_address`.
+    static auto relocate_lod(GPU::MeshLOD &lod, u64 src_offset, u64 dst_address) -> void;
+    // Key of a streamed LOD buffer in `AssetManager::shared_mesh_buffers`. Never 0.
+    static auto lod_buffer_hash(u64 payload_hash, u32 lod_index) -> u64;
+
+    auto add_primitive(
+        this MeshStreamer &,
+        const UUID &model_uuid,
+        u32 primitive_index,
+        ls::option<DerivedDataKey> key,
+        const GPU::Mesh &cooked_mesh,
+        u64 payload_size,
+        u32 resident_lod
+    ) -> void;
+    auto remove_model(this MeshStreamer &, const UUID &model_uuid) -> void;
+
+    // `lod_index` of primitive got selected this frame.
+    auto request(this MeshStreamer &, const UUID &model_uuid, u32 primitive_index, u32 lod_index) -> void;
+    // Applies finished LODs, evicts and schedules new ones. Once per frame.
+    auto update(this MeshStreamer &, AssetManager &asset_man) -> void;
+
+    auto stats(this MeshStreamer &) -> MeshStreamingStats;
+
+private:
+    auto stream(this MeshStreamer &, AssetManager &asset_man, const PrimitiveKey &primitive_key, StreamedPrimitive &primitive) -> void;
+    // Drops finest resident LOD of `primitive`.
+    auto evict(this MeshStreamer &, AssetManager &asset_man, const PrimitiveKey &primitive_key, StreamedPrimitive &primitive) -> bool;
+    // Retires `buffer` once nothing else shares it.
+    auto release_lod_buffer(this MeshStreamer &, AssetManager &asset_man, const Buffer &buffer, u64 buffer_hash) -> void;
+};
+} // namespace lr
@@ -0,0 +1,493 @@
+#include "Engine/Asset/MipChain.hh"
+
+#include "Engine/Core/App.hh"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    #include <immintrin.h>
+#endif
+
+namespace lr {
+// Filters are fixed point integer math, SIMD and scalar paths give the
+// same results without caring about FMA contraction or rounding modes.
+constexpr static i32 MIP_WEIGHT_BITS = 14;
+constexpr static i32 MIP_WEIGHT_ONE = 1 << MIP_WEIGHT_BITS;
+constexpr static u32 MIP_MAX_TAP_COUNT = 6;
+// Texels a job takes at once.
+constexpr static u32 MIP_CHUNK_TEXEL_COUNT = 16384;
+
+// Taps of a 2x downsample, dst texel `x` reads src texels starting from
+// `2x + first_tap`. Weights sum to `MIP_WEIGHT_ONE`.
+struct MipKernel {
+    i32 first_tap = 0;
+    u32 tap_count = 0;
+    i32 weights[MIP_MAX_TAP_COUNT] = {};
+};
+
+struct MipTables {
+    std::array<u16, 256> srgb_to_linear = {};
+    // Indexed by 16 bit linear value.
+    std::vector<u8> linear_to_srgb = {};
+};
+
+static auto bessel_i0(f64 x) -> f64 {
+    auto sum = 1.0;
+    auto term = 1.0;
+    for (u32 k = 1; k < 32; k++) {
+        auto t = x / (2.0 * static_cast<f64>(k));
+        term *= t * t;
+        sum += term;
+    }
+
+    return sum;
+}
+
+static auto make_kernel(MipFilter filter) -> MipKernel {
+    ZoneScoped;
+
+    switch (filter) {
+        case MipFilter::Box: {
+            return MipKernel{ .first_tap = 0, .tap_count = 2, .weights = { MIP_WEIGHT_ONE / 2, MIP_WEIGHT_ONE / 2 } };
+        }
+        case MipFilter::Kaiser: {
+            constexpr static auto RADIUS = 1.5;
+            constexpr static auto BETA = 4.0;
+
+            auto kernel = MipKernel{ .first_tap = -2, .tap_count = 6 };
+            f64 weights[MIP_MAX_TAP_COUNT] = {};
+            auto weight_sum = 0.0;
+            for (u32 i = 0; i < kernel.tap_count; i++) {
+                // Distance between src and dst texel centers, in dst texels.
+                auto x = (static_cast<f64>(kernel.first_tap + static_cast<i32>(i)) - 0.5) * 0.5;
+                auto sinc = std::sin(glm::pi<f64>() * x) / (glm::pi<f64>() * x);
+                auto r = x / RADIUS;
+                auto window = bessel_i0(BETA * std::sqrt(ls::max(1.0 - r * r, 0.0))) / bessel_i0(BETA);
+                weights[i] = sinc * window;
+                weight_sum += weights[i];
+            }
+
+            auto fixed_weight_sum = 0_i32;
+            for (u32 i = 0; i < kernel.tap_count; i++) {
+                kernel.weights[i] = static_cast<i32>(std::lround(weights[i] / weight_sum * MIP_WEIGHT_ONE));
+                fixed_weight_sum += kernel.weights[i];
+            }
+
+            // Rounding leftover goes to center taps, flat areas must stay flat.
+            auto leftover = MIP_WEIGHT_ONE - fixed_weight_sum;
+            kernel.weights[2] += leftover / 2;
+            kernel.weights[3] += leftover - leftover / 2;
+
+            return kernel;
+        }
+    }
+
+    return {};
+}
+
+static auto mip_tables() -> const MipTables & {
+    static const auto tables = []() {
+        ZoneScopedN("Build Mip Tables");
+
+        auto result = MipTables{};
+        for (u32 i = 0; i < result.srgb_to_linear.size(); i++) {
+            auto c = static_cast<f64>(i) / 255.0;
+            auto l = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+            result.srgb_to_linear[i] = static_cast<u16>(std::lround(l * 65535.0));
+        }
+
+        result.linear_to_srgb.resize(65536);
+        for (u32 i = 0; i < result.linear_to_srgb.size(); i++) {
+            auto l = static_cast<f64>(i) / 65535.0;
+            auto c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+            result.linear_to_srgb[i] = static_cast<u8>(std::lround(ls::min(ls::max(c, 0.0), 1.0) * 255.0));
+        }
+
+        return result;
+    }();
+
+    return tables;
+}
+
+static auto unorm16_to_unorm8(u32 v) -> u8 {
+    return static_cast<u8>((v * 255 + 32767) / 65535);
+}
+
+static auto resolve_weighted(i32 acc) -> u16 {
+    return static_cast<u16>(std::clamp((acc + MIP_WEIGHT_ONE / 2) >> MIP_WEIGHT_BITS, 0, 65535));
+}
+
+//  ── PARALLEL ROWS ───────────────────────────────────────────────────
+static auto for_each_row(u32 row_count, u32 row_width, bool parallel, const std::function<void(u32 first_row, u32 last_row)> &fn) -> void {
+    if (!parallel) {
+        fn(0, row_count);
+        return;
+    }
+
+    auto rows_per_chunk = ls::max(MIP_CHUNK_TEXEL_COUNT / ls::max(row_width, 1_u32), 1_u32);
+    App::get().job_man.parallel_for(row_count, rows_per_chunk, fn);
+}
+
+//  ── FILTERS ─────────────────────────────────────────────────────────
+static auto filter_texel_h(const u16 *src_row, u32 src_width, u32 x, const MipKernel &kernel, u16 *dst_texel) -> void {
+    i32 acc[4] = {};
+    for (u32 i = 0; i < kernel.tap_count; i++) {
+        auto src_x = std::clamp(static_cast<i32>(x * 2) + kernel.first_tap + static_cast<i32>(i), 0, static_cast<i32>(src_width) - 1);
+        const auto *src_texel = src_row + src_x * 4;
+        for (u32 c = 0; c < 4; c++) {
+            acc[c] += kernel.weights[i] * static_cast<i32>(src_texel[c]);
+        }
+    }
+
+    for (u32 c = 0; c < 4; c++) {
+        dst_texel[c] = resolve_weighted(acc[c]);
+    }
+}
+
+static auto filter_row_h(const u16 *src_row, u32 src_width, u16 *dst_row, u32 dst_width, const MipKernel &kernel, bool use_simd) -> void {
+    // Texels with every tap inside the row don't need clamping.
+    auto inner_begin = kernel.first_tap < 0 ? (static_cast<u32>(-kernel.first_tap) + 1) / 2 : 0_u32;
+    auto last_inner = static_cast<i32>(src_width) - kernel.first_tap - static_cast<i32>(kernel.tap_count);
+    auto inner_end = last_inner < 0 ? 0_u32 : ls::min(static_cast<u32>(last_inner / 2) + 1, dst_width);
+    if (!use_simd || inner_begin >= inner_end) {
+        inner_begin = 0;
+        inner_end = 0;
+    }
+
+    auto x = 0_u32;
+    for (; x < inner_begin; x++) {
+        filter_texel_h(src_row, src_width, x, kernel, dst_row + x * 4);
+    }
+
+#if defined(__AVX2__)
+    auto bias_256 = _mm256_set1_epi32(MIP_WEIGHT_ONE / 2);
+    for (; x + 2 <= inner_end; x += 2) {
+        const auto *taps = src_row + (static_cast<i32>(x * 2) + kernel.first_tap) * 4;
+        auto acc = _mm256_setzero_si256();
+        for (u32 i = 0; i < kernel.tap_count; i++) {
+            auto texel_0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(taps + i * 4));
+            auto texel_1 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(taps + (i + 2) * 4));
+            auto texels = _mm256_cvtepu16_epi32(_mm_unpacklo_epi64(texel_0, texel_1));
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(texels, _mm256_set1_epi32(kernel.weights[i])));
+        }
+
+        auto result = _mm256_srai_epi32(_mm256_add_epi32(acc, bias_256), MIP_WEIGHT_BITS);
+        // Pack saturates the same way `resolve_weighted` clamps.
+        auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0b1000);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_row + x * 4), _mm256_castsi256_si128(packed));
+    }
+#endif
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    auto bias_128 = _mm_set1_epi32(MIP_WEIGHT_ONE / 2);
+    for (; x < inner_end; x++) {
+        const auto *taps = src_row + (static_cast<i32>(x * 2) + kernel.first_tap) * 4;
+        auto acc = _mm_setzero_si128();
+        for (u32 i = 0; i < kernel.tap_count; i++) {
+            auto texel = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(taps + i * 4)));
+            acc = _mm_add_epi32(acc, _mm_mullo_epi32(texel, _mm_set1_epi32(kernel.weights[i])));
+        }
+
+        auto result = _mm_srai_epi32(_mm_add_epi32(acc, bias_128), MIP_WEIGHT_BITS);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst_row + x * 4), _mm_packus_epi32(result, result));
+    }
+#endif
+
+    for (; x < dst_width; x++) {
+        filter_texel_h(src_row, src_width, x, kernel, dst_row + x * 4);
+    }
+}
+
+static auto filter_row_v(const u16 *const *src_rows, const MipKernel &kernel, u16 *dst_row, u32 element_count, bool use_simd) -> void {
+    auto e = 0_u32;
+    if (use_simd) {
+#if defined(__AVX2__)
+        auto bias_256 = _mm256_set1_epi32(MIP_WEIGHT_ONE / 2);
+        for (; e + 8 <= element_count; e += 8) {
+            auto acc = _mm256_setzero_si256();
+            for (u32 i = 0; i < kernel.tap_count; i++) {
+                auto values = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src_rows[i] + e)));
+                acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(values, _mm256_set1_epi32(kernel.weights[i])));
+            }
+
+            auto result = _mm256_srai_epi32(_mm256_add_epi32(acc, bias_256), MIP_WEIGHT_BITS);
+            auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0b1000);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_row + e), _mm256_castsi256_si128(packed));
+        }
+#endif
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+        auto bias_128 = _mm_set1_epi32(MIP_WEIGHT_ONE / 2);
+        for (; e + 4 <= element_count; e += 4) {
+            auto acc = _mm_setzero_si128();
+            for (u32 i = 0; i < kernel.tap_count; i++) {
+                auto values = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src_rows[i] + e)));
+                acc = _mm_add_epi32(acc, _mm_mullo_epi32(values, _mm_set1_epi32(kernel.weights[i])));
+            }
+
+            auto result = _mm_srai_epi32(_mm_add_epi32(acc, bias_128), MIP_WEIGHT_BITS);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst_row + e), _mm_packus_epi32(result, result));
+        }
+#endif
+    }
+
+    for (; e < element_count; e++) {
+        auto acc = 0_i32;
+        for (u32 i = 0; i < kernel.tap_count; i++) {
+            acc += kernel.weights[i] * static_cast<i32>(src_rows[i][e]);
+        }
+
+        dst_row[e] = resolve_weighted(acc);
+    }
+}
+
+//  ── LEVEL FIXUPS ────────────────────────────────────────────────────
+// Shared by both paths, they can't differ here.
+static auto renormalize_row(u16 *row, u32 width) -> void {
+    for (u32 x = 0; x < width; x++) {
+        auto *texel = row + x * 4;
+        f32 n[3] = {};
+        for (u32 c = 0; c < 3; c++) {
+            n[c] = static_cast<f32>(texel[c]) / 65535.0f * 2.0f - 1.0f;
+        }
+
+        auto length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length < 1e-6f) {
+            continue;
+        }
+
+        for (u32 c = 0; c < 3; c++) {
+            auto v = std::lround((n[c] / length * 0.5f + 0.5f) * 65535.0f);
+            texel[c] = static_cast<u16>(std::clamp(v, 0L, 65535L));
+        }
+    }
+}
+
+static auto store_row(const u16 *linear_row, u8 *dst_row, u32 width, bool srgb_rgb, const MipTables &tables) -> void {
+    for (u32 x = 0; x < width; x++) {
+        const auto *src = linear_row + x * 4;
+        auto *dst = dst_row + x * 4;
+        for (u32 c = 0; c < 3; c++) {
+            dst[c] = srgb_rgb ? tables.linear_to_srgb[src[c]] : unorm16_to_unorm8(src[c]);
+        }
+        dst[3] = unorm16_to_unorm8(src[3]);
+    }
+}
+
+// `at_least[a]` is count of texels with alpha `>= a`.
+static auto alpha_histogram(ls::span<u16> plane, std::vector<u64> &at_least) -> void {
+    ZoneScoped;
+
+    at_least.assign(65537, 0);
+    for (usize i = 3; i < plane.size(); i += 4) {
+        at_least[plane[i]]++;
+    }
+
+    for (i32 a = 65534; a >= 0; a--) {
+        at_least[a] += at_least[a + 1];
+    }
+}
+
+static auto alpha_coverage(const std::vector<u64> &at_least, f32 threshold, f32 scale) -> u64 {
+    if (scale <= 0.0f) {
+        return 0;
+    }
+
+    auto min_alpha = static_cast<i64>(std::ceil(threshold / scale));
+    return at_least[static_cast<usize>(std::clamp(min_alpha, 0_i64, 65536_i64))];
+}
+
+// Castaño, "Computing Alpha Mipmaps". Filtered alpha is scaled until the
+// same share of texels pass alpha test, thin masks don't fade with distance.
+static auto scale_alpha_coverage(ls::span<u16> plane, u8 *dst_pixels, f32 threshold, f64 base_coverage) -> void {
+    ZoneScoped;
+
+    auto at_least = std::vector<u64>();
+    alpha_histogram(plane, at_least);
+
+    auto texel_count = plane.size() / 4;
+    auto target_count = base_coverage * static_cast<f64>(texel_count);
+    auto low = 0.0f;
+    auto high = 8.0f;
+    for (u32 i = 0; i < 16; i++) {
+        auto mid = (low + high) * 0.5f;
+        if (static_cast<f64>(alpha_coverage(at_least, threshold, mid)) < target_count) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    auto scale = (low + high) * 0.5f;
+    for (usize i = 0; i < texel_count; i++) {
+        auto alpha = std::lround(static_cast<f32>(plane[i * 4 + 3]) * scale);
+        dst_pixels[i * 4 + 3] = unorm16_to_unorm8(static_cast<u32>(std::clamp(alpha, 0L, 65535L)));
+    }
+}
+
+//  ── CHAIN ───────────────────────────────────────────────────────────
+static auto level_size(vuk::Extent3D extent, u32 level) -> u64 {
+    return static_cast<u64>(ls::max(extent.width >> level, 1_u32)) * ls::max(extent.height >> level, 1_u32) * 4;
+}
+
+// `levels[0]` is base level, levels after it are written.
+static auto generate_levels(const MipChainInfo &info, ls::span<ls::span<u8>> levels, bool reference) -> bool {
+    ZoneScoped;
+
+    auto extent = info.extent;
+    auto mip_level_count = MipChain::level_count(extent);
+    if (levels.size() != mip_level_count) {
+        LOG_ERROR("Mip chain of {}x{} has {} levels, not {}!", extent.width, extent.height, mip_level_count, levels.size());
+        return false;
+    }
+
+    for (u32 level = 0; level < mip_level_count; level++) {
+        if (levels[level].size_bytes() < level_size(extent, level)) {
+            LOG_ERROR("Level {} of mip chain is too small ({} < {})!", level, levels[level].size_bytes(), level_size(extent, level));
+            return false;
+        }
+    }
+
+    if (mip_level_count == 1) {
+        return true;
+    }
+
+    const auto &tables = mip_tables();
+    auto kernel = make_kernel(info.filter);
+    auto srgb_rgb = info.srgb && !info.normal;
+    auto parallel = !reference;
+    auto use_simd = !reference;
+
+    // Every level is filtered from the one above in 16 bit linear, not
+    // from its 8 bit output.
+    auto base_pixels = levels[0];
+    auto src_plane = std::vector<u16>(level_size(extent, 0));
+    for_each_row(extent.height, extent.width, parallel, [&](u32 first_row, u32 last_row) {
+        for (auto i = static_cast<usize>(first_row) * extent.width * 4; i < static_cast<usize>(last_row) * extent.width * 4; i++) {
+            auto is_alpha = (i & 3) == 3;
+            src_plane[i] = srgb_rgb && !is_alpha ? tables.srgb_to_linear[base_pixels[i]] : static_cast<u16>(base_pixels[i] * 257);
+        }
+    });
+
+    auto alpha_threshold = info.alpha_cutoff * 65535.0f;
+    auto base_coverage = 0.0;
+    if (info.alpha_cutoff > 0.0f) {
+        auto at_least = std::vector<u64>();
+        alpha_histogram(src_plane, at_least);
+        base_coverage = static_cast<f64>(alpha_coverage(at_least, alpha_threshold, 1.0f)) / static_cast<f64>(extent.width * extent.height);
+    }
+
+    auto h_plane = std::vector<u16>();
+    auto dst_plane = std::vector<u16>();
+    auto src_extent = extent;
+    for (u32 level = 1; level < mip_level_count; level++) {
+        ZoneScoped;
+        ZoneTextF("Mip %u", level);
+
+        auto dst_extent = vuk::Extent3D{
+            .width = ls::max(extent.width >> level, 1_u32),
+            .height = ls::max(extent.height >> level, 1_u32),
+            .depth = 1,
+        };
+        auto *dst_pixels = levels[level].data();
+
+        h_plane.resize(static_cast<usize>(dst_extent.width) * src_extent.height * 4);
+        for_each_row(src_extent.height, src_extent.width, parallel, [&](u32 first_row, u32 last_row) {
+            for (u32 y = first_row; y < last_row; y++) {
+                const auto *src_row = src_plane.data() + static_cast<usize>(y) * src_extent.width * 4;
+                auto *dst_row = h_plane.data() + static_cast<usize>(y) * dst_extent.width * 4;
+                filter_row_h(src_row, src_extent.width, dst_row, dst_extent.width, kernel, use_simd);
+            }
+        });
+
+        dst_plane.resize(static_cast<usize>(dst_extent.width) * dst_extent.height * 4);
+        for_each_row(dst_extent.height, dst_extent.width, parallel, [&](u32 first_row, u32 last_row) {
+            const u16 *src_rows[MIP_MAX_TAP_COUNT] = {};
+            for (u32 y = first_row; y < last_row; y++) {
+                for (u32 i = 0; i < kernel.tap_count; i++) {
+                    auto src_y = std::clamp(static_cast<i32>(y * 2) + kernel.first_tap + static_cast<i32>(i), 0, static_cast<i32>(src_extent.height) - 1);
+                    src_rows[i] = h_plane.data() + static_cast<usize>(src_y) * dst_extent.width * 4;
+                }
+
+                auto *dst_row = dst_plane.data() + static_cast<usize>(y) * dst_extent.width * 4;
+                filter_row_v(src_rows, kernel, dst_row, dst_extent.width * 4, use_simd);
+                if (info.normal) {
+                    renormalize_row(dst_row, dst_extent.width);
+                }
+
+                store_row(dst_row, dst_pixels + static_cast<usize>(y) * dst_extent.width * 4, dst_extent.width, srgb_rgb, tables);
+            }
+        });
+
+        if (info.alpha_cutoff > 0.0f) {
+            scale_alpha_coverage(dst_plane, dst_pixels, alpha_threshold, base_coverage);
+        }
+
+        std::swap(src_plane, dst_plane);
+        src_extent = dst_extent;
+    }
+
+    return true;
+}
+
+static auto generate_mip_chain(ls::span<u8> base_pixels, const MipChainInfo &info, bool reference) -> MipChain {
+    ZoneScoped;
+
+    auto extent = info.extent;
+    auto chain = MipChain{};
+    chain.extent = extent;
+    chain.mip_level_count = MipChain::level_count(extent);
+    chain.level_offsets.resize(chain.mip_level_count);
+
+    auto pixels_size = 0_u64;
+    for (u32 level = 0; level < chain.mip_level_count; level++) {
+        chain.level_offsets[level] = pixels_size;
+        pixels_size += level_size(extent, level);
+    }
+
+    auto base_size = level_size(extent, 0);
+    if (base_pixels.size_bytes() < base_size) {
+        LOG_ERROR("Base level of mip chain is too small ({} < {})!", base_pixels.size_bytes(), base_size);
+        return {};
+    }
+
+    chain.pixels.resize(pixels_size);
+    std::memcpy(chain.pixels.data(), base_pixels.data(), base_size);
+
+    auto levels = std::vector<ls::span<u8>>(chain.mip_level_count);
+    for (u32 level = 0; level < chain.mip_level_count; level++) {
+        levels[level] = chain.level_data(level);
+    }
+
+    generate_levels(info, levels, reference);
+
+    return chain;
+}
+
+auto MipChain::level_count(vuk::Extent3D extent) -> u32 {
+    return static_cast<u32>(std::bit_width(ls::max(ls::max(extent.width, extent.height), 1_u32)));
+}
+
+auto MipChain::generate(ls::span<u8> base_pixels, const MipChainInfo &info) -> MipChain {
+    ZoneScoped;
+
+    return generate_mip_chain(base_pixels, info, false);
+}
+
+auto MipChain::generate_into(const MipChainInfo &info, ls::span<ls::span<u8>> levels) -> bool {
+    ZoneScoped;
+
+    return generate_levels(info, levels, false);
+}
+
+auto MipChain::generate_reference(ls::span<u8> base_pixels, const MipChainInfo &info) -> MipChain {
+    ZoneScoped;
+
+    return generate_mip_chain(base_pixels, info, true);
+}
+
+auto MipChain::level_data(this MipChain &self, u32 level) -> ls::span<u8> {
+    LS_EXPECT(level < self.mip_level_count);
+
+    auto level_end = level + 1 < self.mip_level_count ? self.level_offsets[level + 1] : self.pixels.size();
+    return ls::span<u8>(self.pixels.data() + self.level_offsets[level], level_end - self.level_offsets[level]);
+}
+} // namespace lr
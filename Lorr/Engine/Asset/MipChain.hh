@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Engine/Graphics/VulkanTypes.hh"
+
+namespace lr {
+enum class MipFilter : u32 {
+    // 2x2 average.
+    Box = 0,
+    // Kaiser windowed sinc over 6x6 texels, keeps more detail.
+    Kaiser,
+};
+
+struct MipChainInfo {
+    vuk::Extent3D extent = {};
+    MipFilter filter = MipFilter::Kaiser;
+    // RGB is sRGB encoded, it is filtered in linear space.
+    bool srgb = true;
+    // RGB is a tangent space normal, renormalized every level. Always linear.
+    bool normal = false;
+    // Alpha test threshold of masked materials, 0 disables. Alpha of every
+    // level is scaled so the same share of texels pass as in base level.
+    f32 alpha_cutoff = 0.0f;
+};
+
+// CPU generated mips of RGBA8 images. Levels are filtered in 16 bit linear
+// fixed point, rows of each level are spread over job manager.
+struct MipChain {
+    vuk::Extent3D extent = {};
+    u32 mip_level_count = 0;
+    // Every level tightly packed, base level first.
+    std::vector<u8> pixels = {};
+    std::vector<u64> level_offsets = {};
+
+    static auto level_count(vuk::Extent3D extent) -> u32;
+    // `base_pixels` is base level, RGBA8 of `info.extent`.
+    static auto generate(ls::span<u8> base_pixels, const MipChainInfo &info) -> MipChain;
+    // Same as `generate` without a copy of its own. `levels[0]` holds base
+    // level, every level after it is written to its span, which can be
+    // mapped staging memory. Needs `level_count(info.extent)` levels.
+    static auto generate_into(const MipChainInfo &info, ls::span<ls::span<u8>> levels) -> bool;
+    // Plain scalar code on calling thread, `generate` output must be the
+    // same byte for byte.
+    static auto generate_reference(ls::span<u8> base_pixels, const MipChainInfo &info) -> MipChain;
+
+    auto level_data(this MipChain &, u32 level) -> ls::span<u8>;
+};
+} // namespace lr
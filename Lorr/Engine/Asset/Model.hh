@@ -14,11 +14,26 @@ struct TextureSamplerInfo {
     vuk::SamplerAddressMode address_v = vuk::SamplerAddressMode::eRepeat;
 };
 
+// What channels of a texture are used for, transcoded formats keep only those.
+enum class TextureKind : u32 {
+    Color = 0,
+    // XY in RG, Z is reconstructed.
+    Normal,
+    // Single channel in R.
+    Mask,
+};
+
 struct TextureInfo {
     bool use_srgb = true;
+    TextureKind kind = TextureKind::Color;
+    // Alpha test threshold of masked material using it, mips of cooked
+    // textures keep the same alpha coverage.
+    f32 alpha_cutoff = 0.0f;
 
     std::vector<u8> embedded_data = {}; // Optional
     AssetFileType file_type = AssetFileType::None; // Optional
+    // Only mip tail is loaded, rest is left to `TextureStreamer`.
+    bool streamed = false;
 };
 
 enum class TextureID : u64 { Invalid = std::numeric_limits<u64>::max() };
@@ -51,11 +66,11 @@ struct Material {
 
 struct MaterialInfo {
     Material material = {};
-    TextureInfo albedo_texture_info = {};
-    TextureInfo normal_texture_info = {};
-    TextureInfo emissive_texture_info = {};
-    TextureInfo metallic_roughness_texture_info = {};
-    TextureInfo occlusion_texture_info = {};
+    TextureInfo albedo_texture_info = { .streamed = true };
+    TextureInfo normal_texture_info = { .kind = TextureKind::Normal, .streamed = true };
+    TextureInfo emissive_texture_info = { .streamed = true };
+    TextureInfo metallic_roughness_texture_info = { .streamed = true };
+    TextureInfo occlusion_texture_info = { .kind = TextureKind::Mask, .streamed = true };
 };
 
 enum class ModelID : u64 { Invalid = std::numeric_limits<u64>::max() };
@@ -100,8 +115,19 @@ struct Model {
     std::vector<Scene> scenes = {};
 
     std::vector<GPU::Mesh> gpu_meshes = {};
+    // Vertex data and every LOD that isn't streamed separately.
     std::vector<Buffer> gpu_mesh_buffers = {};
+    // Key of each one in `AssetManager::shared_mesh_buffers`, 0 when it
+    // isn't shared.
+    std::vector<u64> gpu_mesh_buffer_hashes = {};
+    // Streamed in LODs, invalid while not resident. See `MeshStreamer`.
+    std::vector<std::array<Buffer, GPU::Mesh::MAX_LODS>> gpu_lod_buffers = {};
+    // Same as `gpu_mesh_buffer_hashes`, for `gpu_lod_buffers`.
+    std::vector<std::array<u64, GPU::Mesh::MAX_LODS>> gpu_lod_buffer_hashes = {};
 
     usize default_scene_index = 0;
+    // Meta file opt out of vertex quantization, for assets that need exact
+    // positions or have texcoords half floats can't hold.
+    bool full_precision_vertices = false;
 };
 } // namespace lr
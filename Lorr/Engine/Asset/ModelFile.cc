@@ -0,0 +1,530 @@
+#include "Engine/Asset/ModelFile.hh"
+
+#include "Engine/Core/App.hh"
+
+#include "Engine/Memory/Hasher.hh"
+
+#include <meshoptimizer.h>
+
+namespace lr {
+//  ── STREAM CODECS ───────────────────────────────────────────────────
+// Streams of a decoded payload in the order `cook_primitive` writes them.
+static auto split_payload_streams(const GPU::Mesh &gpu_mesh, u64 payload_size) -> std::vector<ModelFileStream> {
+    ZoneScoped;
+
+    struct StreamStart {
+        u64 offset = 0;
+        ModelFileStreamCodec codec = ModelFileStreamCodec::None;
+        // Zero for vertex streams, stride depends on quantization.
+        u32 element_size = 0;
+    };
+
+    auto starts = std::vector<StreamStart>();
+    starts.push_back({ .offset = gpu_mesh.vertex_positions, .codec = ModelFileStreamCodec::Vertex });
+    starts.push_back({ .offset = gpu_mesh.vertex_normals, .codec = ModelFileStreamCodec::Vertex });
+    if (gpu_mesh.texture_coords != 0) {
+        starts.push_back({ .offset = gpu_mesh.texture_coords, .codec = ModelFileStreamCodec::Vertex });
+    }
+
+    for (u32 lod_index = 0; lod_index < gpu_mesh.lod_count; lod_index++) {
+        const auto &lod = gpu_mesh.lods[lod_index];
+        starts.push_back({ .offset = lod.indices, .codec = ModelFileStreamCodec::Index, .element_size = sizeof(u32) });
+        starts.push_back({ .offset = lod.meshlets, .codec = ModelFileStreamCodec::Vertex, .element_size = sizeof(GPU::Meshlet) });
+        starts.push_back({ .offset = lod.meshlet_bounds, .codec = ModelFileStreamCodec::Vertex, .element_size = sizeof(GPU::Bounds) });
+        starts.push_back({ .offset = lod.meshlet_errors, .codec = ModelFileStreamCodec::Vertex, .element_size = sizeof(GPU::MeshletError) });
+        // Triangles of a meshlet are padded to 4 bytes, vertex codec
+        // compresses them as u8x4 elements.
+        starts.push_back({ .offset = lod.local_triangle_indices, .codec = ModelFileStreamCodec::Vertex, .element_size = 4 });
+        starts.push_back({ .offset = lod.indirect_vertex_indices, .codec = ModelFileStreamCodec::IndexSequence, .element_size = sizeof(u32) });
+    }
+
+    auto streams = std::vector<ModelFileStream>();
+    for (usize i = 0; i < starts.size(); i++) {
+        const auto &start = starts[i];
+        auto end = i + 1 < starts.size() ? starts[i + 1].offset : payload_size;
+        auto &stream = streams.emplace_back();
+        stream.offset = start.offset;
+        stream.size = end - start.offset;
+        stream.codec = start.codec;
+        stream.element_size = start.element_size;
+        if (stream.element_size == 0 && gpu_mesh.vertex_count != 0) {
+            stream.element_size = static_cast<u32>(stream.size / gpu_mesh.vertex_count);
+        }
+
+        // Vertex codec takes strides of 4 up to 256 bytes, index codec
+        // takes whole triangles.
+        auto encodable = stream.element_size != 0 && stream.size % stream.element_size == 0;
+        if (stream.codec == ModelFileStreamCodec::Vertex) {
+            encodable &= stream.element_size % 4 == 0 && stream.element_size <= 256;
+        } else if (stream.codec == ModelFileStreamCodec::Index) {
+            encodable &= (stream.size / stream.element_size) % 3 == 0;
+        }
+
+        if (!encodable) {
+            stream.codec = ModelFileStreamCodec::None;
+            stream.element_size = 1;
+        }
+
+        stream.element_count = static_cast<u32>(stream.size / stream.element_size);
+    }
+
+    return streams;
+}
+
+static auto encode_stream(ModelFileStream &stream, ls::span<u8> payload, u32 vertex_count, std::vector<u8> &encoded_payload) -> void {
+    ZoneScoped;
+
+    const auto *src = payload.data() + stream.offset;
+    const auto *src_indices = reinterpret_cast<const u32 *>(src);
+    auto encoded = std::vector<u8>();
+    switch (stream.codec) {
+        case ModelFileStreamCodec::Vertex: {
+            encoded.resize(meshopt_encodeVertexBufferBound(stream.element_count, stream.element_size));
+            encoded.resize(meshopt_encodeVertexBuffer(encoded.data(), encoded.size(), src, stream.element_count, stream.element_size));
+        } break;
+        case ModelFileStreamCodec::Index: {
+            encoded.resize(meshopt_encodeIndexBufferBound(stream.element_count, vertex_count));
+            encoded.resize(meshopt_encodeIndexBuffer(encoded.data(), encoded.size(), src_indices, stream.element_count));
+        } break;
+        case ModelFileStreamCodec::IndexSequence: {
+            encoded.resize(meshopt_encodeIndexSequenceBound(stream.element_count, vertex_count));
+            encoded.resize(meshopt_encodeIndexSequence(encoded.data(), encoded.size(), src_indices, stream.element_count));
+        } break;
+        case ModelFileStreamCodec::None:;
+    }
+
+    // Encoders return zero when they fail.
+    if (encoded.empty() || encoded.size() >= stream.size) {
+        stream.codec = ModelFileStreamCodec::None;
+        stream.element_count = static_cast<u32>(stream.size);
+        stream.element_size = 1;
+        encoded.assign(src, src + stream.size);
+    }
+
+    stream.encoded_offset = encoded_payload.size();
+    stream.encoded_size = encoded.size();
+    encoded_payload.insert(encoded_payload.end(), encoded.begin(), encoded.end());
+}
+
+static auto decode_stream(const ModelFileStream &stream, ls::span<u8> encoded_payload, u8 *dst) -> bool {
+    ZoneScoped;
+
+    const auto *src = encoded_payload.data() + stream.encoded_offset;
+    auto *dst_indices = reinterpret_cast<u32 *>(dst);
+    switch (stream.codec) {
+        case ModelFileStreamCodec::None: {
+            std::memcpy(dst, src, stream.size);
+            return true;
+        }
+        case ModelFileStreamCodec::Vertex: {
+            return meshopt_decodeVertexBuffer(dst, stream.element_count, stream.element_size, src, stream.encoded_size) == 0;
+        }
+        case ModelFileStreamCodec::Index: {
+            return meshopt_decodeIndexBuffer(dst_indices, stream.element_count, sizeof(u32), src, stream.encoded_size) == 0;
+        }
+        case ModelFileStreamCodec::IndexSequence: {
+            return meshopt_decodeIndexSequence(dst_indices, stream.element_count, sizeof(u32), src, stream.encoded_size) == 0;
+        }
+    }
+
+    return false;
+}
+
+// Streams are validated here once, decoding trusts them afterwards.
+static auto read_file_primitive(ls::span<u8> file_data, const ModelFilePrimitive &file_primitive) -> ls::option<CookedPrimitive> {
+    auto encoded_payload = get_asset_file_section<u8>(file_data, file_primitive.payload_offset, file_primitive.payload_size);
+    auto streams = get_asset_file_section<ModelFileStream>(file_data, file_primitive.streams_offset, file_primitive.stream_count);
+    if (!encoded_payload || !streams) {
+        return ls::nullopt;
+    }
+
+    auto decoded_size = 0_u64;
+    for (const auto &stream : streams.value()) {
+        auto valid_codec = stream.codec <= ModelFileStreamCodec::IndexSequence;
+        auto valid_size = static_cast<u64>(stream.element_count) * stream.element_size == stream.size
+            && (stream.codec != ModelFileStreamCodec::None || stream.encoded_size == stream.size);
+        auto valid_indices = (stream.codec != ModelFileStreamCodec::Index && stream.codec != ModelFileStreamCodec::IndexSequence)
+            || stream.element_size == sizeof(u32);
+        if (stream.offset != decoded_size || !valid_codec || !valid_size || !valid_indices || stream.encoded_offset > encoded_payload->size()
+            || stream.encoded_size > encoded_payload->size() - stream.encoded_offset)
+        {
+            return ls::nullopt;
+        }
+
+        decoded_size += stream.size;
+    }
+
+    if (decoded_size != file_primitive.decoded_payload_size) {
+        return ls::nullopt;
+    }
+
+    return CookedPrimitive{
+        .material_index = file_primitive.material_index,
+        .index_count = file_primitive.index_count,
+        .gpu_mesh = file_primitive.gpu_mesh,
+        .payload_size = file_primitive.decoded_payload_size,
+        .payload_hash = file_primitive.decoded_payload_hash,
+        .streams = streams.value(),
+        .encoded_payload = encoded_payload.value(),
+    };
+}
+
+auto CookedPrimitive::read_payload(this const CookedPrimitive &self, u64 offset, ls::span<u8> dst) -> bool {
+    ZoneScoped;
+
+    if (offset > self.payload_size || dst.size() > self.payload_size - offset) {
+        return false;
+    }
+
+    if (!self.payload.empty()) {
+        std::memcpy(dst.data(), self.payload.data() + offset, dst.size());
+        return true;
+    }
+
+    auto end = offset + dst.size();
+    auto streams = self.payload_streams(offset, dst.size());
+    if (!dst.empty() && (streams.empty() || streams.front().offset != offset)) {
+        LOG_ERROR("Payload range [{}, {}) doesn't start at a stream boundary!", offset, end);
+        return false;
+    }
+
+    for (const auto &stream : streams) {
+        if (stream.offset + stream.size > end) {
+            LOG_ERROR("Payload range [{}, {}) doesn't end at a stream boundary!", offset, end);
+            return false;
+        }
+
+        if (!decode_stream(stream, self.encoded_payload, dst.data() + (stream.offset - offset))) {
+            LOG_ERROR("Failed to decode mesh stream at {}!", stream.offset);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+auto CookedPrimitive::payload_streams(this const CookedPrimitive &self, u64 offset, u64 size) -> ls::span<ModelFileStream> {
+    auto first = std::ranges::lower_bound(self.streams, offset, {}, &ModelFileStream::offset);
+    auto last = std::ranges::lower_bound(first, self.streams.end(), offset + size, {}, &ModelFileStream::offset);
+    return { first, last };
+}
+auto ModelFile::params_hash(const Model &model) -> u64 {
+    ZoneScoped;
+
+    auto hasher = HasherXXH64();
+    auto hash_value = [&hasher](const auto &value) { hasher.hash(&value, sizeof(value)); };
+    hash_value(VERSION);
+    hash_value(Model::MAX_MESHLET_INDICES);
+    hash_value(Model::MAX_MESHLET_PRIMITIVES);
+    hash_value(GPU::Mesh::MAX_LODS);
+    hash_value(sizeof(GPU::Mesh));
+    hash_value(model.full_precision_vertices);
+    // Cooked file refers to materials of its meta file
+    for (const auto &material_uuid : model.materials) {
+        hash_value(material_uuid.bytes());
+    }
+
+    return hasher.value();
+}
+
+auto ModelFile::from_data(DerivedData derived_data) -> ls::option<ModelFile> {
+    ZoneScoped;
+
+    if (!is_asset_file_header_valid(derived_data.data, AssetType::Model, VERSION)) {
+        LOG_WARN("Cooked model data is corrupt or out of date.");
+        return ls::nullopt;
+    }
+
+    return ModelFile{ .derived_data = std::move(derived_data) };
+}
+
+auto ModelFile::serialize(const Model &model, ls::span<CookedPrimitive> primitives) -> std::vector<u8> {
+    ZoneScoped;
+
+    auto header = AssetFileHeader{};
+    header.version = VERSION;
+    header.type = AssetType::Model;
+
+    //  ── FLATTEN ─────────────────────────────────────────────────────────
+    auto index_pool = std::vector<u32>();
+    auto string_pool = std::string();
+    auto push_string = [&](std::string_view str) {
+        auto file_string = ModelFileString{ .offset = static_cast<u32>(string_pool.size()), .length = static_cast<u32>(str.size()) };
+        string_pool.append(str);
+        return file_string;
+    };
+    auto push_indices = [&](const auto &indices) {
+        auto file_range = ModelFileRange{ .offset = static_cast<u32>(index_pool.size()), .count = static_cast<u32>(indices.size()) };
+        for (auto index : indices) {
+            index_pool.push_back(static_cast<u32>(index));
+        }
+        return file_range;
+    };
+
+    // Primitives are encoded in parallel, same as they are cooked.
+    auto primitive_streams = std::vector<std::vector<ModelFileStream>>(primitives.size());
+    auto encoded_payloads = std::vector<std::vector<u8>>(primitives.size());
+    App::get().job_man.parallel_for(static_cast<u32>(primitives.size()), 1, [&](u32 first_primitive, u32 last_primitive) {
+        for (auto i = first_primitive; i < last_primitive; i++) {
+            const auto &primitive = primitives[i];
+            primitive_streams[i] = split_payload_streams(primitive.gpu_mesh, primitive.payload.size());
+            for (auto &stream : primitive_streams[i]) {
+                encode_stream(stream, primitive.payload, primitive.gpu_mesh.vertex_count, encoded_payloads[i]);
+            }
+        }
+    });
+
+    auto payload_size = 0_u64;
+    auto encoded_payload_size = 0_u64;
+    auto file_primitives = std::vector<ModelFilePrimitive>();
+    for (const auto &[primitive, streams, encoded_payload] : std::views::zip(primitives, primitive_streams, encoded_payloads)) {
+        file_primitives.push_back(
+            { .material_index = primitive.material_index,
+              .index_count = primitive.index_count,
+              .payload_offset = 0,
+              .payload_size = encoded_payload.size(),
+              .decoded_payload_size = primitive.payload.size(),
+              .decoded_payload_hash = primitive.payload_hash,
+              .streams_offset = 0,
+              .stream_count = static_cast<u32>(streams.size()),
+              .gpu_mesh = primitive.gpu_mesh }
+        );
+        payload_size += primitive.payload.size();
+        encoded_payload_size += encoded_payload.size();
+    }
+
+    if (payload_size != 0) {
+        LOG_TRACE(
+            "Encoded model geometry, {} KiB -> {} KiB ({:.1f}%).",
+            payload_size / 1024,
+            encoded_payload_size / 1024,
+            100.0 * static_cast<f64>(encoded_payload_size) / static_cast<f64>(payload_size)
+        );
+    }
+
+    auto file_meshes = std::vector<ModelFileMesh>();
+    for (const auto &mesh : model.meshes) {
+        file_meshes.push_back({ .name = push_string(mesh.name), .primitive_indices = push_indices(mesh.primitive_indices) });
+    }
+
+    auto file_nodes = std::vector<ModelFileNode>();
+    for (const auto &node : model.nodes) {
+        file_nodes.push_back(
+            { .name = push_string(node.name),
+              .child_indices = push_indices(node.child_indices),
+              .mesh_index = node.mesh_index.has_value() ? static_cast<u32>(node.mesh_index.value()) : ModelFileNode::NO_MESH,
+              .translation = node.translation,
+              .rotation = node.rotation,
+              .scale = node.scale }
+        );
+    }
+
+    auto file_scenes = std::vector<ModelFileScene>();
+    for (const auto &scene : model.scenes) {
+        file_scenes.push_back({ .name = push_string(scene.name), .node_indices = push_indices(scene.node_indices) });
+    }
+
+    auto file_materials = std::vector<std::array<u8, 16>>();
+    for (const auto &material_uuid : model.materials) {
+        file_materials.push_back(material_uuid.bytes());
+    }
+
+    //  ── LAYOUT ──────────────────────────────────────────────────────────
+    auto &model_header = header.model_header;
+    model_header = {};
+    model_header.primitive_count = static_cast<u32>(file_primitives.size());
+    model_header.mesh_count = static_cast<u32>(file_meshes.size());
+    model_header.node_count = static_cast<u32>(file_nodes.size());
+    model_header.scene_count = static_cast<u32>(file_scenes.size());
+    model_header.material_count = static_cast<u32>(file_materials.size());
+    model_header.default_scene_index = static_cast<u32>(model.default_scene_index);
+
+    auto file_size = align_asset_file_offset(sizeof(AssetFileHeader));
+    auto place_section = [&file_size](u64 section_size) {
+        auto section_offset = file_size;
+        file_size = align_asset_file_offset(file_size + section_size);
+        return section_offset;
+    };
+    model_header.primitives_offset = place_section(ls::size_bytes(file_primitives));
+    model_header.meshes_offset = place_section(ls::size_bytes(file_meshes));
+    model_header.nodes_offset = place_section(ls::size_bytes(file_nodes));
+    model_header.scenes_offset = place_section(ls::size_bytes(file_scenes));
+    model_header.materials_offset = place_section(ls::size_bytes(file_materials));
+    model_header.indices_offset = place_section(ls::size_bytes(index_pool));
+    model_header.strings_offset = place_section(string_pool.size());
+    for (auto &file_primitive : file_primitives) {
+        file_primitive.streams_offset = place_section(file_primitive.stream_count * sizeof(ModelFileStream));
+        file_primitive.payload_offset = place_section(file_primitive.payload_size);
+    }
+
+    //  ── SERIALIZE ───────────────────────────────────────────────────────
+    auto contents = std::vector<u8>(file_size, 0);
+    auto write_section = [&contents](u64 offset, const void *data, u64 size) {
+        if (size != 0) {
+            std::memcpy(contents.data() + offset, data, size);
+        }
+    };
+    write_section(0, &header, sizeof(AssetFileHeader));
+    write_section(model_header.primitives_offset, file_primitives.data(), ls::size_bytes(file_primitives));
+    write_section(model_header.meshes_offset, file_meshes.data(), ls::size_bytes(file_meshes));
+    write_section(model_header.nodes_offset, file_nodes.data(), ls::size_bytes(file_nodes));
+    write_section(model_header.scenes_offset, file_scenes.data(), ls::size_bytes(file_scenes));
+    write_section(model_header.materials_offset, file_materials.data(), ls::size_bytes(file_materials));
+    write_section(model_header.indices_offset, index_pool.data(), ls::size_bytes(index_pool));
+    write_section(model_header.strings_offset, string_pool.data(), string_pool.size());
+    for (const auto &[file_primitive, streams, encoded_payload] : std::views::zip(file_primitives, primitive_streams, encoded_payloads)) {
+        write_section(file_primitive.streams_offset, streams.data(), ls::size_bytes(streams));
+        write_section(file_primitive.payload_offset, encoded_payload.data(), encoded_payload.size());
+    }
+
+    return contents;
+}
+
+auto ModelFile::header(this ModelFile &self) -> const AssetFileHeader & {
+    return *reinterpret_cast<const AssetFileHeader *>(self.derived_data.data.data());
+}
+
+auto ModelFile::read(this ModelFile &self, Model &model, std::vector<CookedPrimitive> &primitives) -> bool {
+    ZoneScoped;
+
+    auto file_data = self.derived_data.data;
+    const auto &model_header = self.header().model_header;
+
+    auto file_primitives = get_asset_file_section<ModelFilePrimitive>(file_data, model_header.primitives_offset, model_header.primitive_count);
+    auto file_meshes = get_asset_file_section<ModelFileMesh>(file_data, model_header.meshes_offset, model_header.mesh_count);
+    auto file_nodes = get_asset_file_section<ModelFileNode>(file_data, model_header.nodes_offset, model_header.node_count);
+    auto file_scenes = get_asset_file_section<ModelFileScene>(file_data, model_header.scenes_offset, model_header.scene_count);
+    auto file_materials = get_asset_file_section<std::array<u8, 16>>(file_data, model_header.materials_offset, model_header.material_count);
+    if (!file_primitives || !file_meshes || !file_nodes || !file_scenes || !file_materials || model_header.indices_offset > file_data.size()
+        || model_header.strings_offset > file_data.size()) {
+        LOG_WARN("Cooked model has corrupt sections.");
+        return false;
+    }
+
+    // Meta file owns materials, cooked file only refers to them by index.
+    if (file_materials->size() != model.materials.size()) {
+        return false;
+    }
+
+    for (const auto &[material_bytes, material_uuid] : std::views::zip(file_materials.value(), model.materials)) {
+        if (material_bytes != material_uuid.bytes()) {
+            return false;
+        }
+    }
+
+    // Pools run until the next section, lengths are checked per access.
+    const auto *index_pool = reinterpret_cast<const u32 *>(file_data.data() + model_header.indices_offset);
+    const auto *string_pool = reinterpret_cast<const c8 *>(file_data.data() + model_header.strings_offset);
+    auto index_pool_size = (file_data.size() - model_header.indices_offset) / sizeof(u32);
+    auto string_pool_size = file_data.size() - model_header.strings_offset;
+    auto to_string = [&](const ModelFileString &str) -> ls::option<std::string> {
+        if (str.offset > string_pool_size || str.length > string_pool_size - str.offset) {
+            return ls::nullopt;
+        }
+
+        return std::string(string_pool + str.offset, str.length);
+    };
+    auto to_indices = [&]<typename T>(const ModelFileRange &range, std::vector<T> &indices) -> bool {
+        if (range.offset > index_pool_size || range.count > index_pool_size - range.offset) {
+            return false;
+        }
+
+        const auto *first = index_pool + range.offset;
+        indices.assign(first, first + range.count);
+        return true;
+    };
+
+    for (const auto &file_primitive : file_primitives.value()) {
+        auto primitive = read_file_primitive(file_data, file_primitive);
+        if (!primitive || file_primitive.material_index >= model.materials.size()) {
+            return false;
+        }
+
+        primitives.push_back(primitive.value());
+    }
+
+    for (const auto &file_mesh : file_meshes.value()) {
+        auto &mesh = model.meshes.emplace_back();
+        auto name = to_string(file_mesh.name);
+        if (!name || !to_indices(file_mesh.primitive_indices, mesh.primitive_indices)) {
+            return false;
+        }
+
+        mesh.name = std::move(name.value());
+    }
+
+    for (const auto &file_node : file_nodes.value()) {
+        auto &node = model.nodes.emplace_back();
+        auto name = to_string(file_node.name);
+        if (!name || !to_indices(file_node.child_indices, node.child_indices)) {
+            return false;
+        }
+
+        node.name = std::move(name.value());
+        if (file_node.mesh_index != ModelFileNode::NO_MESH) {
+            node.mesh_index = file_node.mesh_index;
+        }
+        node.translation = file_node.translation;
+        node.rotation = file_node.rotation;
+        node.scale = file_node.scale;
+    }
+
+    for (const auto &file_scene : file_scenes.value()) {
+        auto &scene = model.scenes.emplace_back();
+        auto name = to_string(file_scene.name);
+        if (!name || !to_indices(file_scene.node_indices, scene.node_indices)) {
+            return false;
+        }
+
+        scene.name = std::move(name.value());
+    }
+
+    // Indices are used unchecked after loading, anything out of range
+    // means the file is corrupt.
+    auto is_in_range = [](const auto &indices, usize count) {
+        return std::ranges::all_of(indices, [count](auto index) { return index < count; });
+    };
+    for (const auto &mesh : model.meshes) {
+        if (!is_in_range(mesh.primitive_indices, primitives.size())) {
+            LOG_WARN("Cooked model has out of range primitive index.");
+            return false;
+        }
+    }
+
+    for (const auto &node : model.nodes) {
+        if (!is_in_range(node.child_indices, model.nodes.size()) || (node.mesh_index.has_value() && node.mesh_index.value() >= model.meshes.size())) {
+            LOG_WARN("Cooked model has out of range node or mesh index.");
+            return false;
+        }
+    }
+
+    for (const auto &scene : model.scenes) {
+        if (!is_in_range(scene.node_indices, model.nodes.size())) {
+            LOG_WARN("Cooked model has out of range node index.");
+            return false;
+        }
+    }
+
+    if (!model.scenes.empty() && model_header.default_scene_index >= model.scenes.size()) {
+        LOG_WARN("Cooked model has out of range default scene.");
+        return false;
+    }
+
+    model.default_scene_index = model_header.default_scene_index;
+
+    return true;
+}
+
+auto ModelFile::read_primitive(this ModelFile &self, u32 primitive_index) -> ls::option<CookedPrimitive> {
+    ZoneScoped;
+
+    auto file_data = self.derived_data.data;
+    const auto &model_header = self.header().model_header;
+    auto file_primitives = get_asset_file_section<ModelFilePrimitive>(file_data, model_header.primitives_offset, model_header.primitive_count);
+    if (!file_primitives || primitive_index >= file_primitives->size()) {
+        return ls::nullopt;
+    }
+
+    return read_file_primitive(file_data, file_primitives.value()[primitive_index]);
+}
+} // namespace lr
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Engine/Asset/DerivedDataCache.hh"
+#include "Engine/Asset/Model.hh"
+
+namespace lr {
+enum class ModelFileStreamCodec : u32 {
+    // Stored as is, codec wouldn't make it smaller.
+    None = 0,
+    // `meshopt_encodeVertexBuffer`
+    Vertex,
+    // `meshopt_encodeIndexBuffer`, triangle list
+    Index,
+    // `meshopt_encodeIndexSequence`
+    IndexSequence,
+};
+
+// Single array of a primitive payload, vertex stream or a section of a
+// LOD. Streams cover the whole payload one after another.
+struct ModelFileStream {
+    // Into decoded payload
+    u64 offset = 0;
+    u64 size = 0;
+    // Into encoded payload of the primitive
+    u64 encoded_offset = 0;
+    u64 encoded_size = 0;
+    u32 element_count = 0;
+    u32 element_size = 0;
+    ModelFileStreamCodec codec = ModelFileStreamCodec::None;
+    u32 padding = 0;
+};
+
+// GPU ready geometry of a single primitive. Payload is uploaded as is,
+// addresses inside `gpu_mesh` are offsets into the payload until they get
+// patched with device address of the mesh buffer.
+struct CookedPrimitive {
+    u32 material_index = 0;
+    u32 index_count = 0;
+    GPU::Mesh gpu_mesh = {};
+    u64 payload_size = 0;
+    // XXH3 of decoded payload, same for cooked and read primitives.
+    u64 payload_hash = 0;
+    // Freshly cooked primitives have their payload decoded.
+    ls::span<u8> payload = {};
+    // Read ones point into codec encoded streams of the `ModelFile`.
+    ls::span<ModelFileStream> streams = {};
+    ls::span<u8> encoded_payload = {};
+
+    // Decodes `[offset, offset + dst.size())` of payload into `dst`, range
+    // must start and end at stream boundaries. LOD ranges and vertex data
+    // always do.
+    auto read_payload(this const CookedPrimitive &, u64 offset, ls::span<u8> dst) -> bool;
+    // Streams `read_payload` decodes for that range, one job each. Empty
+    // for decoded payloads.
+    auto payload_streams(this const CookedPrimitive &, u64 offset, u64 size) -> ls::span<ModelFileStream>;
+};
+
+struct ModelFileString {
+    u32 offset = 0;
+    u32 length = 0;
+};
+
+// Range of the shared u32 index pool.
+struct ModelFileRange {
+    u32 offset = 0;
+    u32 count = 0;
+};
+
+struct ModelFilePrimitive {
+    u32 material_index = 0;
+    u32 index_count = 0;
+    // Encoded streams
+    u64 payload_offset = 0;
+    u64 payload_size = 0;
+    u64 decoded_payload_size = 0;
+    u64 decoded_payload_hash = 0;
+    u64 streams_offset = 0;
+    u32 stream_count = 0;
+    u32 padding = 0;
+    GPU::Mesh gpu_mesh = {};
+};
+
+struct ModelFileMesh {
+    ModelFileString name = {};
+    ModelFileRange primitive_indices = {};
+};
+
+struct ModelFileNode {
+    constexpr static auto NO_MESH = ~0_u32;
+
+    ModelFileString name = {};
+    ModelFileRange child_indices = {};
+    u32 mesh_index = NO_MESH;
+    glm::vec3 translation = {};
+    glm::quat rotation = {};
+    glm::vec3 scale = {};
+};
+
+struct ModelFileScene {
+    ModelFileString name = {};
+    ModelFileRange node_indices = {};
+};
+
+// Cooked model, lives in `DerivedDataCache`. Everything `load_model` needs
+// after meshopt processing lives here so loading is a single cache lookup
+// and a copy per primitive.
+//
+// AssetFileHeader
+// ModelFilePrimitive[primitive_count]
+// ModelFileMesh[mesh_count]
+// ModelFileNode[node_count]
+// ModelFileScene[scene_count]
+// u8[16][material_count] -- Material UUIDs, must match the meta file
+// u32[]                  -- Index pool
+// c8[]                   -- String pool
+// ModelFileStream[], u8[] -- Streams and encoded payload of each primitive
+//
+// Payload streams are compressed with meshoptimizer codecs, they decode
+// straight into staging memory at several GB/s.
+//
+// Every section and payload is 16 byte aligned. Bump `VERSION` whenever
+// layout or cooking code changes, cooking parameters are part of
+// `params_hash`.
+struct ModelFile {
+    constexpr static u16 VERSION = 8;
+
+    DerivedData derived_data = {};
+
+    // Everything other than source contents that changes cooked output.
+    static auto params_hash(const Model &model) -> u64;
+
+    // Returns nullopt when data isn't a cooked model of current version.
+    static auto from_data(DerivedData derived_data) -> ls::option<ModelFile>;
+    // `primitives` must have their payloads decoded, as cooking leaves them.
+    static auto serialize(const Model &model, ls::span<CookedPrimitive> primitives) -> std::vector<u8>;
+
+    auto header(this ModelFile &) -> const AssetFileHeader &;
+    // Fills meshes and hierarchy of `model`, `materials` of model must be
+    // populated already. Returned payloads point into `derived_data`.
+    auto read(this ModelFile &, Model &model, std::vector<CookedPrimitive> &primitives) -> bool;
+    // Single primitive without the rest of the model, used to stream LODs in.
+    auto read_primitive(this ModelFile &, u32 primitive_index) -> ls::option<CookedPrimitive>;
+};
+} // namespace lr
@@ -78,7 +78,90 @@ static auto to_asset_file_type(fastgltf::MimeType mime) -> AssetFileType {
     }
 }
 
-auto GLTFModelInfo::parse(const fs::path &path, GLTFModelCallbacks callbacks) -> ls::option<GLTFModelInfo> {
+// Whole accessor into `dst`, fastgltf does a single `memcpy` when its
+// component type and stride already match `T`, converting loop otherwise.
+template<typename T>
+static auto copy_accessor(const fastgltf::Asset &asset, const fastgltf::Accessor &accessor, ls::span<T> dst) -> void {
+    if (accessor.count > dst.size()) {
+        LOG_WARN("GLTF accessor has {} elements, primitive has {}. Ignoring it.", accessor.count, dst.size());
+        return;
+    }
+
+    // Accessors without a buffer view are zero, so is `dst`.
+    if (!accessor.bufferViewIndex.has_value() && !accessor.sparse.has_value()) {
+        return;
+    }
+
+    fastgltf::copyFromAccessor<T>(asset, accessor, dst.data());
+}
+
+static auto copy_geometry(const fastgltf::Asset &asset, GLTFGeometry &geometry) -> void {
+    ZoneScoped;
+
+    // Sizes first, every attribute is allocated once.
+    auto gltf_primitives = std::vector<const fastgltf::Primitive *>();
+    u32 global_vertex_offset = 0;
+    u32 global_index_offset = 0;
+    for (u32 mesh_index = 0; mesh_index < asset.meshes.size(); mesh_index++) {
+        for (const auto &primitive : asset.meshes[mesh_index].primitives) {
+            auto position_attrib = primitive.findAttribute("POSITION");
+            if (!primitive.materialIndex.has_value() || position_attrib == primitive.attributes.end()) {
+                continue;
+            }
+
+            u32 primitive_vertex_count = asset.accessors[position_attrib->accessorIndex].count;
+            u32 primitive_index_count = primitive_vertex_count;
+            if (primitive.indicesAccessor.has_value()) {
+                primitive_index_count = asset.accessors[primitive.indicesAccessor.value()].count;
+            }
+
+            geometry.primitives.push_back(
+                { .mesh_index = mesh_index,
+                  .material_index = static_cast<u32>(primitive.materialIndex.value()),
+                  .vertex_offset = global_vertex_offset,
+                  .vertex_count = primitive_vertex_count,
+                  .index_offset = global_index_offset,
+                  .index_count = primitive_index_count }
+            );
+            gltf_primitives.push_back(&primitive);
+
+            global_vertex_offset += primitive_vertex_count;
+            global_index_offset += primitive_index_count;
+        }
+    }
+
+    geometry.indices.resize(global_index_offset);
+    geometry.vertex_positions.resize(global_vertex_offset);
+    geometry.vertex_normals.resize(global_vertex_offset);
+    geometry.vertex_texcoords.resize(global_vertex_offset);
+
+    for (const auto &[primitive_info, primitive] : std::views::zip(geometry.primitives, gltf_primitives)) {
+        auto indices = ls::span(geometry.indices.data() + primitive_info.index_offset, primitive_info.index_count);
+        if (primitive->indicesAccessor.has_value()) {
+            copy_accessor(asset, asset.accessors[primitive->indicesAccessor.value()], indices);
+        } else {
+            for (u32 i = 0; i < indices.size(); i++) {
+                indices[i] = i;
+            }
+        }
+
+        auto position_attrib = primitive->findAttribute("POSITION");
+        auto positions = ls::span(geometry.vertex_positions.data() + primitive_info.vertex_offset, primitive_info.vertex_count);
+        copy_accessor(asset, asset.accessors[position_attrib->accessorIndex], positions);
+
+        if (auto attrib = primitive->findAttribute("NORMAL"); attrib != primitive->attributes.end()) {
+            auto normals = ls::span(geometry.vertex_normals.data() + primitive_info.vertex_offset, primitive_info.vertex_count);
+            copy_accessor(asset, asset.accessors[attrib->accessorIndex], normals);
+        }
+
+        if (auto attrib = primitive->findAttribute("TEXCOORD_0"); attrib != primitive->attributes.end()) {
+            auto texcoords = ls::span(geometry.vertex_texcoords.data() + primitive_info.vertex_offset, primitive_info.vertex_count);
+            copy_accessor(asset, asset.accessors[attrib->accessorIndex], texcoords);
+        }
+    }
+}
+
+static auto parse_model(const fs::path &path, const GLTFModelCallbacks &callbacks, GLTFGeometry *geometry) -> ls::option<GLTFModelInfo> {
     ZoneScoped;
 
     auto gltf_buffer = fastgltf::GltfDataBuffer::FromPath(path);
@@ -301,6 +384,11 @@ auto GLTFModelInfo::parse(const fs::path &path, GLTFModelCallbacks callbacks) ->
     // Geometry
     ///////////////////////////////////////////////
 
+    if (geometry) {
+        copy_geometry(asset, *geometry);
+        return model;
+    }
+
     u32 global_mesh_index = 0;
     u32 global_vertex_offset = 0;
     u32 global_index_offset = 0;
@@ -374,6 +462,14 @@ auto GLTFModelInfo::parse(const fs::path &path, GLTFModelCallbacks callbacks) ->
     return model;
 }
 
+auto GLTFModelInfo::parse(const fs::path &path, GLTFModelCallbacks callbacks) -> ls::option<GLTFModelInfo> {
+    return parse_model(path, callbacks, nullptr);
+}
+
+auto GLTFModelInfo::parse(const fs::path &path, GLTFGeometry &geometry) -> ls::option<GLTFModelInfo> {
+    return parse_model(path, {}, &geometry);
+}
+
 auto GLTFModelInfo::parse_info(const fs::path &path) -> ls::option<GLTFModelInfo> {
     ZoneScoped;
 
@@ -59,6 +59,29 @@ struct GLTFSceneInfo {
     std::vector<usize> node_indices = {};
 };
 
+struct GLTFPrimitiveInfo {
+    u32 mesh_index = 0;
+    u32 material_index = 0;
+    u32 vertex_offset = 0;
+    u32 vertex_count = 0;
+    u32 index_offset = 0;
+    u32 index_count = 0;
+};
+
+// Geometry of every primitive, one contiguous array per attribute. Each
+// accessor is copied as a whole, straight `memcpy` when its layout already
+// matches. Attributes a primitive doesn't have are zeroed, primitives
+// without indices get a sequential list.
+struct GLTFGeometry {
+    std::vector<GLTFPrimitiveInfo> primitives = {};
+    std::vector<u32> indices = {};
+    std::vector<glm::vec3> vertex_positions = {};
+    std::vector<glm::vec3> vertex_normals = {};
+    std::vector<glm::vec2> vertex_texcoords = {};
+};
+
+// Legacy path, accessors are delivered one element per call. Prefer
+// `GLTFGeometry`.
 struct GLTFModelCallbacks {
     void *user_data = nullptr;
     // clang-format off
@@ -90,6 +113,7 @@ struct GLTFModelInfo {
     ls::option<usize> defualt_scene_index = ls::nullopt;
 
     static auto parse(const fs::path &path, GLTFModelCallbacks callbacks = {}) -> ls::option<GLTFModelInfo>;
+    static auto parse(const fs::path &path, GLTFGeometry &geometry) -> ls::option<GLTFModelInfo>;
     static auto parse_info(const fs::path &path) -> ls::option<GLTFModelInfo>;
 };
 
@@ -1,9 +1,175 @@
 #include "Engine/Asset/ParserKTX2.hh"
 
+#include "Engine/Asset/AssetFile.hh"
+#include "Engine/Core/App.hh"
+
 #include <ktx.h>
 
 namespace lr {
-auto KTX2ImageInfo::parse(ls::span<u8> bytes) -> ls::option<KTX2ImageInfo> {
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html#_file_structure
+struct KTX2Header {
+    u8 identifier[12];
+    u32 vk_format;
+    u32 type_size;
+    u32 pixel_width;
+    u32 pixel_height;
+    u32 pixel_depth;
+    u32 layer_count;
+    u32 face_count;
+    u32 level_count;
+    u32 supercompression_scheme;
+    u32 dfd_byte_offset;
+    u32 dfd_byte_length;
+    u32 kvd_byte_offset;
+    u32 kvd_byte_length;
+    u64 sgd_byte_offset;
+    u64 sgd_byte_length;
+};
+static_assert(sizeof(KTX2Header) == 80);
+
+struct KTX2LevelIndex {
+    u64 byte_offset;
+    u64 byte_length;
+    u64 uncompressed_byte_length;
+};
+
+// BasisLZ global data, image descriptions are followed by codebooks.
+struct KTX2BasisLZGlobalHeader {
+    u16 endpoint_count;
+    u16 selector_count;
+    u32 endpoints_byte_length;
+    u32 selectors_byte_length;
+    u32 tables_byte_length;
+    u32 extended_byte_length;
+};
+static_assert(sizeof(KTX2BasisLZGlobalHeader) == 20);
+
+struct KTX2BasisLZImageDesc {
+    u32 image_flags;
+    u32 rgb_slice_byte_offset;
+    u32 rgb_slice_byte_length;
+    u32 alpha_slice_byte_offset;
+    u32 alpha_slice_byte_length;
+};
+
+constexpr static u8 KTX2_IDENTIFIER[] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+constexpr static u32 KTX2_SUPERCOMPRESSION_BASISLZ = 1;
+
+static auto to_ktx_transcode_format(vuk::Format format) -> ls::option<ktx_transcode_fmt_e> {
+    switch (format) {
+        case vuk::Format::eBc7UnormBlock:
+        case vuk::Format::eBc7SrgbBlock:
+            return KTX_TTF_BC7_RGBA;
+        case vuk::Format::eBc5UnormBlock:
+            return KTX_TTF_BC5_RG;
+        case vuk::Format::eBc4UnormBlock:
+            return KTX_TTF_BC4_R;
+        case vuk::Format::eAstc4x4UnormBlock:
+        case vuk::Format::eAstc4x4SrgbBlock:
+            return KTX_TTF_ASTC_4x4_RGBA;
+        case vuk::Format::eEtc2R8G8B8A8UnormBlock:
+        case vuk::Format::eEtc2R8G8B8A8SrgbBlock:
+            return KTX_TTF_ETC2_RGBA;
+        case vuk::Format::eEacR11G11UnormBlock:
+            return KTX_TTF_ETC2_EAC_RG11;
+        case vuk::Format::eEacR11UnormBlock:
+            return KTX_TTF_ETC2_EAC_R11;
+        case vuk::Format::eR8G8B8A8Unorm:
+        case vuk::Format::eR8G8B8A8Srgb:
+            return KTX_TTF_RGBA32;
+        default:
+            return ls::nullopt;
+    }
+}
+
+static auto read_ktx2_header(ls::span<u8> bytes) -> ls::option<KTX2Header> {
+    auto header = KTX2Header{};
+    if (bytes.size_bytes() < sizeof(KTX2Header)) {
+        return ls::nullopt;
+    }
+
+    std::memcpy(&header, bytes.data(), sizeof(KTX2Header));
+    if (std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        return ls::nullopt;
+    }
+
+    return header;
+}
+
+// libktx only transcodes whole textures, so every level is made into a
+// file of its own and those are transcoded in parallel. Only plain 2D
+// textures are split, `KTX2BasisLZImageDesc` of others are per image.
+static auto extract_ktx2_level(ls::span<u8> bytes, const KTX2Header &header, u32 level) -> std::vector<u8> {
+    ZoneScoped;
+
+    auto level_indices = get_asset_file_section<KTX2LevelIndex>(bytes, sizeof(KTX2Header), header.level_count);
+    auto dfd = get_asset_file_section<u8>(bytes, header.dfd_byte_offset, header.dfd_byte_length);
+    auto sgd = get_asset_file_section<u8>(bytes, header.sgd_byte_offset, header.sgd_byte_length);
+    if (!level_indices.has_value() || !dfd.has_value() || !sgd.has_value()) {
+        return {};
+    }
+
+    const auto &level_index = level_indices.value()[level];
+    auto level_data = get_asset_file_section<u8>(bytes, level_index.byte_offset, level_index.byte_length);
+    if (!level_data.has_value()) {
+        return {};
+    }
+
+    // Only the image description of this level is kept, codebooks are shared.
+    auto level_sgd = std::vector<u8>();
+    if (header.supercompression_scheme == KTX2_SUPERCOMPRESSION_BASISLZ) {
+        auto image_descs_offset = sizeof(KTX2BasisLZGlobalHeader);
+        auto codebooks_offset = image_descs_offset + header.level_count * sizeof(KTX2BasisLZImageDesc);
+        if (sgd->size_bytes() < codebooks_offset) {
+            return {};
+        }
+
+        auto level_desc_offset = image_descs_offset + level * sizeof(KTX2BasisLZImageDesc);
+        level_sgd.insert(level_sgd.end(), sgd->begin(), sgd->begin() + image_descs_offset);
+        level_sgd.insert(level_sgd.end(), sgd->begin() + level_desc_offset, sgd->begin() + level_desc_offset + sizeof(KTX2BasisLZImageDesc));
+        level_sgd.insert(level_sgd.end(), sgd->begin() + codebooks_offset, sgd->end());
+    } else {
+        level_sgd.assign(sgd->begin(), sgd->end());
+    }
+
+    auto level_header = header;
+    level_header.pixel_width = ls::max(header.pixel_width >> level, 1_u32);
+    level_header.pixel_height = ls::max(header.pixel_height >> level, 1_u32);
+    level_header.level_count = 1;
+    level_header.kvd_byte_offset = 0;
+    level_header.kvd_byte_length = 0;
+    level_header.dfd_byte_offset = static_cast<u32>(sizeof(KTX2Header) + sizeof(KTX2LevelIndex));
+    level_header.sgd_byte_offset = level_sgd.empty() ? 0 : (level_header.dfd_byte_offset + dfd->size_bytes() + 7) & ~7_u64;
+    level_header.sgd_byte_length = level_sgd.size();
+
+    // UASTC levels must be aligned to their block size.
+    auto sgd_end = level_sgd.empty() ? level_header.dfd_byte_offset + dfd->size_bytes() : level_header.sgd_byte_offset + level_sgd.size();
+    auto level_index_out = KTX2LevelIndex{
+        .byte_offset = (sgd_end + 15) & ~15_u64,
+        .byte_length = level_index.byte_length,
+        .uncompressed_byte_length = level_index.uncompressed_byte_length,
+    };
+
+    auto level_bytes = std::vector<u8>(level_index_out.byte_offset + level_index_out.byte_length, 0);
+    std::memcpy(level_bytes.data(), &level_header, sizeof(KTX2Header));
+    std::memcpy(level_bytes.data() + sizeof(KTX2Header), &level_index_out, sizeof(KTX2LevelIndex));
+    std::memcpy(level_bytes.data() + level_header.dfd_byte_offset, dfd->data(), dfd->size_bytes());
+    if (!level_sgd.empty()) {
+        std::memcpy(level_bytes.data() + level_header.sgd_byte_offset, level_sgd.data(), level_sgd.size());
+    }
+    std::memcpy(level_bytes.data() + level_index_out.byte_offset, level_data->data(), level_data->size_bytes());
+
+    return level_bytes;
+}
+
+// Transcodes every level of `bytes` and writes them into `dst_levels`.
+static auto transcode_ktx2_levels(
+    ls::span<u8> bytes,
+    ktx_transcode_fmt_e transcode_format,
+    u32 first_level,
+    ls::span<ls::span<u8>> dst_levels,
+    bool whole_texture
+) -> bool {
     ZoneScoped;
 
     ktxTexture2 *texture = nullptr;
@@ -16,40 +182,177 @@ auto KTX2ImageInfo::parse(ls::span<u8> bytes) -> ls::option<KTX2ImageInfo> {
     auto result = ktxTexture2_CreateFromMemory(bytes.data(), bytes.size_bytes(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture);
     if (result != KTX_SUCCESS) {
         LOG_ERROR("Failed to parse KTX2 file, error code: {}.", static_cast<u32>(result));
-        return ls::nullopt;
+        return false;
     }
 
-    auto format = vuk::Format::eUndefined;
     if (ktxTexture2_NeedsTranscoding(texture)) {
-        ktxTexture2_TranscodeBasis(texture, KTX_TTF_BC7_RGBA, KTX_TF_HIGH_QUALITY);
-        format = vuk::Format::eBc7UnormBlock;
-    } else {
-        format = static_cast<vuk::Format>(texture->vkFormat);
+        result = ktxTexture2_TranscodeBasis(texture, transcode_format, KTX_TF_HIGH_QUALITY);
+        if (result != KTX_SUCCESS) {
+            LOG_ERROR("Failed to transcode KTX2 file, error code: {}.", static_cast<u32>(result));
+            return false;
+        }
     }
 
-    auto level_count = texture->numLevels;
-
-    auto info = KTX2ImageInfo{};
-    info.format = format;
-    info.base_extent = { .width = texture->baseWidth, .height = texture->baseHeight, .depth = texture->baseDepth };
-    info.mip_level_count = level_count;
-    info.per_level_offsets.resize(level_count);
-
+    auto level_count = whole_texture ? texture->numLevels : 1_u32;
     for (u32 level = 0; level < level_count; level++) {
         u64 offset = 0;
         auto offset_result = ktxTexture_GetImageOffset(ktxTexture(texture), level, 0, 0, &offset);
         if (offset_result != KTX_SUCCESS) {
             LOG_ERROR("Failed to get KTX2 offset.");
-            return ls::nullopt;
+            return false;
         }
 
         auto *image_data = ktxTexture_GetData(ktxTexture(texture)) + offset;
         auto image_size = ktxTexture_GetImageSize(ktxTexture(texture), level);
+        auto &dst = dst_levels[first_level + level];
+        if (dst.size_bytes() < image_size) {
+            LOG_ERROR("Destination of KTX2 level {} is too small ({} < {})!", first_level + level, dst.size_bytes(), image_size);
+            return false;
+        }
+
+        std::memcpy(dst.data(), image_data, image_size);
+    }
+
+    return true;
+}
+
+auto KTX2ImageInfo::parse(ls::span<u8> bytes, vuk::Format transcode_format) -> ls::option<KTX2ImageInfo> {
+    ZoneScoped;
+
+    auto info = KTX2ImageInfo::parse_info(bytes);
+    if (!info.has_value()) {
+        return ls::nullopt;
+    }
+
+    if (info->needs_transcoding) {
+        info->format = transcode_format;
+    }
 
-        auto output_offset = static_cast<usize>(info.data.size());
-        info.per_level_offsets[level] = output_offset;
-        info.data.resize(info.data.size() + image_size);
-        std::memcpy(info.data.data() + output_offset, image_data, image_size);
+    // Sizes are known up front, level spans stay valid while being written.
+    info->per_level_offsets.resize(info->mip_level_count);
+    info->per_level_sizes.resize(info->mip_level_count);
+    auto data_size = 0_u64;
+    for (u32 level = 0; level < info->mip_level_count; level++) {
+        auto level_extent = vuk::Extent3D{
+            .width = ls::max(info->base_extent.width >> level, 1_u32),
+            .height = ls::max(info->base_extent.height >> level, 1_u32),
+            .depth = ls::max(info->base_extent.depth >> level, 1_u32),
+        };
+        info->per_level_offsets[level] = data_size;
+        info->per_level_sizes[level] = vuk::compute_image_size(info->format, level_extent);
+        data_size += info->per_level_sizes[level];
+    }
+
+    info->data.resize(data_size);
+    auto parsed = KTX2ImageInfo::parse_into(bytes, transcode_format, [&info](u32 level, vuk::Extent3D, usize level_size) -> ls::span<u8> {
+        if (level_size > info->per_level_sizes[level]) {
+            return {};
+        }
+
+        return { info->data.data() + info->per_level_offsets[level], level_size };
+    });
+    if (!parsed) {
+        return ls::nullopt;
+    }
+
+    return info;
+}
+
+auto KTX2ImageInfo::parse_into(ls::span<u8> bytes, vuk::Format transcode_format, const KTX2LevelDstFn &get_level_dst) -> bool {
+    ZoneScoped;
+
+    auto info = KTX2ImageInfo::parse_info(bytes);
+    auto header = read_ktx2_header(bytes);
+    if (!info.has_value() || !header.has_value()) {
+        return false;
+    }
+
+    auto level_format = info->needs_transcoding ? transcode_format : info->format;
+    auto ktx_transcode_format = to_ktx_transcode_format(transcode_format);
+    if (info->needs_transcoding && !ktx_transcode_format.has_value()) {
+        LOG_ERROR("KTX2 files can't be transcoded into format {}!", static_cast<u32>(transcode_format));
+        return false;
+    }
+
+    auto dst_levels = std::vector<ls::span<u8>>(info->mip_level_count);
+    for (u32 level = 0; level < info->mip_level_count; level++) {
+        auto level_extent = vuk::Extent3D{
+            .width = ls::max(info->base_extent.width >> level, 1_u32),
+            .height = ls::max(info->base_extent.height >> level, 1_u32),
+            .depth = ls::max(info->base_extent.depth >> level, 1_u32),
+        };
+        auto level_size = vuk::compute_image_size(level_format, level_extent);
+        dst_levels[level] = get_level_dst(level, level_extent, level_size);
+        if (dst_levels[level].size_bytes() < level_size) {
+            LOG_ERROR("Destination of KTX2 level {} is too small ({} < {})!", level, dst_levels[level].size_bytes(), level_size);
+            return false;
+        }
+    }
+
+    auto is_plain_2d = header->layer_count <= 1 && header->face_count == 1 && header->pixel_depth <= 1;
+    if (!info->needs_transcoding || !is_plain_2d || info->mip_level_count == 1) {
+        return transcode_ktx2_levels(bytes, ktx_transcode_format.value_or(KTX_TTF_RGBA32), 0, dst_levels, true);
+    }
+
+    // A level per chunk, finest level is by far the largest and goes first.
+    auto failed = std::atomic<bool>(false);
+    App::get().job_man.parallel_for(info->mip_level_count, 1, [&](u32 first_level, u32 last_level) {
+        for (auto level = first_level; level < last_level; level++) {
+            auto level_bytes = extract_ktx2_level(bytes, header.value(), level);
+            if (level_bytes.empty() || !transcode_ktx2_levels(level_bytes, ktx_transcode_format.value(), level, dst_levels, false)) {
+                failed = true;
+            }
+        }
+    });
+
+    if (failed) {
+        LOG_ERROR("Failed to transcode KTX2 levels.");
+        return false;
+    }
+
+    return true;
+}
+
+auto KTX2ImageInfo::read_header(File &file) -> ls::option<KTX2ImageInfo> {
+    ZoneScoped;
+
+    auto header = KTX2Header{};
+    file.seek(0);
+    if (file.size < sizeof(KTX2Header) || file.read(&header, sizeof(KTX2Header)) != sizeof(KTX2Header)) {
+        LOG_ERROR("Failed to read KTX2 header.");
+        return ls::nullopt;
+    }
+
+    if (std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        LOG_ERROR("Not a KTX2 file, identifier mismatch.");
+        return ls::nullopt;
+    }
+
+    auto level_count = ls::max(header.level_count, 1_u32);
+    auto level_indices = std::vector<KTX2LevelIndex>(level_count);
+    auto level_index_size = level_count * sizeof(KTX2LevelIndex);
+    if (file.size < sizeof(KTX2Header) + level_index_size || file.read(level_indices.data(), level_index_size) != level_index_size) {
+        LOG_ERROR("Failed to read KTX2 level index.");
+        return ls::nullopt;
+    }
+
+    auto info = KTX2ImageInfo{};
+    info.base_extent = { .width = header.pixel_width, .height = header.pixel_height, .depth = ls::max(header.pixel_depth, 1_u32) };
+    info.mip_level_count = level_count;
+    // Arrays and cubemaps interleave their layers, let libktx handle them.
+    info.needs_transcoding = header.vk_format == 0 || header.supercompression_scheme != 0 || header.layer_count > 1 || header.face_count > 1;
+    info.format = info.needs_transcoding ? vuk::Format::eUndefined : static_cast<vuk::Format>(header.vk_format);
+    info.per_level_offsets.resize(level_count);
+    info.per_level_sizes.resize(level_count);
+    for (u32 level = 0; level < level_count; level++) {
+        const auto &level_index = level_indices[level];
+        if (level_index.byte_offset + level_index.byte_length > file.size) {
+            LOG_ERROR("KTX2 level {} is out of file bounds.", level);
+            return ls::nullopt;
+        }
+
+        info.per_level_offsets[level] = level_index.byte_offset;
+        info.per_level_sizes[level] = level_index.byte_length;
     }
 
     return info;
@@ -71,23 +374,58 @@ auto KTX2ImageInfo::parse_info(ls::span<u8> bytes) -> ls::option<KTX2ImageInfo>
         return ls::nullopt;
     }
 
-    auto format = vuk::Format::eUndefined;
-    if (ktxTexture2_NeedsTranscoding(texture)) {
-        ktxTexture2_TranscodeBasis(texture, KTX_TTF_BC7_RGBA, KTX_TF_HIGH_QUALITY);
-        format = vuk::Format::eBc7UnormBlock;
-    } else {
-        format = static_cast<vuk::Format>(texture->vkFormat);
-    }
-
     auto info = KTX2ImageInfo{};
-    info.format = format;
+    info.needs_transcoding = ktxTexture2_NeedsTranscoding(texture);
+    info.format = info.needs_transcoding ? vuk::Format::eUndefined : static_cast<vuk::Format>(texture->vkFormat);
+    info.component_count = ktxTexture2_GetNumComponents(texture);
     info.base_extent = { .width = texture->baseWidth, .height = texture->baseHeight, .depth = texture->baseDepth };
     info.mip_level_count = texture->numLevels;
 
     return info;
 }
 
-auto KTX2ImageInfo::encode(ls::span<u8> raw_pixels, vuk::Format format, vuk::Extent3D extent, u32 level_count, bool normal) -> std::vector<u8> {
+auto KTX2ImageInfo::choose_transcode_format(u32 channel_count, bool srgb, const KTX2FormatSupportFn &is_supported) -> vuk::Format {
+    ZoneScoped;
+
+    auto candidates = std::array<vuk::Format, 4>{};
+    switch (channel_count) {
+        case 1: {
+            candidates = { vuk::Format::eBc4UnormBlock, vuk::Format::eEacR11UnormBlock, vuk::Format::eR8G8B8A8Unorm, vuk::Format::eR8G8B8A8Unorm };
+        } break;
+        case 2: {
+            candidates = { vuk::Format::eBc5UnormBlock, vuk::Format::eEacR11G11UnormBlock, vuk::Format::eR8G8B8A8Unorm, vuk::Format::eR8G8B8A8Unorm };
+        } break;
+        default: {
+            if (srgb) {
+                candidates = {
+                    vuk::Format::eBc7SrgbBlock,
+                    vuk::Format::eAstc4x4SrgbBlock,
+                    vuk::Format::eEtc2R8G8B8A8SrgbBlock,
+                    vuk::Format::eR8G8B8A8Srgb,
+                };
+            } else {
+                candidates = {
+                    vuk::Format::eBc7UnormBlock,
+                    vuk::Format::eAstc4x4UnormBlock,
+                    vuk::Format::eEtc2R8G8B8A8UnormBlock,
+                    vuk::Format::eR8G8B8A8Unorm,
+                };
+            }
+        } break;
+    }
+
+    for (auto format : candidates) {
+        if (is_supported(format)) {
+            return format;
+        }
+    }
+
+    // Every device samples RGBA8.
+    return srgb && channel_count > 2 ? vuk::Format::eR8G8B8A8Srgb : vuk::Format::eR8G8B8A8Unorm;
+}
+
+auto KTX2ImageInfo::encode(ls::span<u8> raw_pixels, vuk::Format format, vuk::Extent3D extent, u32 level_count, bool normal, KTX2Codec codec)
+    -> std::vector<u8> {
     ZoneScoped;
 
     ktxTextureCreateInfo create_info = {
@@ -118,24 +456,43 @@ auto KTX2ImageInfo::encode(ls::span<u8> raw_pixels, vuk::Format format, vuk::Ext
         return {};
     }
 
-    ktxTexture_SetImageFromMemory(ktxTexture(texture), 0, 0, 0, raw_pixels.data(), raw_pixels.size_bytes());
+    auto level_offset = 0_sz;
+    for (u32 level = 0; level < level_count; level++) {
+        auto level_size = ktxTexture_GetImageSize(ktxTexture(texture), level);
+        if (level_offset + level_size > raw_pixels.size_bytes()) {
+            LOG_ERROR("Pixels of KTX2 level {} are out of bounds!", level);
+            return {};
+        }
+
+        ktxTexture_SetImageFromMemory(ktxTexture(texture), level, 0, 0, raw_pixels.data() + level_offset, level_size);
+        level_offset += level_size;
+    }
 
     ktxBasisParams params = {};
     params.structSize = sizeof(ktxBasisParams);
     params.verbose = KTX_FALSE;
     params.noSSE = KTX_FALSE;
-    params.threadCount = 1;
+    // Encoder has its own thread pool, job workers would only run one
+    // texture at a time each.
+    params.threadCount = ls::max(std::thread::hardware_concurrency(), 1_u32);
 
-    // ETC1S
-    // params.compressionLevel = 3;
-    // params.qualityLevel = 127;
-    // params.normalMap = normal;
-
-    // UASTC
-    params.uastc = KTX_TRUE;
-    params.uastcFlags = KTX_PACK_UASTC_LEVEL_DEFAULT;
-    params.uastcRDO = normal ? KTX_FALSE : KTX_TRUE;
-    params.uastcRDONoMultithreading = true;
+    switch (codec) {
+        case KTX2Codec::UASTC: {
+            params.uastc = KTX_TRUE;
+            params.uastcFlags = KTX_PACK_UASTC_LEVEL_DEFAULT;
+            params.uastcRDO = normal ? KTX_FALSE : KTX_TRUE;
+            params.uastcRDONoMultithreading = KTX_FALSE;
+        } break;
+        case KTX2Codec::ETC1S: {
+            params.uastc = KTX_FALSE;
+            params.compressionLevel = KTX_ETC1S_DEFAULT_COMPRESSION_LEVEL;
+            params.qualityLevel = 128;
+            params.normalMap = normal ? KTX_TRUE : KTX_FALSE;
+            // X in color slice, Y in alpha slice. They don't share
+            // endpoints, transcodes into BC5 on load.
+            params.separateRGToRGB_A = normal ? KTX_TRUE : KTX_FALSE;
+        } break;
+    }
 
     result = ktxTexture2_CompressBasisEx(texture, &params);
     if (result != KTX_SUCCESS) {
@@ -143,16 +500,20 @@ auto KTX2ImageInfo::encode(ls::span<u8> raw_pixels, vuk::Format format, vuk::Ext
         return {};
     }
 
-    auto output_pixels = std::vector<u8>(texture->dataSize);
-    auto *output_pixels_data = output_pixels.data();
-    u64 written_bytes = 0;
+    // libktx allocates output itself
+    u8 *output_pixels_data = nullptr;
+    ktx_size_t written_bytes = 0;
+    LS_DEFER(&) {
+        std::free(output_pixels_data);
+    };
+
     result = ktxTexture_WriteToMemory(ktxTexture(texture), &output_pixels_data, &written_bytes);
     if (result != KTX_SUCCESS) {
         LOG_ERROR("Cannot write compressed texture into memory! {}", static_cast<u32>(result));
         return {};
     }
 
-    return output_pixels;
+    return std::vector<u8>(output_pixels_data, output_pixels_data + written_bytes);
 }
 
 } // namespace lr
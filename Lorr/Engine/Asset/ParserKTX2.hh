@@ -2,17 +2,62 @@
 
 #include "Engine/Graphics/VulkanTypes.hh"
 
+#include "Engine/OS/File.hh"
+
 namespace lr {
+// Returns memory that level will be written into, usually mapped staging buffer.
+// Called for every level in order before any of them is written, memory must
+// stay valid until parsing returns.
+using KTX2LevelDstFn = std::function<ls::span<u8>(u32 level, vuk::Extent3D level_extent, usize level_size)>;
+// Whether device can sample images of `format`.
+using KTX2FormatSupportFn = std::function<bool(vuk::Format format)>;
+
+// Basis Universal codec `encode` compresses with.
+enum class KTX2Codec : u32 {
+    // Larger, close to BC7 quality.
+    UASTC = 0,
+    // Much smaller, lower quality. Normals are encoded as two components.
+    ETC1S,
+};
+
 struct KTX2ImageInfo {
     vuk::Format format = vuk::Format::eUndefined;
     vuk::Extent3D base_extent = {};
     u32 mip_level_count = 0;
 
+    // For `parse`, offsets are into `data`. For `read_header`, offsets are
+    // into the file itself.
     std::vector<u64> per_level_offsets = {};
+    std::vector<u64> per_level_sizes = {};
+    // Basis encoded or supercompressed, levels must go through libktx.
+    bool needs_transcoding = false;
+    // From data format descriptor, 1 and 2 can go into BC4/BC5.
+    u32 component_count = 4;
     std::vector<u8> data = {};
 
-    static auto parse(ls::span<u8> bytes) -> ls::option<KTX2ImageInfo>;
+    // Basis encoded levels are transcoded into `transcode_format`, see
+    // `choose_transcode_format`. Stored format is kept otherwise.
+    static auto parse(ls::span<u8> bytes, vuk::Format transcode_format = vuk::Format::eBc7UnormBlock) -> ls::option<KTX2ImageInfo>;
+    // Doesn't transcode, `format` is undefined when `needs_transcoding`.
     static auto parse_info(ls::span<u8> bytes) -> ls::option<KTX2ImageInfo>;
-    static auto encode(ls::span<u8> raw_pixels, vuk::Format format, vuk::Extent3D extent, u32 level_count, bool normal) -> std::vector<u8>;
+    // Same as `parse` but each level is written into `get_level_dst` instead
+    // of `data`. Levels are transcoded in parallel on job manager.
+    static auto parse_into(ls::span<u8> bytes, vuk::Format transcode_format, const KTX2LevelDstFn &get_level_dst) -> bool;
+    // Cheapest format that keeps `channel_count` channels and is supported,
+    // BC first, then ASTC and ETC2, RGBA8 when nothing else is.
+    static auto choose_transcode_format(u32 channel_count, bool srgb, const KTX2FormatSupportFn &is_supported) -> vuk::Format;
+    // Only reads header and level index. If `needs_transcoding` is false, levels
+    // can be read from the file directly into their destination.
+    static auto read_header(File &file) -> ls::option<KTX2ImageInfo>;
+    // `raw_pixels` holds every level tightly packed, base level first.
+    // Uses every core, call from a single job per texture.
+    static auto encode(
+        ls::span<u8> raw_pixels,
+        vuk::Format format,
+        vuk::Extent3D extent,
+        u32 level_count,
+        bool normal,
+        KTX2Codec codec = KTX2Codec::UASTC
+    ) -> std::vector<u8>;
 };
 } // namespace lr
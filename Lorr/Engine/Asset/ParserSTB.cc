@@ -7,22 +7,42 @@ namespace lr {
 auto STBImageInfo::parse(ls::span<u8> bytes) -> ls::option<STBImageInfo> {
     ZoneScoped;
 
+    auto image = STBImageInfo::parse_info(bytes);
+    if (!image.has_value()) {
+        return ls::nullopt;
+    }
+
+    image->data.resize(image->extent.width * image->extent.height * 4);
+    if (!STBImageInfo::parse_into(bytes, image->data)) {
+        return ls::nullopt;
+    }
+
+    return image;
+}
+
+auto STBImageInfo::parse_into(ls::span<u8> bytes, ls::span<u8> dst) -> bool {
+    ZoneScoped;
+
     i32 width, height, channel_count;
     u8 *parsed_data = stbi_load_from_memory(bytes.data(), static_cast<i32>(bytes.size_bytes()), &width, &height, &channel_count, STBI_rgb_alpha);
     if (!parsed_data) {
-        return ls::nullopt;
+        return false;
     }
 
-    STBImageInfo image = {};
-    image.extent = { .width = static_cast<u32>(width), .height = static_cast<u32>(height), .depth = 1 };
+    LS_DEFER(&) {
+        stbi_image_free(parsed_data);
+    };
 
-    u64 upload_size = width * height * 4;
-    image.data.resize(upload_size);
-    std::memcpy(&image.data[0], parsed_data, upload_size);
+    // stb always allocates its own output, this is the only copy left.
+    auto upload_size = static_cast<usize>(width) * static_cast<usize>(height) * 4;
+    if (dst.size_bytes() < upload_size) {
+        LOG_ERROR("Destination of STB image is too small ({} < {})!", dst.size_bytes(), upload_size);
+        return false;
+    }
 
-    stbi_image_free(parsed_data);
+    std::memcpy(dst.data(), parsed_data, upload_size);
 
-    return image;
+    return true;
 }
 
 auto STBImageInfo::parse_info(ls::span<u8> bytes) -> ls::option<STBImageInfo> {
@@ -8,6 +8,9 @@ struct STBImageInfo {
     std::vector<u8> data = {};
 
     static auto parse(ls::span<u8> bytes) -> ls::option<STBImageInfo>;
+    // Decodes RGBA8 pixels straight into `dst`, usually a mapped staging
+    // buffer. `dst` must fit `width * height * 4` bytes.
+    static auto parse_into(ls::span<u8> bytes, ls::span<u8> dst) -> bool;
     static auto parse_info(ls::span<u8> bytes) -> ls::option<STBImageInfo>;
 };
 } // namespace lr
@@ -0,0 +1,192 @@
+#include "Engine/Asset/RegistrySnapshot.hh"
+
+namespace lr {
+struct RegistrySnapshotFileHeader {
+    c8 magic[4] = { 'L', 'R', 'E', 'G' };
+    u16 version = 1;
+    u16 padding = 0;
+    u32 directory_count = 0;
+    u32 entry_count = 0;
+    u32 dependency_count = 0;
+    u32 padding2 = 0;
+    u64 directories_offset = 0;
+    u64 entries_offset = 0;
+    u64 dependencies_offset = 0;
+    u64 strings_offset = 0;
+    u64 strings_size = 0;
+};
+
+struct RegistrySnapshotFileString {
+    u32 offset = 0;
+    u32 length = 0;
+};
+
+struct RegistrySnapshotFileDirectory {
+    RegistrySnapshotFileString path = {};
+    i64 time = 0;
+};
+
+struct RegistrySnapshotFileEntry {
+    u8 uuid[16] = {};
+    AssetType type = AssetType::None;
+    u32 dependency_offset = 0;
+    u32 dependency_count = 0;
+    RegistrySnapshotFileString meta_path = {};
+    i64 meta_time = 0;
+    u64 meta_size = 0;
+    u64 source_size = 0;
+    i64 source_time = 0;
+    u64 source_hash = 0;
+};
+
+auto RegistrySnapshot::read(const fs::path &path) -> ls::option<RegistrySnapshot> {
+    ZoneScoped;
+
+    auto file_data = File::to_bytes(path);
+    if (file_data.size() < sizeof(RegistrySnapshotFileHeader)) {
+        return ls::nullopt;
+    }
+
+    const auto *header = reinterpret_cast<const RegistrySnapshotFileHeader *>(file_data.data());
+    if (std::memcmp(header->magic, RegistrySnapshotFileHeader{}.magic, sizeof(header->magic)) != 0 || header->version != VERSION) {
+        return ls::nullopt;
+    }
+
+    auto file_directories = get_asset_file_section<RegistrySnapshotFileDirectory>(file_data, header->directories_offset, header->directory_count);
+    auto file_entries = get_asset_file_section<RegistrySnapshotFileEntry>(file_data, header->entries_offset, header->entry_count);
+    auto file_dependencies = get_asset_file_section<std::array<u8, 16>>(file_data, header->dependencies_offset, header->dependency_count);
+    auto file_strings = get_asset_file_section<c8>(file_data, header->strings_offset, header->strings_size);
+    if (!file_directories.has_value() || !file_entries.has_value() || !file_dependencies.has_value() || !file_strings.has_value()) {
+        LOG_WARN("Registry snapshot '{}' is corrupt, ignoring.", path);
+        return ls::nullopt;
+    }
+
+    auto strings = std::string_view(file_strings->data(), file_strings->size());
+    auto get_string = [&](const RegistrySnapshotFileString &str) -> ls::option<std::string> {
+        if (str.offset > strings.size() || str.length > strings.size() - str.offset) {
+            return ls::nullopt;
+        }
+
+        return std::string(strings.substr(str.offset, str.length));
+    };
+
+    auto snapshot = RegistrySnapshot{};
+    snapshot.directories.reserve(file_directories->size());
+    for (const auto &file_directory : file_directories.value()) {
+        auto directory_path = get_string(file_directory.path);
+        if (!directory_path.has_value()) {
+            return ls::nullopt;
+        }
+
+        snapshot.directories.push_back({ .path = std::move(directory_path.value()), .time = file_directory.time });
+    }
+
+    snapshot.entries.reserve(file_entries->size());
+    for (const auto &file_entry : file_entries.value()) {
+        auto meta_path = get_string(file_entry.meta_path);
+        if (!meta_path.has_value() || file_entry.dependency_offset > file_dependencies->size()
+            || file_entry.dependency_count > file_dependencies->size() - file_entry.dependency_offset)
+        {
+            return ls::nullopt;
+        }
+
+        auto uuid_bytes = std::array<u8, 16>{};
+        std::memcpy(uuid_bytes.data(), file_entry.uuid, uuid_bytes.size());
+
+        auto &entry = snapshot.entries.emplace_back();
+        entry.uuid = UUID::from_bytes(uuid_bytes);
+        entry.type = file_entry.type;
+        entry.meta_path = std::move(meta_path.value());
+        entry.meta_time = file_entry.meta_time;
+        entry.meta_size = file_entry.meta_size;
+        entry.source_hash = { .size = file_entry.source_size, .time = file_entry.source_time, .hash = file_entry.source_hash };
+        for (const auto &dependency_bytes : file_dependencies->subspan(file_entry.dependency_offset, file_entry.dependency_count)) {
+            entry.dependencies.push_back(UUID::from_bytes(dependency_bytes));
+        }
+    }
+
+    return snapshot;
+}
+
+auto RegistrySnapshot::write(this RegistrySnapshot &self, const fs::path &path) -> bool {
+    ZoneScoped;
+
+    auto strings = std::string();
+    auto push_string = [&](std::string_view str) -> RegistrySnapshotFileString {
+        auto offset = static_cast<u32>(strings.size());
+        strings += str;
+        return { .offset = offset, .length = static_cast<u32>(str.size()) };
+    };
+
+    auto file_directories = std::vector<RegistrySnapshotFileDirectory>();
+    file_directories.reserve(self.directories.size());
+    for (const auto &directory : self.directories) {
+        file_directories.push_back({ .path = push_string(directory.path), .time = directory.time });
+    }
+
+    auto file_entries = std::vector<RegistrySnapshotFileEntry>();
+    auto file_dependencies = std::vector<std::array<u8, 16>>();
+    file_entries.reserve(self.entries.size());
+    for (const auto &entry : self.entries) {
+        auto &file_entry = file_entries.emplace_back();
+        std::memcpy(file_entry.uuid, entry.uuid.bytes().data(), sizeof(file_entry.uuid));
+        file_entry.type = entry.type;
+        file_entry.dependency_offset = static_cast<u32>(file_dependencies.size());
+        file_entry.dependency_count = static_cast<u32>(entry.dependencies.size());
+        file_entry.meta_path = push_string(entry.meta_path);
+        file_entry.meta_time = entry.meta_time;
+        file_entry.meta_size = entry.meta_size;
+        file_entry.source_size = entry.source_hash.size;
+        file_entry.source_time = entry.source_hash.time;
+        file_entry.source_hash = entry.source_hash.hash;
+        for (const auto &dependency : entry.dependencies) {
+            file_dependencies.push_back(dependency.bytes());
+        }
+    }
+
+    auto header = RegistrySnapshotFileHeader{
+        .version = VERSION,
+        .directory_count = static_cast<u32>(file_directories.size()),
+        .entry_count = static_cast<u32>(file_entries.size()),
+        .dependency_count = static_cast<u32>(file_dependencies.size()),
+    };
+    header.directories_offset = align_asset_file_offset(sizeof(RegistrySnapshotFileHeader));
+    header.entries_offset = align_asset_file_offset(header.directories_offset + ls::size_bytes(file_directories));
+    header.dependencies_offset = align_asset_file_offset(header.entries_offset + ls::size_bytes(file_entries));
+    header.strings_offset = align_asset_file_offset(header.dependencies_offset + ls::size_bytes(file_dependencies));
+    header.strings_size = strings.size();
+
+    auto contents = std::vector<u8>(header.strings_offset + header.strings_size, 0);
+    std::memcpy(contents.data(), &header, sizeof(RegistrySnapshotFileHeader));
+    std::memcpy(contents.data() + header.directories_offset, file_directories.data(), ls::size_bytes(file_directories));
+    std::memcpy(contents.data() + header.entries_offset, file_entries.data(), ls::size_bytes(file_entries));
+    std::memcpy(contents.data() + header.dependencies_offset, file_dependencies.data(), ls::size_bytes(file_dependencies));
+    std::memcpy(contents.data() + header.strings_offset, strings.data(), strings.size());
+
+    // Renamed over the old snapshot once complete, a crash mid write leaves the old one.
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        File file(temp_path, FileAccess::Write);
+        if (!file) {
+            LOG_ERROR("Failed to open file '{}' for writing!", temp_path);
+            return false;
+        }
+
+        if (file.write(contents.data(), contents.size()) != contents.size()) {
+            LOG_ERROR("Failed to write registry snapshot '{}'!", temp_path);
+            return false;
+        }
+    }
+
+    auto ec = std::error_code{};
+    fs::rename(temp_path, path, ec);
+    if (ec) {
+        LOG_ERROR("Failed to move registry snapshot to '{}'! {}", path, ec.message());
+        fs::remove(temp_path, ec);
+        return false;
+    }
+
+    return true;
+}
+} // namespace lr
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Engine/Asset/AssetFile.hh"
+#include "Engine/Asset/DerivedDataCache.hh"
+#include "Engine/Asset/UUID.hh"
+
+namespace lr {
+struct RegistrySnapshotDirectory {
+    // Project relative, `.` for project root.
+    std::string path = {};
+    i64 time = 0;
+};
+
+struct RegistrySnapshotEntry {
+    UUID uuid = {};
+    AssetType type = AssetType::None;
+    // Project relative path of the meta file.
+    std::string meta_path = {};
+    i64 meta_time = 0;
+    u64 meta_size = 0;
+    // Source hash `DerivedDataCache::hash_file` computed, zero when it was
+    // never hashed.
+    DerivedDataCache::SourceHash source_hash = {};
+    std::vector<UUID> dependencies = {};
+};
+
+// Registry of a project as it was last imported. Directory mtimes change
+// whenever a file is created, removed or renamed in them, so only
+// directories with a different mtime are listed again on next import.
+// Everything else comes straight from the snapshot.
+//
+// RegistrySnapshotFileHeader
+// RegistrySnapshotFileDirectory[directory_count]
+// RegistrySnapshotFileEntry[entry_count]
+// u8[16][dependency_count]
+// c8[]                     -- String pool
+struct RegistrySnapshot {
+    constexpr static u16 VERSION = 1;
+    constexpr static auto FILE_NAME = std::string_view("registry.lrreg");
+
+    std::vector<RegistrySnapshotDirectory> directories = {};
+    std::vector<RegistrySnapshotEntry> entries = {};
+
+    // Returns nullopt when there is no snapshot of current version.
+    static auto read(const fs::path &path) -> ls::option<RegistrySnapshot>;
+    auto write(this RegistrySnapshot &, const fs::path &path) -> bool;
+};
+} // namespace lr
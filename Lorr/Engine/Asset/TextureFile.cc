@@ -0,0 +1,164 @@
+#include "Engine/Asset/TextureFile.hh"
+
+#include "Engine/Asset/MipChain.hh"
+#include "Engine/Asset/ParserKTX2.hh"
+#include "Engine/Asset/ParserSTB.hh"
+
+#include "Engine/Memory/Hasher.hh"
+
+namespace lr {
+static auto decode_mip_chain(ls::span<u8> image_bytes, bool normal, f32 alpha_cutoff) -> ls::option<MipChain> {
+    ZoneScoped;
+
+    auto image = STBImageInfo::parse(image_bytes);
+    if (!image.has_value()) {
+        LOG_ERROR("Cannot cook texture, failed to decode image.");
+        return ls::nullopt;
+    }
+
+    auto mip_chain_info = MipChainInfo{
+        .extent = image->extent,
+        // Ringing of sharper filters shows up as noise on normals.
+        .filter = normal ? MipFilter::Box : MipFilter::Kaiser,
+        .srgb = !normal,
+        .normal = normal,
+        .alpha_cutoff = alpha_cutoff,
+    };
+
+    return MipChain::generate(image->data, mip_chain_info);
+}
+
+auto TextureFile::params_hash(bool normal, f32 alpha_cutoff, TextureCookFormat cook_format) -> u64 {
+    ZoneScoped;
+
+    auto hasher = HasherXXH64();
+    hasher.hash(&VERSION, sizeof(VERSION));
+    hasher.hash(&normal, sizeof(normal));
+    hasher.hash(&alpha_cutoff, sizeof(alpha_cutoff));
+    hasher.hash(&cook_format, sizeof(cook_format));
+
+    return hasher.value();
+}
+
+auto TextureFile::from_data(DerivedData derived_data) -> ls::option<TextureFile> {
+    ZoneScoped;
+
+    auto file_data = derived_data.data;
+    if (!is_asset_file_header_valid(file_data, AssetType::Texture, VERSION)) {
+        LOG_WARN("Cooked texture data is corrupt or out of date.");
+        return ls::nullopt;
+    }
+
+    const auto &texture_header = reinterpret_cast<const AssetFileHeader *>(file_data.data())->texture_header;
+    auto levels = get_asset_file_section<TextureFileLevel>(file_data, texture_header.levels_offset, texture_header.mip_level_count);
+    if (!levels.has_value() || texture_header.mip_level_count == 0) {
+        LOG_WARN("Cooked texture has corrupt level index.");
+        return ls::nullopt;
+    }
+
+    for (const auto &level : levels.value()) {
+        if (!get_asset_file_section<u8>(file_data, level.offset, level.size).has_value()) {
+            LOG_WARN("Cooked texture has levels out of bounds.");
+            return ls::nullopt;
+        }
+    }
+
+    return TextureFile{ .derived_data = std::move(derived_data) };
+}
+
+auto TextureFile::cook(ls::span<u8> image_bytes, bool normal, f32 alpha_cutoff) -> std::vector<u8> {
+    ZoneScoped;
+
+    auto mip_chain = decode_mip_chain(image_bytes, normal, alpha_cutoff);
+    if (!mip_chain.has_value()) {
+        return {};
+    }
+
+    auto extent = mip_chain->extent;
+    auto mip_level_count = mip_chain->mip_level_count;
+
+    //  ── BLOCK COMPRESSION ───────────────────────────────────────────────
+    auto pixel_format = normal ? vuk::Format::eR8G8B8A8Unorm : vuk::Format::eR8G8B8A8Srgb;
+    auto encoded = KTX2ImageInfo::encode(mip_chain->pixels, pixel_format, extent, mip_level_count, normal);
+    if (encoded.empty()) {
+        LOG_ERROR("Cannot cook texture, failed to encode image.");
+        return {};
+    }
+
+    // Levels are transcoded in parallel, their memory can't move afterwards.
+    auto levels = std::vector<TextureFileLevel>(mip_level_count);
+    auto level_data_size = 0_u64;
+    for (u32 level = 0; level < mip_level_count; level++) {
+        auto level_extent = vuk::Extent3D{
+            .width = ls::max(extent.width >> level, 1_u32),
+            .height = ls::max(extent.height >> level, 1_u32),
+            .depth = 1,
+        };
+        auto level_offset = align_asset_file_offset(level_data_size);
+        levels[level] = { .offset = level_offset, .size = vuk::compute_image_size(vuk::Format::eBc7UnormBlock, level_extent) };
+        level_data_size = level_offset + levels[level].size;
+    }
+
+    auto level_data = std::vector<u8>(level_data_size);
+    auto transcoded = KTX2ImageInfo::parse_into(encoded, vuk::Format::eBc7UnormBlock, [&](u32 level, vuk::Extent3D, usize) -> ls::span<u8> {
+        return ls::span<u8>(level_data.data() + levels[level].offset, levels[level].size);
+    });
+    if (!transcoded) {
+        LOG_ERROR("Cannot cook texture, failed to transcode image.");
+        return {};
+    }
+
+    //  ── SERIALIZE ───────────────────────────────────────────────────────
+    auto header = AssetFileHeader{};
+    header.version = VERSION;
+    header.type = AssetType::Texture;
+    auto &texture_header = header.texture_header;
+    texture_header.extent = extent;
+    texture_header.format = vuk::Format::eBc7UnormBlock;
+    texture_header.mip_level_count = mip_level_count;
+    texture_header.levels_offset = align_asset_file_offset(sizeof(AssetFileHeader));
+
+    auto data_offset = align_asset_file_offset(texture_header.levels_offset + ls::size_bytes(levels));
+    for (auto &level : levels) {
+        level.offset += data_offset;
+    }
+
+    auto contents = std::vector<u8>(data_offset + level_data.size(), 0);
+    std::memcpy(contents.data(), &header, sizeof(AssetFileHeader));
+    std::memcpy(contents.data() + texture_header.levels_offset, levels.data(), ls::size_bytes(levels));
+    std::memcpy(contents.data() + data_offset, level_data.data(), level_data.size());
+
+    return contents;
+}
+
+auto TextureFile::cook_ktx2(ls::span<u8> image_bytes, bool normal, f32 alpha_cutoff, TextureCookFormat cook_format) -> std::vector<u8> {
+    ZoneScoped;
+
+    auto mip_chain = decode_mip_chain(image_bytes, normal, alpha_cutoff);
+    if (!mip_chain.has_value()) {
+        return {};
+    }
+
+    auto codec = cook_format == TextureCookFormat::ETC1S ? KTX2Codec::ETC1S : KTX2Codec::UASTC;
+    auto pixel_format = normal ? vuk::Format::eR8G8B8A8Unorm : vuk::Format::eR8G8B8A8Srgb;
+    auto encoded = KTX2ImageInfo::encode(mip_chain->pixels, pixel_format, mip_chain->extent, mip_chain->mip_level_count, normal, codec);
+    if (encoded.empty()) {
+        LOG_ERROR("Cannot cook texture, failed to encode image.");
+    }
+
+    return encoded;
+}
+
+auto TextureFile::header(this TextureFile &self) -> const AssetFileHeader & {
+    return *reinterpret_cast<const AssetFileHeader *>(self.derived_data.data.data());
+}
+
+auto TextureFile::level_data(this TextureFile &self, u32 level) -> ls::span<u8> {
+    const auto &texture_header = self.header().texture_header;
+    LS_EXPECT(level < texture_header.mip_level_count);
+
+    // Bounds are validated in `from_data`
+    const auto *levels = reinterpret_cast<const TextureFileLevel *>(self.derived_data.data.data() + texture_header.levels_offset);
+    return ls::span<u8>(self.derived_data.data.data() + levels[level].offset, levels[level].size);
+}
+} // namespace lr
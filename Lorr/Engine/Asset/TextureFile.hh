@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Engine/Asset/AssetFile.hh"
+#include "Engine/Asset/DerivedDataCache.hh"
+
+namespace lr {
+// What PNG/JPEG textures are cooked into on import.
+enum class TextureCookFormat : u32 {
+    // `TextureFile`, BC7 only.
+    BC7 = 0,
+    // Basis encoded KTX2, transcoded for the device on load.
+    UASTC,
+    ETC1S,
+};
+
+struct TextureFileLevel {
+    u64 offset = 0;
+    u64 size = 0;
+};
+
+// Cooked texture, lives in `DerivedDataCache`. Block compressed with the
+// whole mip chain precomputed, each level is exactly what a buffer to
+// image copy of that mip expects.
+//
+// AssetFileHeader
+// TextureFileLevel[mip_level_count]
+// u8[] -- Level data, base level first
+//
+// Every level is 16 byte aligned. Bump `VERSION` whenever layout or
+// cooking code changes, cooking parameters are part of `params_hash`.
+struct TextureFile {
+    constexpr static u16 VERSION = 3;
+
+    DerivedData derived_data = {};
+
+    // Everything other than source contents that changes cooked output.
+    static auto params_hash(bool normal, f32 alpha_cutoff = 0.0f, TextureCookFormat cook_format = TextureCookFormat::BC7) -> u64;
+
+    // Returns nullopt when data isn't a cooked texture of current version.
+    static auto from_data(DerivedData derived_data) -> ls::option<TextureFile>;
+    // Decodes PNG/JPEG `image_bytes`, generates mips and compresses them to BC7.
+    // `alpha_cutoff` of masked materials keeps alpha test coverage of mips.
+    static auto cook(ls::span<u8> image_bytes, bool normal, f32 alpha_cutoff = 0.0f) -> std::vector<u8>;
+    // Same as `cook` but output is a KTX2 file of `cook_format`, loaded
+    // like any other KTX2 texture.
+    static auto cook_ktx2(ls::span<u8> image_bytes, bool normal, f32 alpha_cutoff, TextureCookFormat cook_format) -> std::vector<u8>;
+
+    auto header(this TextureFile &) -> const AssetFileHeader &;
+    auto level_data(this TextureFile &, u32 level) -> ls::span<u8>;
+};
+} // namespace lr
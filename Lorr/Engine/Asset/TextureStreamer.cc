@@ -0,0 +1,500 @@
+#include "Engine/Asset/TextureStreamer.hh"
+
+#include "Engine/Asset/Asset.hh"
+#include "Engine/Asset/TextureFile.hh"
+
+#include "Engine/Core/App.hh"
+
+#include "Engine/Graphics/VulkanDevice.hh"
+
+#include "Engine/Memory/Stack.hh"
+
+namespace lr {
+auto TextureStreamer::destroy(this TextureStreamer &self) -> void {
+    ZoneScoped;
+
+    auto in_flight_count = self.in_flight_count.load();
+    while (in_flight_count != 0) {
+        self.in_flight_count.wait(in_flight_count);
+        in_flight_count = self.in_flight_count.load();
+    }
+
+    auto &device = App::mod<Device>();
+    auto lock = std::unique_lock(self.mutex);
+    for (const auto &finished_image : self.finished_images) {
+        device.destroy(finished_image.image_view.id());
+        device.destroy(finished_image.image.id());
+    }
+
+    for (const auto &retired_image : self.retired_images) {
+        device.destroy(retired_image.image_view.id());
+        device.destroy(retired_image.image.id());
+    }
+
+    self.finished_images.clear();
+    self.retired_images.clear();
+    self.textures.clear();
+}
+
+auto TextureStreamer::mip_tail_level(vuk::Extent3D extent, u32 mip_level_count) -> u32 {
+    for (u32 level = 0; level < mip_level_count; level++) {
+        auto cur_extent = level_extent(extent, level);
+        if (ls::max(cur_extent.width, cur_extent.height) <= MIP_TAIL_SIZE) {
+            return level;
+        }
+    }
+
+    return mip_level_count - 1;
+}
+
+auto TextureStreamer::level_extent(vuk::Extent3D extent, u32 level) -> vuk::Extent3D {
+    return {
+        .width = ls::max(extent.width >> level, 1_u32),
+        .height = ls::max(extent.height >> level, 1_u32),
+        .depth = 1,
+    };
+}
+
+auto TextureStreamer::levels_size(vuk::Format format, vuk::Extent3D extent, u32 first_level, u32 mip_level_count) -> u64 {
+    auto size = 0_u64;
+    for (u32 level = first_level; level < mip_level_count; level++) {
+        size += vuk::compute_image_size(format, level_extent(extent, level));
+    }
+
+    return size;
+}
+
+auto TextureStreamer::upload_levels(
+    Device &device,
+    TextureFile &texture_file,
+    vuk::Value<vuk::ImageAttachment> dst_attachment,
+    vuk::Format format,
+    u32 first_level
+) -> ls::option<vuk::Value<vuk::ImageAttachment>> {
+    ZoneScoped;
+
+    auto &transfer_man = device.transfer_man();
+    const auto &texture_header = texture_file.header().texture_header;
+    auto staging_buffers = std::vector<vuk::Value<vuk::Buffer>>();
+    for (u32 level = first_level; level < texture_header.mip_level_count; level++) {
+        auto cur_extent = level_extent(texture_header.extent, level);
+        auto level_data = texture_file.level_data(level);
+        auto buffer_size = vuk::compute_image_size(format, cur_extent);
+        if (level_data.size_bytes() != buffer_size) {
+            LOG_ERROR("Cooked texture level {} doesn't match its format!", level);
+            transfer_man.discard_staging(staging_buffers);
+            return ls::nullopt;
+        }
+
+        auto buffer = transfer_man.alloc_image_buffer(format, cur_extent);
+        std::memcpy(buffer->mapped_ptr, level_data.data(), buffer_size);
+        staging_buffers.push_back(buffer);
+
+        auto dst_mip = dst_attachment.mip(level - first_level);
+        dst_mip = transfer_man.upload(std::move(buffer), std::move(dst_mip), transfer_man.transfer_domain());
+    }
+
+    // Image is concurrent, release only transitions it for sampling on
+    // graphics queue. There is no ownership to acquire.
+    return dst_attachment.as_released(vuk::Access::eFragmentSampled, vuk::DomainFlagBits::eGraphicsQueue);
+}
+
+auto TextureStreamer::copy_levels(
+    Device &device,
+    const ImageView &src_image_view,
+    u32 first_level,
+    vuk::Value<vuk::ImageAttachment> dst_attachment
+) -> vuk::Value<vuk::ImageAttachment> {
+    ZoneScoped;
+
+    // Resident image is sampled by graphics queue, copies stay on it.
+    auto &transfer_man = device.transfer_man();
+    auto src_attachment = src_image_view.acquire(
+        device,
+        "resident image",
+        vuk::ImageUsageFlagBits::eSampled | vuk::ImageUsageFlagBits::eTransferSrc,
+        vuk::Access::eFragmentSampled
+    );
+    auto copy_pass = vuk::make_pass(
+        "copy resident level",
+        [](vuk::CommandBuffer &cmd_list, //
+           VUK_IA(vuk::eTransferRead) src,
+           VUK_BA(vuk::eTransferWrite) dst) {
+            auto buffer_copy_region = vuk::BufferImageCopy{
+                .bufferOffset = dst->offset,
+                .imageSubresource = { .aspectMask = vuk::ImageAspectFlagBits::eColor,
+                                      .mipLevel = src->base_level,
+                                      .baseArrayLayer = src->base_layer,
+                                      .layerCount = 1 },
+                .imageOffset = {},
+                .imageExtent = level_extent(src->extent, src->base_level),
+            };
+            cmd_list.copy_image_to_buffer(src, dst, buffer_copy_region);
+            return dst;
+        },
+        vuk::DomainFlagBits::eGraphicsQueue
+    );
+
+    // Compressed formats can't be blitted, levels go through staging.
+    auto src_format = src_image_view.format();
+    auto src_extent = src_image_view.extent();
+    for (u32 level = first_level; level < src_image_view.mip_count(); level++) {
+        auto buffer = transfer_man.alloc_image_buffer(src_format, level_extent(src_extent, level));
+        buffer = copy_pass(src_attachment.mip(level), std::move(buffer));
+
+        auto dst_mip = dst_attachment.mip(level - first_level);
+        dst_mip = transfer_man.upload(std::move(buffer), std::move(dst_mip), vuk::DomainFlagBits::eGraphicsQueue);
+    }
+
+    // Resident image goes back to being sampled once copies are done.
+    auto release_pass = vuk::make_pass(
+        "release resident image",
+        [](vuk::CommandBuffer &, [[maybe_unused]] VUK_IA(vuk::eFragmentSampled) src, VUK_IA(vuk::eFragmentSampled) dst) { return dst; },
+        vuk::DomainFlagBits::eGraphicsQueue
+    );
+
+    return release_pass(std::move(src_attachment), std::move(dst_attachment));
+}
+
+auto TextureStreamer::add_texture(
+    this TextureStreamer &self,
+    const UUID &uuid,
+    ls::option<DerivedDataKey> key,
+    vuk::Format format,
+    vuk::Extent3D extent,
+    u32 mip_level_count,
+    u32 resident_mip
+) -> void {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    auto &texture = self.textures[uuid];
+    texture = {
+        .key = key,
+        .format = format,
+        .extent = extent,
+        .mip_level_count = mip_level_count,
+        .resident_mip = resident_mip,
+        .wanted_mip = resident_mip,
+        .demand_frame = 0,
+        .version = ++self.version_counter,
+        .in_flight = false,
+    };
+}
+
+auto TextureStreamer::remove_texture(this TextureStreamer &self, const UUID &uuid) -> void {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    self.textures.erase(uuid);
+}
+
+auto TextureStreamer::rename_texture(this TextureStreamer &self, const UUID &uuid, const UUID &new_uuid) -> void {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    auto it = self.textures.find(uuid);
+    if (it == self.textures.end()) {
+        return;
+    }
+
+    auto texture = it->second;
+    texture.version = ++self.version_counter;
+    texture.in_flight = false;
+    self.textures.erase(it);
+    self.textures.insert_or_assign(new_uuid, texture);
+}
+
+auto TextureStreamer::request(this TextureStreamer &self, const UUID &uuid, f32 screen_size) -> void {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    auto it = self.textures.find(uuid);
+    if (it == self.textures.end() || !it->second.key.has_value()) {
+        return;
+    }
+
+    // One texel per pixel, texture is assumed to be mapped once over the mesh.
+    auto &texture = it->second;
+    auto texture_size = static_cast<f32>(ls::max(texture.extent.width, texture.extent.height));
+    auto level = glm::floor(glm::log2(texture_size / ls::max(screen_size, 1.0f)));
+    auto wanted_mip = static_cast<u32>(glm::clamp(level, 0.0f, static_cast<f32>(mip_tail_level(texture.extent, texture.mip_level_count))));
+
+    // Several meshes can share a texture, finest one wins for this frame.
+    if (texture.demand_frame != self.frame_index) {
+        texture.wanted_mip = wanted_mip;
+        texture.demand_frame = self.frame_index;
+    } else {
+        texture.wanted_mip = ls::min(texture.wanted_mip, wanted_mip);
+    }
+}
+
+auto TextureStreamer::update(this TextureStreamer &self, AssetManager &asset_man) -> void {
+    ZoneScoped;
+
+    auto &device = App::mod<Device>();
+    auto lock = std::unique_lock(self.mutex);
+    self.frame_index++;
+
+    //  ── FINISHED IMAGES ─────────────────────────────────────────────────
+    auto dirty_texture_uuids = std::vector<UUID>();
+    for (auto &finished_image : self.finished_images) {
+        auto texture_it = self.textures.find(finished_image.uuid);
+        auto *asset = asset_man.get_asset(finished_image.uuid);
+        auto is_alive = texture_it != self.textures.end() && texture_it->second.version == finished_image.version && asset && asset->is_loaded();
+        if (!is_alive) {
+            self.retired_images.push_back({ .frame_index = self.frame_index, .image = finished_image.image, .image_view = finished_image.image_view });
+            continue;
+        }
+
+        auto &texture = texture_it->second;
+        texture.in_flight = false;
+        {
+            auto write_lock = std::unique_lock(asset_man.textures_mutex);
+            auto *texture_slot = asset_man.textures.slot(asset->texture_id);
+            self.retired_images.push_back({ .frame_index = self.frame_index, .image = texture_slot->image, .image_view = texture_slot->image_view });
+            texture_slot->image = finished_image.image;
+            texture_slot->image_view = finished_image.image_view;
+        }
+
+        texture.resident_mip = finished_image.resident_mip;
+        dirty_texture_uuids.push_back(finished_image.uuid);
+    }
+    self.finished_images.clear();
+
+    // Frames in flight might still sample retired images.
+    std::erase_if(self.retired_images, [&](const RetiredImage &retired_image) {
+        if (self.frame_index < retired_image.frame_index + device.frame_count() + 1) {
+            return false;
+        }
+
+        device.destroy(retired_image.image_view.id());
+        device.destroy(retired_image.image.id());
+        return true;
+    });
+
+    //  ── BUDGET ──────────────────────────────────────────────────────────
+    struct Candidate {
+        UUID uuid = {};
+        StreamedTexture *texture = nullptr;
+        u32 target_mip = 0;
+        u32 tail_mip = 0;
+    };
+    auto candidates = std::vector<Candidate>();
+    auto target_size = 0_u64;
+    for (auto &[uuid, texture] : self.textures) {
+        if (!texture.key.has_value()) {
+            target_size += levels_size(texture.format, texture.extent, texture.resident_mip, texture.mip_level_count);
+            continue;
+        }
+
+        auto tail_mip = mip_tail_level(texture.extent, texture.mip_level_count);
+        auto has_demand = texture.demand_frame != 0 && self.frame_index <= texture.demand_frame + DEMAND_LIFETIME_FRAMES;
+        auto target_mip = has_demand ? texture.wanted_mip : tail_mip;
+        target_size += levels_size(texture.format, texture.extent, target_mip, texture.mip_level_count);
+        candidates.push_back({ .uuid = uuid, .texture = &texture, .target_mip = target_mip, .tail_mip = tail_mip });
+    }
+
+    // Least recently demanded, then largest, gives up its finest mip first.
+    std::ranges::sort(candidates, [](const Candidate &lhs, const Candidate &rhs) {
+        if (lhs.texture->demand_frame != rhs.texture->demand_frame) {
+            return lhs.texture->demand_frame < rhs.texture->demand_frame;
+        }
+
+        return lhs.target_mip < rhs.target_mip;
+    });
+
+    auto over_budget = target_size > self.budget;
+    while (target_size > self.budget) {
+        auto reduced = false;
+        for (auto &candidate : candidates) {
+            if (candidate.target_mip >= candidate.tail_mip) {
+                continue;
+            }
+
+            auto &texture = *candidate.texture;
+            target_size -= vuk::compute_image_size(texture.format, level_extent(texture.extent, candidate.target_mip));
+            candidate.target_mip++;
+            reduced = true;
+            if (target_size <= self.budget) {
+                break;
+            }
+        }
+
+        // Only mip tails left
+        if (!reduced) {
+            break;
+        }
+    }
+
+    if (over_budget) {
+        LOG_TRACE("Texture streaming is over budget, trimmed to {} MiB.", target_size / (1024 * 1024));
+    }
+
+    //  ── SCHEDULE ────────────────────────────────────────────────────────
+    // Evictions first, they make room for the rest.
+    std::ranges::stable_sort(candidates, [](const Candidate &lhs, const Candidate &rhs) {
+        auto lhs_evicts = lhs.target_mip > lhs.texture->resident_mip;
+        auto rhs_evicts = rhs.target_mip > rhs.texture->resident_mip;
+        return lhs_evicts > rhs_evicts;
+    });
+
+    for (auto &candidate : candidates) {
+        auto &texture = *candidate.texture;
+        if (self.in_flight_count.load() >= MAX_IN_FLIGHT_COUNT) {
+            break;
+        }
+
+        if (texture.in_flight || candidate.target_mip == texture.resident_mip) {
+            continue;
+        }
+
+        self.stream(asset_man, candidate.uuid, texture, candidate.target_mip);
+    }
+
+    lock.unlock();
+    for (const auto &texture_uuid : dirty_texture_uuids) {
+        asset_man.set_texture_materials_dirty(texture_uuid);
+    }
+}
+
+auto TextureStreamer::stats(this TextureStreamer &self) -> TextureStreamingStats {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.mutex);
+    auto stats = TextureStreamingStats{ .budget = self.budget, .in_flight_count = self.in_flight_count.load() };
+    for (const auto &[uuid, texture] : self.textures) {
+        auto size = levels_size(texture.format, texture.extent, texture.resident_mip, texture.mip_level_count);
+        stats.resident_size += size;
+        if (texture.key.has_value()) {
+            stats.streamed_texture_count++;
+        } else {
+            stats.fixed_size += size;
+        }
+    }
+
+    return stats;
+}
+
+auto TextureStreamer::stream(this TextureStreamer &self, AssetManager &asset_man, const UUID &uuid, StreamedTexture &texture, u32 first_level)
+    -> void {
+    ZoneScoped;
+
+    texture.in_flight = true;
+    ++self.in_flight_count;
+
+    auto job = Job::create([&self,
+                            &asset_man,
+                            uuid,
+                            first_level,
+                            resident_mip = texture.resident_mip,
+                            key = texture.key.value(),
+                            format = texture.format,
+                            extent = texture.extent,
+                            mip_level_count = texture.mip_level_count,
+                            version = texture.version]() {
+        ZoneScopedN("Stream Texture");
+        memory::ScopedStack stack;
+
+        LS_DEFER(&) {
+            --self.in_flight_count;
+            self.in_flight_count.notify_all();
+        };
+
+        // Texture stays at what it has, cooked data is forgotten when it's gone.
+        auto cancel = [&](bool reset_key) {
+            auto lock = std::unique_lock(self.mutex);
+            auto it = self.textures.find(uuid);
+            if (it != self.textures.end() && it->second.version == version) {
+                it->second.in_flight = false;
+                if (reset_key) {
+                    it->second.key.reset();
+                }
+            }
+        };
+
+        // Evicted levels are dropped, kept ones are already on GPU.
+        auto is_eviction = first_level > resident_mip;
+        auto texture_file = ls::option<TextureFile>();
+        if (!is_eviction) {
+            if (auto derived_data = asset_man.derived_data_cache.get(key); derived_data.has_value()) {
+                texture_file = TextureFile::from_data(std::move(derived_data.value()));
+            }
+
+            if (!texture_file.has_value()) {
+                LOG_WARN("Texture {} can't be streamed, cooked data is gone.", uuid.str());
+                cancel(true);
+                return;
+            }
+        }
+
+        auto &device = App::mod<Device>();
+        auto image_mip_count = mip_level_count - first_level;
+        auto image_info = ImageInfo{
+            .format = format,
+            .usage = vuk::ImageUsageFlagBits::eSampled | vuk::ImageUsageFlagBits::eTransferSrc,
+            .type = vuk::ImageType::e2D,
+            .extent = level_extent(extent, first_level),
+            .slice_count = 1,
+            .mip_count = image_mip_count,
+            .name = stack.format("{} Streamed Image", uuid.str()),
+            .is_concurrent = true,
+        };
+        auto image = Image::create(device, image_info).value();
+
+        auto image_view_info = ImageViewInfo{
+            .image_usage = vuk::ImageUsageFlagBits::eSampled | vuk::ImageUsageFlagBits::eTransferSrc,
+            .type = vuk::ImageViewType::e2D,
+            .subresource_range = { .aspectMask = vuk::ImageAspectFlagBits::eColor,
+                                   .baseMipLevel = 0,
+                                   .levelCount = image_mip_count,
+                                   .baseArrayLayer = 0,
+                                   .layerCount = 1 },
+            .name = stack.format("{} Streamed Image View", uuid.str()),
+        };
+        auto image_view = ImageView::create(device, image, image_view_info).value();
+        auto dst_attachment = image_view.discard(device, "streamed image", vuk::ImageUsageFlagBits::eTransferDst);
+        auto drop = [&](bool reset_key) {
+            device.destroy(image_view.id());
+            device.destroy(image.id());
+            cancel(reset_key);
+        };
+
+        if (is_eviction) {
+            // Resident image is read until copies complete, freeing it waits
+            // on this lock.
+            auto read_lock = std::shared_lock(asset_man.textures_mutex);
+            auto *asset = asset_man.get_asset(uuid);
+            auto resident_image_view = ImageView{};
+            if (asset && asset->is_loaded()) {
+                resident_image_view = asset_man.textures.slot(asset->texture_id)->image_view;
+            }
+
+            // Texture got reloaded in the meantime, its levels aren't the ones
+            // this job was scheduled for.
+            if (!resident_image_view || resident_image_view.mip_count() != mip_level_count - resident_mip) {
+                read_lock.unlock();
+                drop(false);
+                return;
+            }
+
+            auto copied_attachment = copy_levels(device, resident_image_view, first_level - resident_mip, std::move(dst_attachment));
+            device.transfer_man().wait_on(std::move(copied_attachment));
+        } else {
+            auto uploaded_attachment = upload_levels(device, texture_file.value(), std::move(dst_attachment), format, first_level);
+            if (!uploaded_attachment.has_value()) {
+                drop(true);
+                return;
+            }
+
+            device.transfer_man().wait_on(std::move(uploaded_attachment.value()));
+        }
+
+        auto lock = std::unique_lock(self.mutex);
+        self.finished_images.push_back(
+            { .uuid = uuid, .version = version, .resident_mip = first_level, .image = image, .image_view = image_view }
+        );
+    });
+    App::submit_job(std::move(job));
+}
+} // namespace lr
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Engine/Asset/DerivedDataCache.hh"
+#include "Engine/Asset/Model.hh"
+
+namespace lr {
+struct AssetManager;
+struct Device;
+struct TextureFile;
+
+struct TextureStreamingStats {
+    u64 budget = 0;
+    u64 resident_size = 0;
+    // Part of `resident_size` that can't be streamed out.
+    u64 fixed_size = 0;
+    u32 streamed_texture_count = 0;
+    u32 in_flight_count = 0;
+};
+
+// Keeps mips that are actually visible resident. Streamed textures start
+// with their mip tail, finer mips are brought in from derived data cache
+// as scenes report screen space demand, and dropped again when they are
+// out of sight or the budget is exceeded. Dropping copies kept mips from
+// the resident image, it doesn't go back to the cache.
+//
+// Changing resident mips recreates the image with only those levels, so
+// VRAM use is what is resident, not what the full chains would take.
+// Demand and updates are expected from the main thread, images are built
+// in jobs.
+struct TextureStreamer {
+    // Levels at or below this size are always resident.
+    constexpr static u32 MIP_TAIL_SIZE = 128;
+    constexpr static u64 DEFAULT_BUDGET = 2_u64 * 1024 * 1024 * 1024;
+    // Demand outlives its last report for a while, so textures don't
+    // thrash as objects go in and out of view.
+    constexpr static u64 DEMAND_LIFETIME_FRAMES = 120;
+    constexpr static u32 MAX_IN_FLIGHT_COUNT = 4;
+
+    struct StreamedTexture {
+        // Textures not coming from derived data cache are always full.
+        ls::option<DerivedDataKey> key = ls::nullopt;
+        vuk::Format format = vuk::Format::eUndefined;
+        vuk::Extent3D extent = {};
+        u32 mip_level_count = 0;
+        // Finest level currently resident
+        u32 resident_mip = 0;
+        // Finest level demanded while `demand_frame` is alive
+        u32 wanted_mip = 0;
+        u64 demand_frame = 0;
+        // Bumped when texture is added again, results of older jobs are dropped.
+        u64 version = 0;
+        bool in_flight = false;
+    };
+
+    struct StreamedImage {
+        UUID uuid = {};
+        u64 version = 0;
+        u32 resident_mip = 0;
+        Image image = {};
+        ImageView image_view = {};
+    };
+
+    struct RetiredImage {
+        u64 frame_index = 0;
+        Image image = {};
+        ImageView image_view = {};
+    };
+
+    u64 budget = DEFAULT_BUDGET;
+    u64 frame_index = 0;
+    u64 version_counter = 0;
+
+    std::mutex mutex = {};
+    ankerl::unordered_dense::map<UUID, StreamedTexture> textures = {};
+    std::vector<StreamedImage> finished_images = {};
+    std::vector<RetiredImage> retired_images = {};
+    std::atomic<u32> in_flight_count = 0;
+
+    auto destroy(this TextureStreamer &) -> void;
+
+    // First level that is part of the mip tail.
+    static auto mip_tail_level(vuk::Extent3D extent, u32 mip_level_count) -> u32;
+    static auto level_extent(vuk::Extent3D extent, u32 level) -> vuk::Extent3D;
+    static auto levels_size(vuk::Format format, vuk::Extent3D extent, u32 first_level, u32 mip_level_count) -> u64;
+    // Records copies of levels starting from `first_level` of `texture_file`
+    // into `dst_attachment` mips starting from 0. Returned attachment is
+    // released for sampling, caller waits on or batches it.
+    static auto upload_levels(
+        Device &device,
+        TextureFile &texture_file,
+        vuk::Value<vuk::ImageAttachment> dst_attachment,
+        vuk::Format format,
+        u32 first_level
+    ) -> ls::option<vuk::Value<vuk::ImageAttachment>>;
+    // Records copies of levels starting from `first_level` of resident
+    // `src_image_view` into `dst_attachment` mips starting from 0, on
+    // graphics queue. Returned attachment is ready for sampling.
+    static auto copy_levels(
+        Device &device,
+        const ImageView &src_image_view,
+        u32 first_level,
+        vuk::Value<vuk::ImageAttachment> dst_attachment
+    ) -> vuk::Value<vuk::ImageAttachment>;
+
+    auto add_texture(
+        this TextureStreamer &,
+        const UUID &uuid,
+        ls::option<DerivedDataKey> key,
+        vuk::Format format,
+        vuk::Extent3D extent,
+        u32 mip_level_count,
+        u32 resident_mip
+    ) -> void;
+    auto remove_texture(this TextureStreamer &, const UUID &uuid) -> void;
+    // Texture keeps its resident levels under `new_uuid`, results of jobs
+    // in flight for `uuid` are dropped.
+    auto rename_texture(this TextureStreamer &, const UUID &uuid, const UUID &new_uuid) -> void;
+
+    // Texture is going to cover `screen_size` pixels this frame.
+    auto request(this TextureStreamer &, const UUID &uuid, f32 screen_size) -> void;
+    // Swaps in finished images, evicts and schedules new levels. Once per frame.
+    auto update(this TextureStreamer &, AssetManager &asset_man) -> void;
+
+    auto stats(this TextureStreamer &) -> TextureStreamingStats;
+
+private:
+    auto stream(this TextureStreamer &, AssetManager &asset_man, const UUID &uuid, StreamedTexture &texture, u32 first_level) -> void;
+};
+} // namespace lr
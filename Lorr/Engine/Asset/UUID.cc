@@ -70,6 +70,17 @@ auto UUID::from_string(std::string_view str) -> ls::option<UUID> {
     return uuid;
 }
 
+auto UUID::from_bytes(const std::array<u8, 16> &bytes) -> UUID {
+    UUID uuid = {};
+    uuid.data._u8_arr = bytes;
+
+#ifdef LS_DEBUG
+    uuid.debug = uuid.str();
+#endif
+
+    return uuid;
+}
+
 auto UUID::str() const -> std::string {
     ZoneScoped;
 
@@ -18,6 +18,7 @@ public:
 
     static auto generate_random() -> UUID;
     static auto from_string(std::string_view str) -> ls::option<UUID>;
+    static auto from_bytes(const std::array<u8, 16> &bytes) -> UUID;
 
     auto str() const -> std::string;
 
@@ -0,0 +1,49 @@
+#include "Engine/Asset/VertexQuantization.hh"
+
+#include <meshoptimizer.h>
+
+namespace lr {
+auto quantize_position(glm::vec3 position, glm::vec3 position_min, glm::vec3 position_extent) -> std::array<u16, 4> {
+    auto quantized = std::array<u16, 4>{};
+    for (i32 i = 0; i < 3; i++) {
+        auto t = position_extent[i] > 0.0f ? (position[i] - position_min[i]) / position_extent[i] : 0.0f;
+        quantized[i] = static_cast<u16>(meshopt_quantizeUnorm(t, 16));
+    }
+
+    return quantized;
+}
+
+auto dequantize_position(const std::array<u16, 4> &quantized, glm::vec3 offset, glm::vec3 scale) -> glm::vec3 {
+    return offset + glm::vec3(quantized[0], quantized[1], quantized[2]) * scale;
+}
+
+auto encode_octahedral_unorm16(glm::vec3 v) -> u32 {
+    auto l1_norm = glm::abs(v.x) + glm::abs(v.y) + glm::abs(v.z);
+    auto n = l1_norm > 0.0f ? glm::vec2(v.x, v.y) / l1_norm : glm::vec2(0.0f);
+    if (v.z < 0.0f) {
+        auto sign = glm::vec2(n.x > 0.0f ? 1.0f : -1.0f, n.y > 0.0f ? 1.0f : -1.0f);
+        n = (1.0f - glm::abs(glm::vec2(n.y, n.x))) * sign;
+    }
+
+    n = n * 0.5f + 0.5f;
+    return static_cast<u32>(meshopt_quantizeUnorm(n.x, 16)) | (static_cast<u32>(meshopt_quantizeUnorm(n.y, 16)) << 16);
+}
+
+auto decode_octahedral_unorm16(u32 encoded) -> glm::vec3 {
+    auto f = glm::vec2(static_cast<f32>(encoded & 0xffff), static_cast<f32>(encoded >> 16)) / 65535.0f * 2.0f - 1.0f;
+    auto n = glm::vec3(f.x, f.y, 1.0f - glm::abs(f.x) - glm::abs(f.y));
+    auto t = glm::clamp(-n.z, 0.0f, 1.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+
+    return glm::normalize(n);
+}
+
+auto quantize_texcoord(glm::vec2 texcoord) -> u32 {
+    return static_cast<u32>(meshopt_quantizeHalf(texcoord.x)) | (static_cast<u32>(meshopt_quantizeHalf(texcoord.y)) << 16);
+}
+
+auto dequantize_texcoord(u32 quantized) -> glm::vec2 {
+    return glm::unpackHalf2x16(quantized);
+}
+} // namespace lr
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace lr {
+//  ── VERTEX QUANTIZATION ─────────────────────────────────────────────
+// Vertex stream encodings of `GPU::MeshFlag`. Decoders do exactly what
+// `scene.slang` does, cooking reads positions back through them so CPU
+// side data matches what gets drawn.
+//
+
+// u16x4, unorm inside `[position_min, position_min + position_extent]`.
+// Axes without extent are all zero.
+auto quantize_position(glm::vec3 position, glm::vec3 position_min, glm::vec3 position_extent) -> std::array<u16, 4>;
+// `offset + quantized * scale`, scale is `position_extent / 65535`.
+auto dequantize_position(const std::array<u16, 4> &quantized, glm::vec3 offset, glm::vec3 scale) -> glm::vec3;
+
+// Unit vector to octahedral u16x2 unorm, `std::octahedral_decode` reads it.
+auto encode_octahedral_unorm16(glm::vec3 v) -> u32;
+auto decode_octahedral_unorm16(u32 encoded) -> glm::vec3;
+
+// f16x2
+auto quantize_texcoord(glm::vec2 texcoord) -> u32;
+auto dequantize_texcoord(u32 quantized) -> glm::vec2;
+} // namespace lr
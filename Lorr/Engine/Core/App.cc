@@ -77,6 +77,9 @@ auto AppBuilder::build(this AppBuilder &self, u32 worker_count, const c8 *log_fi
 
     fmtlog::setLogFile(log_file_name, true);
 
+    // Workers start timing jobs as soon as they are created.
+    TSCClock::calibrate();
+
     APP.emplace(worker_count, std::move(self.registry));
     APP->run();
 
@@ -2,7 +2,7 @@
 
 #include "Engine/Memory/Stack.hh"
 
-#include "Engine/OS/OS.hh"
+#include "Engine/OS/Timer.hh"
 
 namespace lr {
 auto Barrier::create() -> Arc<Barrier> {
@@ -102,9 +102,21 @@ auto JobManager::worker(this JobManager &self, u32 id) -> void {
         self.jobs.pop_front();
         lock.unlock();
 
+        auto start_ts = TSCClock::now();
         job->task();
+        auto end_ts = TSCClock::now();
         self.job_count.fetch_sub(1);
 
+        auto latency_ticks = start_ts - job->submit_ts;
+        self.completed_job_count.fetch_add(1, std::memory_order_relaxed);
+        self.total_latency_ticks.fetch_add(latency_ticks, std::memory_order_relaxed);
+        self.total_run_ticks.fetch_add(end_ts - start_ts, std::memory_order_relaxed);
+        auto max_latency_ticks = self.max_latency_ticks.load(std::memory_order_relaxed);
+        while (latency_ticks > max_latency_ticks &&
+               !self.max_latency_ticks.compare_exchange_weak(max_latency_ticks, latency_ticks, std::memory_order_relaxed))
+            ;
+        TracyPlot("Job Latency (us)", TSCClock::to_us(latency_ticks));
+
         for (auto &barrier : job->barriers) {
             if (--barrier->counter == 0) {
                 for (auto &task : barrier->pending) {
@@ -120,6 +132,8 @@ auto JobManager::worker(this JobManager &self, u32 id) -> void {
 auto JobManager::submit(this JobManager &self, Arc<Job> job, bool prioritize) -> void {
     ZoneScoped;
 
+    job->submit_ts = TSCClock::now();
+
     {
         std::unique_lock _(self.mutex);
         if (prioritize) {
@@ -140,4 +154,82 @@ auto JobManager::wait(this JobManager &self) -> void {
         ;
 }
 
+auto JobManager::worker_count(this JobManager &self) -> u32 {
+    return static_cast<u32>(self.workers.size());
+}
+
+// Outlives `parallel_for` for jobs that start after it returned.
+struct ParallelForChunks {
+    std::atomic<u32> next_chunk = 0;
+    std::atomic<u32> finished_chunk_count = 0;
+    u32 chunk_count = 0;
+    u32 grain_size = 0;
+    u32 count = 0;
+    // Only touched after claiming a chunk, caller is still waiting then.
+    const std::function<void(u32, u32)> *fn = nullptr;
+
+    auto run(this ParallelForChunks &self) -> void {
+        for (auto chunk = self.next_chunk.fetch_add(1); chunk < self.chunk_count; chunk = self.next_chunk.fetch_add(1)) {
+            auto first = chunk * self.grain_size;
+            auto last = ls::min(first + self.grain_size, self.count);
+            (*self.fn)(first, last);
+
+            if (self.finished_chunk_count.fetch_add(1) + 1 == self.chunk_count) {
+                self.finished_chunk_count.notify_all();
+            }
+        }
+    }
+};
+
+auto JobManager::parallel_for(this JobManager &self, u32 count, u32 grain_size, const std::function<void(u32 first, u32 last)> &fn) -> void {
+    ZoneScoped;
+
+    grain_size = ls::max(grain_size, 1_u32);
+    auto chunk_count = count / grain_size + (count % grain_size != 0 ? 1 : 0);
+    if (chunk_count == 0) {
+        return;
+    }
+
+    if (chunk_count == 1 || self.workers.empty()) {
+        fn(0, count);
+        return;
+    }
+
+    auto chunks = std::make_shared<ParallelForChunks>();
+    chunks->chunk_count = chunk_count;
+    chunks->grain_size = grain_size;
+    chunks->count = count;
+    chunks->fn = &fn;
+
+    auto job_count = ls::min(self.worker_count(), chunk_count - 1);
+    for (u32 i = 0; i < job_count; i++) {
+        self.submit(Job::create([chunks]() { chunks->run(); }));
+    }
+
+    chunks->run();
+
+    auto finished_chunk_count = chunks->finished_chunk_count.load();
+    while (finished_chunk_count != chunk_count) {
+        chunks->finished_chunk_count.wait(finished_chunk_count);
+        finished_chunk_count = chunks->finished_chunk_count.load();
+    }
+}
+
+auto JobManager::stats(this JobManager &self) -> JobStats {
+    ZoneScoped;
+
+    auto completed_job_count = self.completed_job_count.load(std::memory_order_relaxed);
+    if (completed_job_count == 0) {
+        return {};
+    }
+
+    auto job_count = static_cast<f64>(completed_job_count);
+    return JobStats{
+        .completed_job_count = completed_job_count,
+        .avg_latency_us = TSCClock::to_us(self.total_latency_ticks.load(std::memory_order_relaxed)) / job_count,
+        .max_latency_us = TSCClock::to_us(self.max_latency_ticks.load(std::memory_order_relaxed)),
+        .avg_run_time_us = TSCClock::to_us(self.total_run_ticks.load(std::memory_order_relaxed)) / job_count,
+    };
+}
+
 } // namespace lr
@@ -25,6 +25,8 @@ struct JobManager;
 struct Job : ManagedObj {
     std::vector<Arc<Barrier>> barriers = {};
     JobFn task = {};
+    // TSC ticks, set when job is pushed into the queue.
+    u64 submit_ts = 0;
 
     static auto create_explicit(JobFn task) -> Arc<Job>;
     template<typename Fn>
@@ -41,6 +43,14 @@ struct ThreadWorker {
 
 inline thread_local ThreadWorker this_thread_worker;
 
+struct JobStats {
+    u64 completed_job_count = 0;
+    // Time spent in queue before a worker picked the job up.
+    f64 avg_latency_us = 0.0;
+    f64 max_latency_us = 0.0;
+    f64 avg_run_time_us = 0.0;
+};
+
 struct JobManager {
 private:
     std::vector<std::jthread> workers = {};
@@ -50,6 +60,11 @@ private:
     std::atomic<u64> job_count = {};
     bool running = true;
 
+    std::atomic<u64> completed_job_count = {};
+    std::atomic<u64> total_latency_ticks = {};
+    std::atomic<u64> max_latency_ticks = {};
+    std::atomic<u64> total_run_ticks = {};
+
 public:
     JobManager(u32 threads);
     ~JobManager();
@@ -58,6 +73,15 @@ public:
     auto worker(this JobManager &self, u32 id) -> void;
     auto submit(this JobManager &self, Arc<Job> job, bool prioritize = false) -> void;
     auto wait(this JobManager &self) -> void;
+    auto worker_count(this JobManager &self) -> u32;
+    // Calls `fn(first, last)` for chunks of `[0, count)`, `grain_size` each.
+    // Calling thread takes chunks too and only waits for chunks that other
+    // threads already started, so it's safe to call from workers. Jobs that
+    // start late find nothing left.
+    auto parallel_for(this JobManager &self, u32 count, u32 grain_size, const std::function<void(u32 first, u32 last)> &fn) -> void;
+
+    // Accumulated since start.
+    auto stats(this JobManager &self) -> JobStats;
 };
 
 } // namespace lr
@@ -58,6 +58,9 @@ struct ImageInfo {
     u32 slice_count = 1;
     u32 mip_count = 1;
     std::string_view name = {};
+    // Written on asset upload queue and used on others. Shared between
+    // queue families, there is no ownership to transfer.
+    bool is_concurrent = false;
 };
 struct Image {
     static auto create(Device &, const ImageInfo &info, LR_THISCALL) -> std::expected<Image, vuk::VkException>;
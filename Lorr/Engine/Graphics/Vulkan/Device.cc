@@ -7,6 +7,7 @@ PFN_vkCreateDescriptorPool vk_CreateDescriptorPool;
 PFN_vkCreateDescriptorSetLayout vk_CreateDescriptorSetLayout;
 PFN_vkAllocateDescriptorSets vk_AllocateDescriptorSets;
 PFN_vkUpdateDescriptorSets vk_UpdateDescriptorSets;
+PFN_vkGetPhysicalDeviceFormatProperties vk_GetPhysicalDeviceFormatProperties;
 
 namespace lr {
 constexpr fmtlog::LogLevel to_log_category(VkDebugUtilsMessageSeverityFlagBitsEXT severity) {
@@ -201,18 +202,23 @@ auto Device::init(this Device &self) -> bool {
     vk_CreateDescriptorSetLayout = vulkan_functions.vkCreateDescriptorSetLayout;
     vk_AllocateDescriptorSets = vulkan_functions.vkAllocateDescriptorSets;
     vk_UpdateDescriptorSets = vulkan_functions.vkUpdateDescriptorSets;
+    vk_GetPhysicalDeviceFormatProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceFormatProperties>(
+        self.instance.fp_vkGetInstanceProcAddr(self.instance, "vkGetPhysicalDeviceFormatProperties")
+    );
 
     auto physical_device_properties = VkPhysicalDeviceProperties{};
     vulkan_functions.vkGetPhysicalDeviceProperties(self.physical_device, &physical_device_properties);
     self.device_limits = physical_device_properties.limits;
 
     std::vector<std::unique_ptr<vuk::Executor>> executors;
+    auto upload_domain = vuk::DomainFlagBits::eAny;
 
     auto graphics_queue = self.handle.get_queue(vkb::QueueType::graphics).value();
     auto graphics_queue_family_index = self.handle.get_queue_index(vkb::QueueType::graphics).value();
     executors.push_back(
         vuk::create_vkqueue_executor(vulkan_functions, self.handle, graphics_queue, graphics_queue_family_index, vuk::DomainFlagBits::eGraphicsQueue)
     );
+    self.queue_family_indices.push_back(graphics_queue_family_index);
 
 #ifndef LR_USE_LLVMPIPE
     auto compute_queue = self.handle.get_queue(vkb::QueueType::compute).value();
@@ -220,12 +226,43 @@ auto Device::init(this Device &self) -> bool {
     executors.push_back(
         vuk::create_vkqueue_executor(vulkan_functions, self.handle, compute_queue, compute_queue_family_index, vuk::DomainFlagBits::eComputeQueue)
     );
+    if (!std::ranges::contains(self.queue_family_indices, compute_queue_family_index)) {
+        self.queue_family_indices.push_back(compute_queue_family_index);
+    }
 
-    auto transfer_queue = self.handle.get_queue(vkb::QueueType::transfer).value();
-    auto transfer_queue_family_index = self.handle.get_queue_index(vkb::QueueType::transfer).value();
-    executors.push_back(
-        vuk::create_vkqueue_executor(vulkan_functions, self.handle, transfer_queue, transfer_queue_family_index, vuk::DomainFlagBits::eTransferQueue)
-    );
+    // Family with transfer only is a copy engine that runs next to
+    // rendering, any other family without graphics is still better than
+    // sharing graphics queue with frames.
+    auto transfer_queue = self.handle.get_dedicated_queue(vkb::QueueType::transfer);
+    auto transfer_queue_family_index = self.handle.get_dedicated_queue_index(vkb::QueueType::transfer);
+    auto is_dedicated_transfer_queue = transfer_queue.has_value() && transfer_queue_family_index.has_value();
+    if (!is_dedicated_transfer_queue) {
+        transfer_queue = self.handle.get_queue(vkb::QueueType::transfer);
+        transfer_queue_family_index = self.handle.get_queue_index(vkb::QueueType::transfer);
+    }
+
+    if (transfer_queue.has_value() && transfer_queue_family_index.has_value()) {
+        executors.push_back(
+            vuk::create_vkqueue_executor(
+                vulkan_functions,
+                self.handle,
+                transfer_queue.value(),
+                transfer_queue_family_index.value(),
+                vuk::DomainFlagBits::eTransferQueue
+            )
+        );
+        upload_domain = vuk::DomainFlagBits::eTransferQueue;
+        if (!std::ranges::contains(self.queue_family_indices, transfer_queue_family_index.value())) {
+            self.queue_family_indices.push_back(transfer_queue_family_index.value());
+        }
+        LOG_INFO(
+            "Asset uploads use {} transfer queue family {}.",
+            is_dedicated_transfer_queue ? "dedicated" : "separate",
+            transfer_queue_family_index.value()
+        );
+    } else {
+        LOG_WARN("Device has no separate transfer queue, asset uploads share graphics queue.");
+    }
 #endif
 
     executors.push_back(std::make_unique<vuk::ThisThreadExecutor>());
@@ -245,6 +282,7 @@ auto Device::init(this Device &self) -> bool {
     self.shader_compiler = SlangCompiler::create().value();
 
     self.transfer_manager.init(self).value();
+    self.transfer_manager.asset_upload_domain = upload_domain;
     self.transfer_manager.acquire(self.frame_resources.value());
 
     LOG_INFO("Initialized device.");
@@ -579,6 +617,16 @@ auto Device::set_name(this Device &self, ImageView &image_view, std::string_view
     self.runtime->set_name(self.image_view(image_view.id())->payload, name);
 }
 
+auto Device::is_sampled_format_supported(this Device &self, vuk::Format format) -> bool {
+    ZoneScoped;
+
+    auto format_properties = VkFormatProperties{};
+    vk_GetPhysicalDeviceFormatProperties(self.physical_device, static_cast<VkFormat>(format), &format_properties);
+
+    auto required_features = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+    return (format_properties.optimalTilingFeatures & required_features) == required_features;
+}
+
 auto Device::frame_count(this const Device &self) -> usize {
     return self.frames_in_flight;
 }
@@ -18,6 +18,12 @@ auto Image::create(Device &device, const ImageInfo &info, LR_CALLSTACK) -> std::
         .arrayLayers = info.slice_count,
         .usage = info.usage | vuk::ImageUsageFlagBits::eTransferDst,
     };
+    if (info.is_concurrent && device.queue_family_indices.size() > 1) {
+        create_info.sharingMode = vuk::SharingMode::eConcurrent;
+        create_info.queueFamilyIndexCount = static_cast<u32>(device.queue_family_indices.size());
+        create_info.pQueueFamilyIndices = device.queue_family_indices.data();
+    }
+
     auto image_handle = vuk::Image{};
     auto result = device.allocator->allocate_images({ &image_handle, 1 }, { &create_info, 1 }, LOC);
     if (!result.holds_value()) {
@@ -1,24 +1,172 @@
 #include "Engine/Graphics/VulkanDevice.hh"
 
+#include "Engine/Core/App.hh"
+
 namespace lr {
+auto StagingRing::init(this StagingRing &self, vuk::Buffer &&buffer_) -> void {
+    self.buffer = buffer_;
+    self.block_count = self.buffer.size / BLOCK_SIZE;
+    self.head = 0;
+    self.tail = 0;
+    self.retired_blocks = std::make_unique<std::atomic<u64>[]>((self.block_count + 63) / 64);
+    self.tracked_ranges = std::make_unique<TrackedRange[]>(self.block_count);
+}
+
+auto StagingRing::allocate(this StagingRing &self, u64 size) -> ls::option<StagingRange> {
+    ZoneScoped;
+
+    auto block_count = ls::max((size + BLOCK_SIZE - 1) / BLOCK_SIZE, 1_u64);
+    if (block_count > self.block_count) {
+        return ls::nullopt;
+    }
+
+    auto head = self.head.load(std::memory_order_relaxed);
+    auto first_block = 0_u64;
+    while (true) {
+        // Ranges don't wrap around, blocks skipped at the end are retired
+        // right away.
+        first_block = head;
+        auto wrapped_block = first_block % self.block_count;
+        if (wrapped_block + block_count > self.block_count) {
+            first_block += self.block_count - wrapped_block;
+        }
+
+        if (first_block + block_count - self.tail.load(std::memory_order_acquire) > self.block_count) {
+            return ls::nullopt;
+        }
+
+        if (self.head.compare_exchange_weak(head, first_block + block_count, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    if (first_block != head) {
+        self.retire({ .first_block = head, .block_count = first_block - head });
+    }
+
+    return StagingRange{ .first_block = first_block, .block_count = block_count };
+}
+
+auto StagingRing::retire(this StagingRing &self, StagingRange range) -> void {
+    for (auto block = range.first_block; block < range.first_block + range.block_count; block++) {
+        auto wrapped_block = block % self.block_count;
+        self.retired_blocks[wrapped_block / 64].fetch_or(1_u64 << (wrapped_block % 64), std::memory_order_release);
+    }
+}
+
+auto StagingRing::range_of(this StagingRing &self, const vuk::Buffer &buffer) -> ls::option<StagingRange> {
+    if (buffer.buffer != self.buffer.buffer || buffer.offset < self.buffer.offset || buffer.offset >= self.buffer.offset + self.buffer.size) {
+        return ls::nullopt;
+    }
+
+    // Wrapped position, `retire` takes either.
+    auto first_block = (buffer.offset - self.buffer.offset) / BLOCK_SIZE;
+    auto block_count = ls::max((buffer.size + BLOCK_SIZE - 1) / BLOCK_SIZE, 1_u64);
+    return StagingRange{ .first_block = first_block, .block_count = block_count };
+}
+
+auto StagingRing::track(this StagingRing &self, StagingRange range, vuk::Value<vuk::Buffer> value) -> void {
+    auto &tracked_range = self.tracked_ranges[range.first_block % self.block_count];
+    tracked_range.block_count = range.block_count;
+    tracked_range.value = std::move(value);
+    tracked_range.is_tracked.store(true, std::memory_order_release);
+}
+
+auto StagingRing::reclaim(this StagingRing &self) -> u64 {
+    ZoneScoped;
+
+    auto head = self.head.load(std::memory_order_acquire);
+    auto tail = self.tail.load(std::memory_order_relaxed);
+    auto reclaimed_count = 0_u64;
+    while (tail < head) {
+        auto wrapped_block = tail % self.block_count;
+        auto block_bit = 1_u64 << (wrapped_block % 64);
+        auto &retired_word = self.retired_blocks[wrapped_block / 64];
+        if (retired_word.load(std::memory_order_acquire) & block_bit) {
+            // Cleared before tail moves, next owner of the block starts unretired.
+            retired_word.fetch_and(~block_bit, std::memory_order_relaxed);
+            // Discarded ranges are retired while still tracked.
+            auto &tracked_range = self.tracked_ranges[wrapped_block];
+            if (tracked_range.is_tracked.load(std::memory_order_acquire)) {
+                tracked_range.value = {};
+                tracked_range.is_tracked.store(false, std::memory_order_relaxed);
+            }
+
+            tail++;
+            reclaimed_count++;
+            continue;
+        }
+
+        // Tracked ranges complete in submission order mostly, one that
+        // isn't done yet holds the tail just like an unretired block.
+        auto &tracked_range = self.tracked_ranges[wrapped_block];
+        if (!tracked_range.is_tracked.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        if (*tracked_range.value.poll() != vuk::Signal::Status::eHostAvailable) {
+            break;
+        }
+
+        tail += tracked_range.block_count;
+        reclaimed_count += tracked_range.block_count;
+        tracked_range.value = {};
+        tracked_range.is_tracked.store(false, std::memory_order_relaxed);
+    }
+
+    self.tail.store(tail, std::memory_order_release);
+
+    return reclaimed_count;
+}
+
 auto TransferManager::init(Device &device_) -> std::expected<void, vuk::VkException> {
     ZoneScoped;
 
     this->device = &device_;
 
+    auto ring_buffer = vuk::Buffer{};
+    auto ring_buffer_info = vuk::BufferCreateInfo{ .mem_usage = vuk::MemoryUsage::eCPUonly, .size = STAGING_RING_SIZE, .alignment = StagingRing::BLOCK_SIZE };
+    auto result = this->device->allocator->allocate_buffers({ &ring_buffer, 1 }, { &ring_buffer_info, 1 });
+    if (!result.holds_value()) {
+        return std::unexpected(result.error());
+    }
+
+    this->staging_ring.init(std::move(ring_buffer));
+
     return {};
 }
 
 auto TransferManager::destroy(this TransferManager &self) -> void {
     ZoneScoped;
 
+    self.wait_uploads();
     self.release();
+
+    for (auto &staging_buffer : self.staging_buffers) {
+        auto evaluated_buffer = vuk::eval<vuk::Buffer>(staging_buffer.get_head());
+        if (evaluated_buffer.holds_value()) {
+            self.device->allocator->deallocate({ &evaluated_buffer.value(), 1 });
+        }
+    }
+
+    self.staging_buffers.clear();
+    for (u64 i = 0; i < self.staging_ring.block_count; i++) {
+        self.staging_ring.tracked_ranges[i].value = {};
+    }
+
+    self.device->allocator->deallocate({ &self.staging_ring.buffer, 1 });
 }
 
 auto TransferManager::alloc_transient_buffer(this TransferManager &self, vuk::MemoryUsage usage, usize size, vuk::source_location LOC) noexcept
     -> vuk::Value<vuk::Buffer> {
     ZoneScoped;
 
+    if (usage == vuk::MemoryUsage::eCPUtoGPU || usage == vuk::MemoryUsage::eCPUonly) {
+        return self.alloc_staging("transient buffer", size, self.device->non_coherent_atom_size(), LOC);
+    }
+
+    // Frame allocator is swapped in `acquire`, allocating from it is thread safe.
+    auto read_lock = std::shared_lock(self.mutex);
     auto buffer = vuk::Buffer{};
     auto buffer_info = vuk::BufferCreateInfo{ .mem_usage = usage, .size = size, .alignment = self.device->non_coherent_atom_size() };
     self.frame_allocator->allocate_buffers({ &buffer, 1 }, { &buffer_info, 1 }, LOC);
@@ -30,22 +178,82 @@ auto TransferManager::alloc_image_buffer(this TransferManager &self, vuk::Format
     -> vuk::Value<vuk::Buffer> {
     ZoneScoped;
 
-    auto write_lock = std::unique_lock(self.mutex);
     auto alignment = vuk::format_to_texel_block_size(format);
     auto size = vuk::compute_image_size(format, extent);
 
+    return self.alloc_staging("image buffer", size, alignment, LOC);
+}
+
+auto TransferManager::alloc_staging_buffer(this TransferManager &self, usize size, vuk::source_location LOC) noexcept -> vuk::Value<vuk::Buffer> {
+    ZoneScoped;
+
+    return self.alloc_staging("staging buffer", size, self.device->non_coherent_atom_size(), LOC);
+}
+
+auto TransferManager::discard_staging(this TransferManager &self, ls::span<vuk::Value<vuk::Buffer>> buffers) -> void {
+    ZoneScoped;
+
+    for (auto &buffer : buffers) {
+        const auto &buffer_handle = *buffer;
+        if (auto ring_range = self.staging_ring.range_of(buffer_handle); ring_range.has_value()) {
+            self.staging_ring.retire(ring_range.value());
+            continue;
+        }
+
+        auto lock = std::unique_lock(self.staging_buffers_mutex);
+        for (auto it = self.staging_buffers.begin(); it != self.staging_buffers.end(); ++it) {
+            auto staging_buffer = **it;
+            if (staging_buffer.buffer == buffer_handle.buffer && staging_buffer.offset == buffer_handle.offset) {
+                self.device->allocator->deallocate({ &staging_buffer, 1 });
+                self.staging_buffers.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+auto TransferManager::alloc_staging(this TransferManager &self, vuk::Name name, u64 size, u64 alignment, vuk::source_location LOC)
+    -> vuk::Value<vuk::Buffer> {
+    ZoneScoped;
+
+    // Ring blocks are aligned way more than any texel block or atom.
+    auto ring_range = ls::option<StagingRange>();
+    if (size <= STAGING_RING_MAX_ALLOCATION_SIZE && alignment <= StagingRing::BLOCK_SIZE) {
+        ring_range = self.staging_ring.allocate(size);
+    }
+
     auto buffer_handle = vuk::Buffer{};
-    auto buffer_info = vuk::BufferCreateInfo{ .mem_usage = vuk::MemoryUsage::eCPUtoGPU, .size = size, .alignment = alignment };
-    self.device->allocator->allocate_buffers({ &buffer_handle, 1 }, { &buffer_info, 1 }, LOC);
+    if (ring_range.has_value()) {
+        auto ring_offset = (ring_range->first_block % self.staging_ring.block_count) * StagingRing::BLOCK_SIZE;
+        buffer_handle = self.staging_ring.buffer.subrange(ring_offset, size);
+    } else {
+        ZoneScopedN("Dedicated Staging Allocation");
+        auto buffer_info = vuk::BufferCreateInfo{ .mem_usage = vuk::MemoryUsage::eCPUonly, .size = size, .alignment = alignment };
+        self.device->allocator->allocate_buffers({ &buffer_handle, 1 }, { &buffer_info, 1 }, LOC);
+    }
 
-    auto buffer = vuk::acquire_buf("image buffer", buffer_handle, vuk::eNone, LOC);
-    self.image_buffers.emplace(buffer);
+    auto buffer = vuk::acquire_buf(name, buffer_handle, vuk::eNone, LOC);
+    if (ring_range.has_value()) {
+        self.staging_ring.track(ring_range.value(), buffer);
+    } else {
+        auto lock = std::unique_lock(self.staging_buffers_mutex);
+        self.staging_buffers.emplace(buffer);
+    }
 
     return buffer;
 }
 
-auto TransferManager::upload(this TransferManager &, vuk::Value<vuk::Buffer> &&src, vuk::Value<vuk::Buffer> &&dst, vuk::source_location LOC)
-    -> vuk::Value<vuk::Buffer> {
+auto TransferManager::transfer_domain(this TransferManager &self) -> vuk::DomainFlagBits {
+    return self.asset_upload_domain;
+}
+
+auto TransferManager::upload(
+    this TransferManager &,
+    vuk::Value<vuk::Buffer> &&src,
+    vuk::Value<vuk::Buffer> &&dst,
+    vuk::DomainFlagBits domain,
+    vuk::source_location LOC
+) -> vuk::Value<vuk::Buffer> {
     ZoneScoped;
 
     auto upload_pass = vuk::make_pass(
@@ -54,16 +262,20 @@ auto TransferManager::upload(this TransferManager &, vuk::Value<vuk::Buffer> &&s
             cmd_list.copy_buffer(src_ba, dst_ba);
             return dst_ba;
         },
-        vuk::DomainFlagBits::eAny,
+        domain,
         LOC
     );
 
     return upload_pass(std::move(src), std::move(dst));
 }
 
-[[nodiscard]]
-auto TransferManager::upload(this TransferManager &, vuk::Value<vuk::Buffer> &&src, vuk::Value<vuk::ImageAttachment> &&dst, vuk::source_location LOC)
-    -> vuk::Value<vuk::ImageAttachment> {
+auto TransferManager::upload(
+    this TransferManager &,
+    vuk::Value<vuk::Buffer> &&src,
+    vuk::Value<vuk::ImageAttachment> &&dst,
+    vuk::DomainFlagBits domain,
+    vuk::source_location LOC
+) -> vuk::Value<vuk::ImageAttachment> {
     ZoneScoped;
 
     auto upload_pass = vuk::make_pass(
@@ -73,14 +285,19 @@ auto TransferManager::upload(this TransferManager &, vuk::Value<vuk::Buffer> &&s
            VUK_IA(vuk::eTransferWrite) dst) {
             auto buffer_copy_region = vuk::BufferImageCopy{
                 .bufferOffset = src->offset,
-                .imageSubresource = { .aspectMask = vuk::ImageAspectFlagBits::eColor, .layerCount = 1 },
+                .imageSubresource = { .aspectMask = vuk::ImageAspectFlagBits::eColor,
+                                      .mipLevel = dst->base_level,
+                                      .baseArrayLayer = dst->base_layer,
+                                      .layerCount = 1 },
                 .imageOffset = {},
-                .imageExtent = dst->extent,
+                .imageExtent = { .width = ls::max(dst->extent.width >> dst->base_level, 1_u32),
+                                 .height = ls::max(dst->extent.height >> dst->base_level, 1_u32),
+                                 .depth = ls::max(dst->extent.depth >> dst->base_level, 1_u32) },
             };
             cmd_list.copy_buffer_to_image(src, dst, buffer_copy_region);
             return dst;
         },
-        vuk::DomainFlagBits::eAny,
+        domain,
         LOC
     );
 
@@ -127,6 +344,127 @@ auto TransferManager::wait_on(this TransferManager &self, vuk::UntypedValue &&fu
 #endif
 }
 
+auto TransferManager::batch_upload(this TransferManager &self, vuk::UntypedValue &&value, u64 size_bytes) -> u64 {
+    ZoneScoped;
+
+    auto lock = std::unique_lock(self.upload_mutex);
+    auto upload_value = self.open_upload_value;
+    self.open_upload_batch.push_back(std::move(value));
+    self.open_upload_batch_size += size_bytes;
+    auto is_full = self.open_upload_batch_size >= UPLOAD_BATCH_SIZE;
+    lock.unlock();
+
+    if (is_full) {
+        self.flush_uploads();
+    }
+
+    return upload_value;
+}
+
+auto TransferManager::flush_uploads(this TransferManager &self) -> void {
+    ZoneScoped;
+
+    // One queued job is enough, it takes whatever is recorded once it runs.
+    if (self.upload_job_queued.exchange(true)) {
+        return;
+    }
+
+    auto job = Job::create([&self]() { self.submit_uploads(); });
+    App::submit_job(std::move(job));
+}
+
+auto TransferManager::submit_uploads(this TransferManager &self, ls::option<u64> until_value) -> void {
+    ZoneScoped;
+
+    thread_local vuk::Compiler upload_compiler;
+    auto submit_lock = std::unique_lock(self.upload_submit_mutex);
+    // Uploads recorded after this point get a job of their own.
+    self.upload_job_queued = false;
+
+    while (true) {
+        auto batch = std::vector<vuk::UntypedValue>();
+        auto upload_value = 0_u64;
+        {
+            auto lock = std::unique_lock(self.upload_mutex);
+            if (self.open_upload_batch.empty() || (until_value.has_value() && self.completed_upload_value >= until_value.value())) {
+                return;
+            }
+
+            batch = std::move(self.open_upload_batch);
+            upload_value = self.open_upload_value++;
+            self.open_upload_batch.clear();
+            self.open_upload_batch_size = 0;
+        }
+
+        {
+            ZoneScopedN("Wait Upload Batch");
+            vuk::wait_for_values_explicit(self.device->get_allocator(), upload_compiler, batch, {});
+        }
+
+        auto callbacks = std::vector<std::function<void()>>();
+        {
+            auto lock = std::unique_lock(self.upload_mutex);
+            self.completed_upload_value = upload_value;
+            for (auto it = self.upload_callbacks.begin(); it != self.upload_callbacks.end();) {
+                if (it->n0 <= upload_value) {
+                    callbacks.push_back(std::move(it->n1));
+                    it = self.upload_callbacks.erase(it);
+                    continue;
+                }
+
+                ++it;
+            }
+        }
+
+        self.completed_upload_value.notify_all();
+        for (auto &callback : callbacks) {
+            callback();
+        }
+    }
+}
+
+auto TransferManager::on_upload_complete(this TransferManager &self, u64 upload_value, std::function<void()> callback) -> void {
+    ZoneScoped;
+
+    {
+        auto lock = std::unique_lock(self.upload_mutex);
+        if (self.completed_upload_value < upload_value) {
+            self.upload_callbacks.emplace_back(upload_value, std::move(callback));
+            return;
+        }
+    }
+
+    callback();
+}
+
+auto TransferManager::is_upload_complete(this TransferManager &self, u64 upload_value) -> bool {
+    return self.completed_upload_value >= upload_value;
+}
+
+auto TransferManager::wait_upload(this TransferManager &self, u64 upload_value) -> void {
+    ZoneScoped;
+
+    if (self.is_upload_complete(upload_value)) {
+        return;
+    }
+
+    // Batch of `upload_value` is either being submitted, which holds the
+    // submit lock until it completes, or still open and submitted here.
+    self.submit_uploads(upload_value);
+}
+
+auto TransferManager::wait_uploads(this TransferManager &self) -> void {
+    ZoneScoped;
+
+    auto upload_value = 0_u64;
+    {
+        auto lock = std::unique_lock(self.upload_mutex);
+        upload_value = self.open_upload_batch.empty() ? self.open_upload_value - 1 : self.open_upload_value;
+    }
+
+    self.wait_upload(upload_value);
+}
+
 auto TransferManager::wait_for_ops(this TransferManager &self, vuk::Compiler &compiler) -> void {
     ZoneScoped;
 
@@ -142,18 +480,22 @@ auto TransferManager::acquire(this TransferManager &self, vuk::DeviceSuperFrameR
     auto &frame_resource = super_frame_resource.get_next_frame();
     self.frame_allocator.emplace(frame_resource);
 
-    for (auto it = self.image_buffers.begin(); it != self.image_buffers.end();) {
-        auto image_buffer = &*it;
-        if (*image_buffer->poll() == vuk::Signal::Status::eHostAvailable) {
-            auto evaluated_buffer = vuk::eval<vuk::Buffer>(image_buffer->get_head());
-            LS_EXPECT(evaluated_buffer.holds_value());
-            self.device->allocator->deallocate({ &evaluated_buffer.value(), 1 });
-            it = self.image_buffers.erase(it);
+    auto staging_lock = std::unique_lock(self.staging_buffers_mutex);
+    for (auto it = self.staging_buffers.begin(); it != self.staging_buffers.end();) {
+        auto &staging_buffer = *it;
+        if (*staging_buffer.poll() != vuk::Signal::Status::eHostAvailable) {
+            ++it;
             continue;
         }
 
-        ++it;
+        auto evaluated_buffer = vuk::eval<vuk::Buffer>(staging_buffer.get_head());
+        LS_EXPECT(evaluated_buffer.holds_value());
+        self.device->allocator->deallocate({ &evaluated_buffer.value(), 1 });
+        it = self.staging_buffers.erase(it);
     }
+
+    staging_lock.unlock();
+    self.staging_ring.reclaim();
 }
 
 auto TransferManager::release(this TransferManager &self) -> void {
@@ -15,15 +15,81 @@
 #include <vuk/vsl/Core.hpp>
 
 namespace lr {
+// Range of blocks in `StagingRing`, positions only ever grow and wrap
+// around with modulo block count.
+struct StagingRange {
+    u64 first_block = 0;
+    u64 block_count = 0;
+};
+
+// Single persistently mapped buffer that staging memory is carved from.
+// Producers take blocks from head with a CAS, blocks are retired in any
+// order by setting their bit, tail passes retired blocks in order.
+struct StagingRing {
+    constexpr static u64 BLOCK_SIZE = 64 * 1024;
+
+    // Slot of a range's first block, only its owner writes it until
+    // `reclaim` sees the value done.
+    struct TrackedRange {
+        std::atomic<bool> is_tracked = false;
+        u64 block_count = 0;
+        vuk::Value<vuk::Buffer> value = {};
+    };
+
+    vuk::Buffer buffer = {};
+    u64 block_count = 0;
+    std::atomic<u64> head = 0;
+    std::atomic<u64> tail = 0;
+    std::unique_ptr<std::atomic<u64>[]> retired_blocks = {};
+    std::unique_ptr<TrackedRange[]> tracked_ranges = {};
+
+    auto init(this StagingRing &, vuk::Buffer &&buffer_) -> void;
+    // Lock free, returns nullopt when ring doesn't have enough free blocks.
+    auto allocate(this StagingRing &, u64 size) -> ls::option<StagingRange>;
+    auto retire(this StagingRing &, StagingRange range) -> void;
+    // Range `buffer` was carved from, nullopt when it's not a subrange of ring.
+    auto range_of(this StagingRing &, const vuk::Buffer &buffer) -> ls::option<StagingRange>;
+    // Lock free, range is retired by `reclaim` once `value` is host available.
+    auto track(this StagingRing &, StagingRange range, vuk::Value<vuk::Buffer> value) -> void;
+    // Called from one thread only, returns number of blocks reclaimed.
+    auto reclaim(this StagingRing &) -> u64;
+};
+
 struct TransferManager {
+    // Open batch is submitted once it gets this large, even if nobody flushed it.
+    constexpr static u64 UPLOAD_BATCH_SIZE = 64 * 1024 * 1024;
+    constexpr static u64 STAGING_RING_SIZE = 256 * 1024 * 1024;
+    // Larger uploads get allocations of their own, ring is left to streaming.
+    constexpr static u64 STAGING_RING_MAX_ALLOCATION_SIZE = STAGING_RING_SIZE / 4;
+
 private:
     Device *device = nullptr;
 
     mutable std::shared_mutex mutex = {};
     std::vector<vuk::UntypedValue> futures = {};
-    plf::colony<vuk::Value<vuk::Buffer>> image_buffers = {};
+
+    StagingRing staging_ring = {};
+    // Dedicated staging allocations in use, deallocated once the submission
+    // that reads them is done. Ring ranges are tracked by the ring itself.
+    std::mutex staging_buffers_mutex = {};
+    plf::colony<vuk::Value<vuk::Buffer>> staging_buffers = {};
 
     ls::option<vuk::Allocator> frame_allocator;
+    // Dedicated transfer queue when device has one, see `transfer_domain`.
+    vuk::DomainFlagBits asset_upload_domain = vuk::DomainFlagBits::eAny;
+
+    // Uploads are recorded into the open batch, batches are submitted in
+    // order and each one completes a timeline value. Everything recorded
+    // with value N is on GPU once `completed_upload_value >= N`.
+    std::mutex upload_mutex = {};
+    std::vector<vuk::UntypedValue> open_upload_batch = {};
+    u64 open_upload_batch_size = 0;
+    u64 open_upload_value = 1;
+    std::vector<ls::pair<u64, std::function<void()>>> upload_callbacks = {};
+    // Held by whoever is submitting, keeps batches completing in order.
+    std::mutex upload_submit_mutex = {};
+    std::atomic<bool> upload_job_queued = false;
+    std::atomic<u64> completed_upload_value = 0;
 
     friend Device;
 
@@ -34,18 +100,48 @@ public:
     auto init(Device &) -> std::expected<void, vuk::VkException>;
     auto destroy(this TransferManager &) -> void;
 
+    // CPU written ones are copy sources, they come from `StagingRing` like
+    // staging buffers. Rest are from frame allocator.
     [[nodiscard]]
     auto alloc_transient_buffer(this TransferManager &, vuk::MemoryUsage usage, usize size, LR_THISCALL) noexcept -> vuk::Value<vuk::Buffer>;
 
     [[nodiscard]]
     auto alloc_image_buffer(this TransferManager &, vuk::Format format, vuk::Extent3D extent, LR_THISCALL) noexcept -> vuk::Value<vuk::Buffer>;
 
+    // CPU visible and not tied to a frame, batched uploads can outlive
+    // frames in flight before they are submitted. Both staging allocations
+    // come from `StagingRing`, no allocator calls unless it is full or
+    // upload is larger than `STAGING_RING_MAX_ALLOCATION_SIZE`.
     [[nodiscard]]
-    auto upload(this TransferManager &, vuk::Value<vuk::Buffer> &&src, vuk::Value<vuk::Buffer> &&dst, LR_THISCALL) -> vuk::Value<vuk::Buffer>;
+    auto alloc_staging_buffer(this TransferManager &, usize size, LR_THISCALL) noexcept -> vuk::Value<vuk::Buffer>;
+    // Staging that will never be submitted, from loads that fail after
+    // allocating it. Ring blocks would hold the tail forever otherwise.
+    auto discard_staging(this TransferManager &, ls::span<vuk::Value<vuk::Buffer>> buffers) -> void;
+
+    // Domain asset loads and streaming upload on. Copies there don't
+    // stall frame rendering. Buffers and concurrent images are shared
+    // with the queue that uses them, results are released to it and
+    // nothing acquires them.
+    auto transfer_domain(this TransferManager &) -> vuk::DomainFlagBits;
 
     [[nodiscard]]
-    auto upload(this TransferManager &, vuk::Value<vuk::Buffer> &&src, vuk::Value<vuk::ImageAttachment> &&dst, LR_THISCALL)
-        -> vuk::Value<vuk::ImageAttachment>;
+    auto upload(
+        this TransferManager &,
+        vuk::Value<vuk::Buffer> &&src,
+        vuk::Value<vuk::Buffer> &&dst,
+        vuk::DomainFlagBits domain = vuk::DomainFlagBits::eAny,
+        LR_THISCALL
+    ) -> vuk::Value<vuk::Buffer>;
+
+    // `dst` can be a single mip or layer of an image.
+    [[nodiscard]]
+    auto upload(
+        this TransferManager &,
+        vuk::Value<vuk::Buffer> &&src,
+        vuk::Value<vuk::ImageAttachment> &&dst,
+        vuk::DomainFlagBits domain = vuk::DomainFlagBits::eAny,
+        LR_THISCALL
+    ) -> vuk::Value<vuk::ImageAttachment>;
 
     template<typename T>
     [[nodiscard]] auto upload(this TransferManager &self, ls::span<T> span, vuk::Value<vuk::Buffer> &&dst, LR_THISCALL) -> vuk::Value<vuk::Buffer> {
@@ -53,7 +149,7 @@ public:
 
         auto src = self.alloc_transient_buffer(vuk::MemoryUsage::eCPUtoGPU, span.size_bytes(), LOC);
         std::memcpy(src->mapped_ptr, span.data(), span.size_bytes());
-        return self.upload(std::move(src), std::move(dst), LOC);
+        return self.upload(std::move(src), std::move(dst), vuk::DomainFlagBits::eAny, LOC);
     }
 
     template<typename T>
@@ -65,10 +161,27 @@ public:
 
     auto wait_on(this TransferManager &, vuk::UntypedValue &&fut) -> void;
 
+    // Adds `value` to open batch instead of waiting on it, returns the
+    // timeline value it completes with. Sources must come from
+    // `alloc_staging_buffer` or `alloc_image_buffer`.
+    auto batch_upload(this TransferManager &, vuk::UntypedValue &&value, u64 size_bytes) -> u64;
+    // Submits open batch on a job, uploads recorded until it runs go with it.
+    auto flush_uploads(this TransferManager &) -> void;
+    // Runs on the thread that completes `upload_value`, or immediately when
+    // it is already complete. Don't wait on uploads inside.
+    auto on_upload_complete(this TransferManager &, u64 upload_value, std::function<void()> callback) -> void;
+    auto is_upload_complete(this TransferManager &, u64 upload_value) -> bool;
+    // Submits pending batches on calling thread when needed.
+    auto wait_upload(this TransferManager &, u64 upload_value) -> void;
+    // Waits for everything recorded so far.
+    auto wait_uploads(this TransferManager &) -> void;
+
 protected:
     [[nodiscard]] auto scratch_buffer(this TransferManager &, const void *data, u64 size, LR_THISCALL) -> vuk::Value<vuk::Buffer>;
     auto wait_for_ops(this TransferManager &, vuk::Compiler &compiler) -> void;
+    auto submit_uploads(this TransferManager &, ls::option<u64> until_value = ls::nullopt) -> void;
 
+    auto alloc_staging(this TransferManager &, vuk::Name name, u64 size, u64 alignment, LR_CALLSTACK) -> vuk::Value<vuk::Buffer>;
     auto acquire(this TransferManager &, vuk::DeviceSuperFrameResource &super_frame_resource) -> void;
     auto release(this TransferManager &) -> void;
 };
@@ -109,6 +222,9 @@ private:
     vkb::Device handle = {};
 
     VkPhysicalDeviceLimits device_limits = {};
+    // Families of queues executors run on, concurrent images are shared
+    // between them.
+    std::vector<u32> queue_family_indices = {};
 
     friend Buffer;
     friend Image;
@@ -144,6 +260,8 @@ public:
     auto set_name(this Device &, Image &image, std::string_view name) -> void;
     auto set_name(this Device &, ImageView &image_view, std::string_view name) -> void;
 
+    // Can images of `format` be sampled and copied into with optimal tiling.
+    auto is_sampled_format_supported(this Device &, vuk::Format format) -> bool;
     auto frame_count(this const Device &) -> usize;
     auto buffer(this Device &, BufferID) -> ls::option<vuk::Buffer>;
     auto image(this Device &, ImageID) -> ls::option<vuk::Image>;
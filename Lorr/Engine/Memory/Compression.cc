@@ -39,7 +39,20 @@ std::vector<u8> CompressorLZ4::compress(void *src_data, usize src_size) {
 void CompressorLZ4::reset() {
     ZoneScoped;
 
-    LZ4_initStream(this->handle, sizeof(LZ4_stream_t *));
+    LZ4_initStream(this->handle, sizeof(LZ4_stream_t));
+}
+
+bool CompressorLZ4::decompress(const void *src_data, usize src_size, void *dst_data, usize dst_size) {
+    ZoneScoped;
+
+    auto decompressed_size = LZ4_decompress_safe(
+        reinterpret_cast<const c8 *>(src_data),
+        reinterpret_cast<c8 *>(dst_data),
+        static_cast<i32>(src_size),
+        static_cast<i32>(dst_size)
+    );
+
+    return decompressed_size >= 0 && static_cast<usize>(decompressed_size) == dst_size;
 }
 
 CompressorZSTD::CompressorZSTD() {
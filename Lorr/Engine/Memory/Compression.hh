@@ -12,6 +12,8 @@ struct CompressorLZ4 : CompressorI {
     ~CompressorLZ4() override;
     std::vector<u8> compress(void *src_data, usize src_size) override;
     void reset() override;
+    // Only for data compressed right after a reset, `dst_size` must be exact.
+    static bool decompress(const void *src_data, usize src_size, void *dst_data, usize dst_size);
 
     void *handle = nullptr;
 };
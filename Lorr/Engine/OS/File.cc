@@ -84,4 +84,31 @@ auto File::to_stderr(std::string_view str) -> void {
     os::file_stderr(str);
 }
 
+MappedFile::MappedFile(const fs::path &path) {
+    ZoneScoped;
+
+    this->file = File(path, FileAccess::Read);
+    if (!this->file || this->file.size == 0) {
+        return;
+    }
+
+    auto *mapped_ptr = os::file_map(this->file.handle.value(), this->file.size);
+    if (!mapped_ptr) {
+        return;
+    }
+
+    this->data = ls::span<u8>(static_cast<u8 *>(mapped_ptr), this->file.size);
+}
+
+auto MappedFile::unmap() -> void {
+    ZoneScoped;
+
+    if (!this->data.empty()) {
+        os::file_unmap(this->data.data(), this->data.size());
+        this->data = {};
+    }
+
+    this->file.close();
+}
+
 } // namespace lr
@@ -41,4 +41,36 @@ struct File {
     }
 };
 
+// Read only view of a whole file, pages are faulted in on first access.
+struct MappedFile {
+    File file = {};
+    ls::span<u8> data = {};
+
+    MappedFile() = default;
+    MappedFile(const fs::path &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&rhs) noexcept {
+        *this = std::move(rhs);
+    }
+    ~MappedFile() {
+        unmap();
+    }
+
+    auto unmap() -> void;
+
+    MappedFile &operator=(MappedFile &&rhs) noexcept {
+        unmap();
+
+        this->file = std::move(rhs.file);
+        this->data = rhs.data;
+
+        rhs.data = {};
+
+        return *this;
+    }
+    explicit operator bool() {
+        return !data.empty();
+    }
+};
+
 } // namespace lr
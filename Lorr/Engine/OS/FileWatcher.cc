@@ -0,0 +1,294 @@
+#include "Engine/OS/FileWatcher.hh"
+
+namespace lr {
+// Engine data like `.cache` lives in dot-directories, derived data cache
+// writes there constantly. Same rule as `AssetManager::import_project`.
+static auto is_ignored_directory(const fs::path &path) -> bool {
+    return path.filename().string().starts_with('.');
+}
+
+// Recursive listing of `path` without ignored directories and their contents.
+template<typename FnT>
+static auto for_each_watched_entry(const fs::path &path, FnT &&fn) -> void {
+    auto ec = std::error_code{};
+    auto it = fs::recursive_directory_iterator(path, ec);
+    for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        const auto &entry = *it;
+        auto entry_ec = std::error_code{};
+        auto is_directory = entry.is_directory(entry_ec);
+        if (is_directory && is_ignored_directory(entry.path())) {
+            it.disable_recursion_pending();
+            continue;
+        }
+
+        fn(entry, is_directory);
+    }
+}
+
+auto FileWatcher::init(this FileWatcher &self, const fs::path &root_path) -> bool {
+    ZoneScoped;
+
+    auto descriptor = os::file_watcher_init();
+    if (!descriptor.has_value()) {
+        if (descriptor.error() == FileResult::Unsupported) {
+            LOG_WARN("File watching is only supported on Linux, changes to '{}' won't be picked up.", root_path);
+        } else {
+            LOG_ERROR("Failed to initialize file watcher for '{}'!", root_path);
+        }
+
+        return false;
+    }
+
+    self.descriptor = descriptor.value();
+    self.root_path = root_path;
+    if (!self.watch_directory(root_path)) {
+        self.destroy();
+        return false;
+    }
+
+    return true;
+}
+
+auto FileWatcher::destroy(this FileWatcher &self) -> void {
+    ZoneScoped;
+
+    if (!self.is_watching()) {
+        return;
+    }
+
+    for (const auto &[watch_descriptor, _] : self.watched_dirs) {
+        os::file_watcher_remove(self.descriptor, watch_descriptor);
+    }
+
+    os::file_watcher_destroy(self.descriptor);
+    self.watched_dirs.clear();
+    self.pending_events.clear();
+    self.suppressed_paths.clear();
+    self.scanned_entries.clear();
+}
+
+auto FileWatcher::is_watching(this FileWatcher &self) -> bool {
+    return self.descriptor.handle != FileDescriptor::Invalid;
+}
+
+auto FileWatcher::watch_directory(this FileWatcher &self, const fs::path &path) -> bool {
+    ZoneScoped;
+
+    if (!self.add_watch(path)) {
+        return false;
+    }
+
+    for_each_watched_entry(path, [&](const fs::directory_entry &entry, bool is_directory) {
+        if (is_directory) {
+            self.add_watch(entry.path());
+        }
+
+        auto ec = std::error_code{};
+        auto write_time = entry.last_write_time(ec).time_since_epoch().count();
+        self.scanned_entries.insert_or_assign(entry.path(), ScannedEntry{ .write_time = write_time, .is_directory = is_directory });
+    });
+
+    return true;
+}
+
+auto FileWatcher::suppress(this FileWatcher &self, const fs::path &path) -> void {
+    ZoneScoped;
+
+    if (self.is_watching()) {
+        self.suppressed_paths.emplace(path);
+    }
+}
+
+auto FileWatcher::poll(this FileWatcher &self) -> std::vector<FileEvent> {
+    ZoneScoped;
+
+    if (!self.is_watching()) {
+        return {};
+    }
+
+    self.raw_events.clear();
+    if (!os::file_watcher_read(self.descriptor, self.raw_events)) {
+        LOG_ERROR("Failed to read file watcher events of '{}'!", self.root_path);
+    }
+
+    //  ── COALESCE ────────────────────────────────────────────────────────
+    auto overflowed = false;
+    for (const auto &event : self.raw_events) {
+        if (event.action_mask & FileActionMask::Overflow) {
+            overflowed = true;
+            continue;
+        }
+
+        auto dir_it = self.watched_dirs.find(event.watch_descriptor);
+        if (dir_it == self.watched_dirs.end()) {
+            continue;
+        }
+
+        auto path = dir_it->second / event.file_name;
+        auto is_directory = static_cast<bool>(event.action_mask & FileActionMask::Directory);
+        if (is_directory && is_ignored_directory(path)) {
+            continue;
+        }
+
+        self.touch(path, event.action_mask, event.watch_descriptor);
+        if (!is_directory) {
+            continue;
+        }
+
+        if (event.action_mask & FileActionMask::Create) {
+            // Contents of moved in or freshly created directories may
+            // exist before we start watching, report them as new.
+            self.watch_directory(path);
+            for_each_watched_entry(path, [&](const fs::directory_entry &entry, bool is_entry_directory) {
+                auto entry_mask = FileActionMask::Create;
+                if (is_entry_directory) {
+                    entry_mask |= FileActionMask::Directory;
+                }
+
+                self.touch(entry.path(), entry_mask, event.watch_descriptor);
+            });
+        }
+
+        if (event.action_mask & FileActionMask::Delete) {
+            // Kernel drops watches of removed directories on its own
+            auto removed_watches = std::vector<FileDescriptor>();
+            for (const auto &[watch_descriptor, dir_path] : self.watched_dirs) {
+                auto [mismatch_it, _] = std::mismatch(path.begin(), path.end(), dir_path.begin(), dir_path.end());
+                if (mismatch_it == path.end()) {
+                    removed_watches.push_back(watch_descriptor);
+                }
+            }
+
+            for (auto watch_descriptor : removed_watches) {
+                self.watched_dirs.erase(watch_descriptor);
+            }
+        }
+    }
+
+    if (overflowed) {
+        LOG_WARN("File watcher of '{}' lost events, rescanning.", self.root_path);
+        self.rescan();
+    }
+
+    //  ── SETTLE ──────────────────────────────────────────────────────────
+    auto now = std::chrono::steady_clock::now();
+    auto settled_events = std::vector<FileEvent>();
+    auto settled_paths = std::vector<fs::path>();
+    for (const auto &[path, pending] : self.pending_events) {
+        if (now - pending.last_event_ts < SETTLE_DURATION) {
+            continue;
+        }
+
+        settled_paths.push_back(path);
+        auto is_directory = static_cast<bool>(pending.action_mask & FileActionMask::Directory);
+        auto ec = std::error_code{};
+        auto exists = fs::exists(path, ec);
+        if (exists) {
+            auto write_time = fs::last_write_time(path, ec).time_since_epoch().count();
+            self.scanned_entries.insert_or_assign(path, ScannedEntry{ .write_time = write_time, .is_directory = is_directory });
+        } else {
+            self.scanned_entries.erase(path);
+            if (is_directory) {
+                auto removed_paths = std::vector<fs::path>();
+                for (const auto &[scanned_path, _] : self.scanned_entries) {
+                    auto [mismatch_it, _2] = std::mismatch(path.begin(), path.end(), scanned_path.begin(), scanned_path.end());
+                    if (mismatch_it == path.end()) {
+                        removed_paths.push_back(scanned_path);
+                    }
+                }
+
+                for (const auto &removed_path : removed_paths) {
+                    self.scanned_entries.erase(removed_path);
+                }
+            }
+        }
+
+        if (self.suppressed_paths.erase(path) != 0) {
+            continue;
+        }
+
+        auto action_mask = is_directory ? FileActionMask::Directory : FileActionMask::None;
+        if (exists) {
+            action_mask |= (pending.action_mask & FileActionMask::Create) ? FileActionMask::Create : FileActionMask::Modify;
+        } else if ((pending.action_mask & FileActionMask::Delete) && !(pending.action_mask & FileActionMask::Create)) {
+            action_mask |= FileActionMask::Delete;
+        } else {
+            // Created and removed in the same window, a temporary file.
+            continue;
+        }
+
+        settled_events.push_back(FileEvent{ .file_name = path, .action_mask = action_mask, .watch_descriptor = pending.watch_descriptor });
+    }
+
+    for (const auto &path : settled_paths) {
+        self.pending_events.erase(path);
+    }
+
+    return settled_events;
+}
+
+auto FileWatcher::add_watch(this FileWatcher &self, const fs::path &path) -> bool {
+    auto watch_descriptor = os::file_watcher_add(self.descriptor, path);
+    if (!watch_descriptor.has_value()) {
+        LOG_ERROR("Failed to watch directory '{}'!", path);
+        return false;
+    }
+
+    self.watched_dirs.insert_or_assign(watch_descriptor.value(), path);
+    return true;
+}
+
+auto FileWatcher::touch(this FileWatcher &self, const fs::path &path, FileActionMask action_mask, FileDescriptor watch_descriptor) -> void {
+    auto &pending = self.pending_events[path];
+    pending.action_mask |= action_mask;
+    pending.watch_descriptor = watch_descriptor;
+    pending.last_event_ts = std::chrono::steady_clock::now();
+}
+
+auto FileWatcher::rescan(this FileWatcher &self) -> void {
+    ZoneScoped;
+
+    auto seen_paths = ankerl::unordered_dense::set<fs::path>();
+    for_each_watched_entry(self.root_path, [&](const fs::directory_entry &entry, bool is_directory) {
+        const auto &path = entry.path();
+        auto directory_mask = is_directory ? FileActionMask::Directory : FileActionMask::None;
+        seen_paths.emplace(path);
+        if (is_directory) {
+            // Adding a watch twice returns the same one, only new
+            // directories get a new watch.
+            self.add_watch(path);
+        }
+
+        auto scanned_it = self.scanned_entries.find(path);
+        if (scanned_it == self.scanned_entries.end()) {
+            self.touch(path, FileActionMask::Create | directory_mask, FileDescriptor::Invalid);
+            return;
+        }
+
+        auto ec = std::error_code{};
+        auto write_time = entry.last_write_time(ec).time_since_epoch().count();
+        if (!is_directory && scanned_it->second.write_time != write_time) {
+            self.touch(path, FileActionMask::Modify, FileDescriptor::Invalid);
+        }
+    });
+
+    for (const auto &[path, scanned_entry] : self.scanned_entries) {
+        if (!seen_paths.contains(path)) {
+            auto directory_mask = scanned_entry.is_directory ? FileActionMask::Directory : FileActionMask::None;
+            self.touch(path, FileActionMask::Delete | directory_mask, FileDescriptor::Invalid);
+        }
+    }
+
+    // Watches of deleted directories are gone with them.
+    auto removed_watches = std::vector<FileDescriptor>();
+    for (const auto &[watch_descriptor, dir_path] : self.watched_dirs) {
+        if (dir_path != self.root_path && !seen_paths.contains(dir_path)) {
+            removed_watches.push_back(watch_descriptor);
+        }
+    }
+
+    for (auto watch_descriptor : removed_watches) {
+        self.watched_dirs.erase(watch_descriptor);
+    }
+}
+} // namespace lr
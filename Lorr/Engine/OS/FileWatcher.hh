@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Engine/OS/OS.hh"
+
+#include <chrono>
+
+namespace lr {
+// Recursive directory watcher. Raw OS events are coalesced per path and
+// only reported once the path stayed quiet for `SETTLE_DURATION`, so a
+// single save (truncate, write, close, rename...) turns into one event.
+//
+// Reported events have absolute paths in `file_name`. Dot-directories
+// like `.cache` hold engine data, they aren't watched.
+//
+// When OS event queue overflows, lost events are recovered by rescanning
+// the tree against last seen write times of every entry.
+struct FileWatcher {
+    constexpr static auto SETTLE_DURATION = std::chrono::milliseconds(150);
+
+    struct PendingEvent {
+        FileActionMask action_mask = FileActionMask::None;
+        FileDescriptor watch_descriptor = FileDescriptor::Invalid;
+        std::chrono::steady_clock::time_point last_event_ts = {};
+    };
+
+    struct ScannedEntry {
+        i64 write_time = 0;
+        bool is_directory = false;
+    };
+
+    FileWatcherDescriptor descriptor = {};
+    fs::path root_path = {};
+
+    ankerl::unordered_dense::map<FileDescriptor, fs::path> watched_dirs = {};
+    ankerl::unordered_dense::map<fs::path, PendingEvent> pending_events = {};
+    // Paths that we write ourselves, their next settled event is dropped.
+    ankerl::unordered_dense::set<fs::path> suppressed_paths = {};
+    std::vector<FileEvent> raw_events = {};
+    // What a rescan compares against, kept up to date as events settle.
+    ankerl::unordered_dense::map<fs::path, ScannedEntry> scanned_entries = {};
+
+    auto init(this FileWatcher &, const fs::path &root_path) -> bool;
+    auto destroy(this FileWatcher &) -> void;
+    auto is_watching(this FileWatcher &) -> bool;
+
+    auto watch_directory(this FileWatcher &, const fs::path &path) -> bool;
+    auto suppress(this FileWatcher &, const fs::path &path) -> void;
+    // Non-blocking, returns events that are settled.
+    auto poll(this FileWatcher &) -> std::vector<FileEvent>;
+
+private:
+    auto add_watch(this FileWatcher &, const fs::path &path) -> bool;
+    auto touch(this FileWatcher &, const fs::path &path, FileActionMask action_mask, FileDescriptor watch_descriptor) -> void;
+    // Turns differences between disk and `scanned_entries` into pending events.
+    auto rescan(this FileWatcher &) -> void;
+};
+} // namespace lr
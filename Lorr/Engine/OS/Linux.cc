@@ -10,6 +10,7 @@
 #include <sys/sysinfo.h>
 #include <unistd.h>
 
+#include <cpuid.h>
 #include <pthread.h>
 
 typedef struct inotify_event inotify_event_t;
@@ -115,6 +116,23 @@ auto os::file_seek(FileDescriptor file, i64 offset) -> void {
     lseek64(static_cast<i32>(file), offset, SEEK_SET);
 }
 
+auto os::file_map(FileDescriptor file, usize size) -> void * {
+    ZoneScoped;
+
+    auto *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, static_cast<i32>(file), 0);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    return data;
+}
+
+auto os::file_unmap(void *data, usize size) -> void {
+    ZoneScoped;
+
+    munmap(data, size);
+}
+
 void os::file_stdout(std::string_view str) {
     ZoneScoped;
 
@@ -127,6 +145,130 @@ void os::file_stderr(std::string_view str) {
     write(STDERR_FILENO, str.data(), str.length());
 }
 
+auto os::file_watcher_init() -> std::expected<FileWatcherDescriptor, FileResult> {
+    ZoneScoped;
+
+    errno = 0;
+
+    i32 instance = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (instance < 0) {
+        switch (errno) {
+            case EMFILE:
+            case ENFILE:
+                return std::unexpected(FileResult::InUse);
+            default:
+                return std::unexpected(FileResult::Unknown);
+        }
+    }
+
+    return FileWatcherDescriptor{ .handle = static_cast<FileDescriptor>(instance), .event = 0 };
+}
+
+auto os::file_watcher_destroy(FileWatcherDescriptor &watcher) -> void {
+    ZoneScoped;
+
+    if (watcher.handle != FileDescriptor::Invalid) {
+        close(static_cast<i32>(watcher.handle));
+    }
+
+    watcher = {};
+}
+
+auto os::file_watcher_add(FileWatcherDescriptor &watcher, const fs::path &path) -> std::expected<FileDescriptor, FileResult> {
+    ZoneScoped;
+
+    errno = 0;
+
+    u32 flags = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    i32 watch = inotify_add_watch(static_cast<i32>(watcher.handle), path.c_str(), flags);
+    if (watch < 0) {
+        switch (errno) {
+            case EACCES:
+                return std::unexpected(FileResult::NoAccess);
+            case EBADF:
+                return std::unexpected(FileResult::BadFileDescriptor);
+            case ENOSPC:
+                return std::unexpected(FileResult::InUse);
+            default:
+                return std::unexpected(FileResult::Unknown);
+        }
+    }
+
+    return static_cast<FileDescriptor>(watch);
+}
+
+auto os::file_watcher_remove(FileWatcherDescriptor &watcher, FileDescriptor watch_descriptor) -> void {
+    ZoneScoped;
+
+    inotify_rm_watch(static_cast<i32>(watcher.handle), static_cast<i32>(watch_descriptor));
+}
+
+auto os::file_watcher_read(FileWatcherDescriptor &watcher, std::vector<FileEvent> &events) -> bool {
+    ZoneScoped;
+
+    alignas(inotify_event_t) c8 buffer[4096] = {};
+    while (true) {
+        errno = 0;
+        iptr read_size = read(static_cast<i32>(watcher.handle), buffer, sizeof(buffer));
+        if (read_size < 0_iptr) {
+            // Nothing left in the queue
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        if (read_size == 0_iptr) {
+            return true;
+        }
+
+        for (iptr offset = 0; offset < read_size;) {
+            auto *event = reinterpret_cast<inotify_event_t *>(buffer + offset);
+            offset += static_cast<iptr>(sizeof(inotify_event_t) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                events.push_back(FileEvent{ .action_mask = FileActionMask::Overflow });
+                continue;
+            }
+
+            auto action_mask = FileActionMask::None;
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                action_mask |= FileActionMask::Create;
+            }
+
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                action_mask |= FileActionMask::Delete;
+            }
+
+            if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+                action_mask |= FileActionMask::Modify;
+            }
+
+            if (action_mask == FileActionMask::None) {
+                // IN_IGNORED, IN_UNMOUNT etc.
+                continue;
+            }
+
+            if (event->mask & IN_ISDIR) {
+                action_mask |= FileActionMask::Directory;
+            }
+
+            events.push_back(
+                FileEvent{
+                    .file_name = event->len > 0 ? fs::path(event->name) : fs::path{},
+                    .action_mask = action_mask,
+                    .watch_descriptor = static_cast<FileDescriptor>(event->wd),
+                }
+            );
+        }
+    }
+}
+
 auto os::mem_page_size() -> u64 {
     return sysconf(_SC_PAGESIZE);
 }
@@ -177,8 +319,7 @@ auto os::set_thread_name(std::thread::native_handle_type thread, std::string_vie
 }
 
 auto os::tsc() -> u64 {
-    ZoneScoped;
-
+    // No zone here, this is used to measure zones.
 #if defined(LS_COMPILER_CLANG) || defined(LS_COMPILER_GCC)
     return __builtin_ia32_rdtsc();
 #else
@@ -186,6 +327,19 @@ auto os::tsc() -> u64 {
 #endif
 }
 
+auto os::tsc_invariant() -> bool {
+    ZoneScoped;
+
+    u32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) {
+        return false;
+    }
+
+    // Advanced Power Management leaf, EDX[8] is invariant TSC
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return edx & (1_u32 << 8);
+}
+
 auto os::unix_timestamp() -> i64 {
     ZoneScoped;
 
@@ -12,6 +12,7 @@ enum class FileResult : i32 {
     InUse,
     Interrupted,
     BadFileDescriptor,
+    Unsupported,
     Unknown,
 };
 constexpr bool operator!(FileResult v) {
@@ -37,6 +38,8 @@ enum class FileActionMask : u32 {
     Delete = 1 << 1,
     Modify = 1 << 2,
     Directory = 1 << 3,
+    // Event queue overflowed and events were lost, `file_name` is empty.
+    Overflow = 1 << 4,
 };
 consteval void enable_bitmask(FileActionMask);
 
@@ -56,6 +59,24 @@ namespace os {
     auto file_seek(FileDescriptor file, i64 offset) -> void;
     auto file_stdout(std::string_view str) -> void;
     auto file_stderr(std::string_view str) -> void;
+    // Read only mapping of the first `size` bytes of the file. Returns
+    // nullptr on failure. Mappings stay valid after the file is closed.
+    auto file_map(FileDescriptor file, usize size) -> void *;
+    auto file_unmap(void *data, usize size) -> void;
+
+    //  ── FILE WATCHER ────────────────────────────────────────────────────
+    // Watches are not recursive, every directory must be added explicitly.
+    // Reads are non-blocking, `file_name` of returned events are relative
+    // to the directory of their `watch_descriptor`.
+    //
+    // Linux only (inotify), elsewhere `file_watcher_init` returns
+    // `FileResult::Unsupported`.
+    //
+    auto file_watcher_init() -> std::expected<FileWatcherDescriptor, FileResult>;
+    auto file_watcher_destroy(FileWatcherDescriptor &watcher) -> void;
+    auto file_watcher_add(FileWatcherDescriptor &watcher, const fs::path &path) -> std::expected<FileDescriptor, FileResult>;
+    auto file_watcher_remove(FileWatcherDescriptor &watcher, FileDescriptor watch_descriptor) -> void;
+    auto file_watcher_read(FileWatcherDescriptor &watcher, std::vector<FileEvent> &events) -> bool;
 
     //  ── MEMORY ──────────────────────────────────────────────────────────
     auto mem_page_size() -> u64;
@@ -70,7 +91,10 @@ namespace os {
     auto set_thread_name(std::thread::native_handle_type thread, std::string_view name) -> void;
 
     //  ── CLOCK ───────────────────────────────────────────────────────────
+    // Raw time stamp counter, only meaningful as time when `tsc_invariant`.
+    // See `TSCClock` for calibrated readings.
     auto tsc() -> u64;
+    auto tsc_invariant() -> bool;
     auto unix_timestamp() -> i64;
 } // namespace os
 } // namespace lr
@@ -14,4 +14,60 @@ auto Timer::elapsed() -> f64 {
     std::chrono::duration<f64> delta = now - last_ts;
     return delta.count();
 }
+
+auto TSCClock::calibrate() -> void {
+    ZoneScoped;
+
+    TSCClock::invariant = os::tsc_invariant();
+    if (!TSCClock::invariant) {
+        TSCClock::frequency = 1'000'000'000_u64;
+        TSCClock::seconds_per_tick = 1.0 / 1'000'000'000.0;
+        LOG_WARN("CPU doesn't have invariant TSC, falling back to steady clock.");
+        return;
+    }
+
+    // Busy wait against steady clock, take the best of few runs
+    // so a preemption in between doesn't skew the result.
+    constexpr auto CALIBRATION_DURATION = std::chrono::milliseconds(5);
+    constexpr auto CALIBRATION_RUNS = 4;
+    auto best_frequency = 0_u64;
+    auto best_error = std::numeric_limits<f64>::max();
+    auto prev_frequency = 0.0;
+    for (auto i = 0; i < CALIBRATION_RUNS; i++) {
+        auto begin_ts = std::chrono::steady_clock::now();
+        auto begin_tsc = os::tsc();
+        auto end_ts = begin_ts;
+        while (end_ts - begin_ts < CALIBRATION_DURATION) {
+            end_ts = std::chrono::steady_clock::now();
+        }
+        auto end_tsc = os::tsc();
+
+        auto elapsed = std::chrono::duration<f64>(end_ts - begin_ts).count();
+        auto cur_frequency = static_cast<f64>(end_tsc - begin_tsc) / elapsed;
+        auto error = glm::abs(cur_frequency - prev_frequency);
+        if (i > 0 && error < best_error) {
+            best_error = error;
+            best_frequency = static_cast<u64>(cur_frequency);
+        }
+
+        prev_frequency = cur_frequency;
+    }
+
+    TSCClock::frequency = best_frequency;
+    TSCClock::seconds_per_tick = 1.0 / static_cast<f64>(best_frequency);
+
+    LOG_INFO("TSC frequency: {:.3f} GHz", static_cast<f64>(best_frequency) / 1'000'000'000.0);
+}
+
+auto StageTimer::to_string() const -> std::string {
+    auto str = std::string{};
+    for (usize i = 0; i < this->stage_count; i++) {
+        const auto &stage = this->stages[i];
+        fmt::format_to(std::back_inserter(str), "{}{} {:.2f}ms", i == 0 ? "" : ", ", stage.n0, TSCClock::to_ms(stage.n1));
+    }
+
+    fmt::format_to(std::back_inserter(str), "{}total {:.2f}ms", this->stage_count == 0 ? "" : ", ", TSCClock::to_ms(this->total_ticks));
+
+    return str;
+}
 } // namespace lr
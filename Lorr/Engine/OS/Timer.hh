@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/OS/OS.hh"
+
 #include <chrono>
 
 namespace lr {
@@ -10,4 +12,72 @@ struct Timer {
     auto reset() -> void;
     auto elapsed() -> f64;
 };
+
+//  ── TSC CLOCK ───────────────────────────────────────────────────────
+// Cheap clock for hot path instrumentation, reading it is a single
+// `rdtsc` instead of a vDSO call. Ticks are only comparable to each
+// other, use conversion helpers to get real time.
+//
+// If CPU doesn't have invariant TSC, it falls back to steady clock
+// with nanosecond ticks, so conversions stay correct either way.
+//
+struct TSCClock {
+    inline static bool invariant = false;
+    inline static u64 frequency = 1'000'000'000_u64;
+    inline static f64 seconds_per_tick = 1.0 / 1'000'000'000.0;
+
+    // Must be called once before any reading, takes ~20ms.
+    static auto calibrate() -> void;
+
+    static auto now() -> u64 {
+        if (invariant) {
+            return os::tsc();
+        }
+
+        auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count());
+    }
+
+    static auto to_seconds(u64 ticks) -> f64 {
+        return static_cast<f64>(ticks) * seconds_per_tick;
+    }
+
+    static auto to_ms(u64 ticks) -> f64 {
+        return static_cast<f64>(ticks) * seconds_per_tick * 1'000.0;
+    }
+
+    static auto to_us(u64 ticks) -> f64 {
+        return static_cast<f64>(ticks) * seconds_per_tick * 1'000'000.0;
+    }
+
+    static auto to_ns(u64 ticks) -> u64 {
+        return static_cast<u64>(static_cast<f64>(ticks) * seconds_per_tick * 1'000'000'000.0);
+    }
+};
+
+// Accumulates ticks of named stages, used for per stage timings of
+// long running tasks (asset loading etc.).
+struct StageTimer {
+    constexpr static usize MAX_STAGES = 8;
+
+    u64 last_ts = TSCClock::now();
+    // Includes stages past `MAX_STAGES` that aren't recorded.
+    u64 total_ticks = 0;
+    ls::pair<std::string_view, u64> stages[MAX_STAGES] = {};
+    usize stage_count = 0;
+
+    // Ends current stage and starts next one.
+    auto lap(std::string_view name) -> void {
+        auto now = TSCClock::now();
+        auto delta = now - last_ts;
+        last_ts = now;
+        total_ticks += delta;
+        if (stage_count < MAX_STAGES) {
+            stages[stage_count++] = { name, delta };
+        }
+    }
+
+    // `read 1.20ms, parse 3.40ms, upload 0.50ms, total 5.10ms`
+    auto to_string() const -> std::string;
+};
 } // namespace lr
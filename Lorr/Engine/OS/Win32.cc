@@ -4,6 +4,7 @@
     #define WIN32_LEAN_AND_MEAN
 #endif
 #include <Windows.h>
+#include <intrin.h>
 
 namespace lr {
 /// FILE SYSTEM ///
@@ -109,6 +110,27 @@ auto os::file_seek(FileDescriptor file, i64 offset) -> void {
     SetFilePointerEx(reinterpret_cast<HANDLE>(file), li, nullptr, FILE_BEGIN);
 }
 
+auto os::file_map(FileDescriptor file, usize size) -> void * {
+    ZoneScoped;
+
+    HANDLE mapping = CreateFileMappingW(reinterpret_cast<HANDLE>(file), nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+
+    // View keeps the mapping object alive.
+    auto *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping);
+
+    return data;
+}
+
+auto os::file_unmap(void *data, [[maybe_unused]] usize size) -> void {
+    ZoneScoped;
+
+    UnmapViewOfFile(data);
+}
+
 auto os::file_stdout(std::string_view str) -> void {
     ZoneScoped;
 
@@ -127,6 +149,35 @@ auto os::file_stderr(std::string_view str) -> void {
     WriteFile(stdout_hnd, str.data(), str.length(), &written, nullptr);
 }
 
+// File watching is Linux only, see `OS.hh`.
+auto os::file_watcher_init() -> std::expected<FileWatcherDescriptor, FileResult> {
+    ZoneScoped;
+
+    return std::unexpected(FileResult::Unsupported);
+}
+
+auto os::file_watcher_destroy(FileWatcherDescriptor &watcher) -> void {
+    ZoneScoped;
+
+    watcher = {};
+}
+
+auto os::file_watcher_add(FileWatcherDescriptor &, const fs::path &) -> std::expected<FileDescriptor, FileResult> {
+    ZoneScoped;
+
+    return std::unexpected(FileResult::Unsupported);
+}
+
+auto os::file_watcher_remove(FileWatcherDescriptor &, FileDescriptor) -> void {
+    ZoneScoped;
+}
+
+auto os::file_watcher_read(FileWatcherDescriptor &, std::vector<FileEvent> &) -> bool {
+    ZoneScoped;
+
+    return false;
+}
+
 auto os::mem_page_size() -> u64 {
     ZoneScoped;
 
@@ -180,8 +231,7 @@ auto os::set_thread_name(std::thread::native_handle_type thread, std::string_vie
 }
 
 auto os::tsc() -> u64 {
-    ZoneScoped;
-
+    // No zone here, this is used to measure zones.
 #if defined(LS_COMPILER_CLANG)
     return __builtin_ia32_rdtsc();
 #else
@@ -189,6 +239,20 @@ auto os::tsc() -> u64 {
 #endif
 }
 
+auto os::tsc_invariant() -> bool {
+    ZoneScoped;
+
+    i32 regs[4] = {};
+    __cpuid(regs, 0x80000000);
+    if (static_cast<u32>(regs[0]) < 0x80000007) {
+        return false;
+    }
+
+    // Advanced Power Management leaf, EDX[8] is invariant TSC
+    __cpuid(regs, 0x80000007);
+    return regs[3] & (1 << 8);
+}
+
 auto os::unix_timestamp() -> i64 {
     ZoneScoped;
 
@@ -207,6 +207,8 @@ struct Bounds {
 struct MeshletInstance {
     alignas(4) u32 mesh_instance_index = 0;
     alignas(4) u32 meshlet_index = 0;
+    // Level of cluster DAG `meshlet_index` belongs to.
+    alignas(4) u32 lod_index = 0;
 };
 
 struct MeshInstance {
@@ -224,10 +226,26 @@ struct Meshlet {
     alignas(4) u32 triangle_count = 0;
 };
 
+// Simplification error of a meshlet and of the group it's merged into on
+// next level, both in mesh space. Parent sphere contains spheres of its
+// children and parent error is never smaller, so projected error only grows
+// going up the DAG. Coarsest level has infinite parent error.
+struct MeshletError {
+    alignas(4) glm::vec3 center = {};
+    alignas(4) f32 radius = 0.0f;
+    alignas(4) f32 error = 0.0f;
+    alignas(4) glm::vec3 parent_center = {};
+    alignas(4) f32 parent_radius = 0.0f;
+    alignas(4) f32 parent_error = 0.0f;
+};
+
+// A level of cluster DAG. Every level covers the whole mesh on its own, so
+// it's also usable as a plain LOD.
 struct MeshLOD {
     alignas(8) u64 indices = 0;
     alignas(8) u64 meshlets = 0;
     alignas(8) u64 meshlet_bounds = 0;
+    alignas(8) u64 meshlet_errors = 0;
     alignas(8) u64 local_triangle_indices = 0;
     alignas(8) u64 indirect_vertex_indices = 0;
 
@@ -240,6 +258,17 @@ struct MeshLOD {
     alignas(4) f32 error = 0.0f;
 };
 
+enum class MeshFlag : u32 {
+    None = 0,
+    // u16x4 per vertex, unorm inside `vertex_position_offset/scale`.
+    QuantizedPositions = 1 << 0,
+    // u16x2 per vertex, unorm octahedral.
+    QuantizedNormals = 1 << 1,
+    // f16x2 per vertex.
+    QuantizedTexCoords = 1 << 2,
+};
+consteval void enable_bitmask(MeshFlag);
+
 struct Mesh {
     constexpr static auto MAX_LODS = 8_sz;
 
@@ -248,6 +277,12 @@ struct Mesh {
     alignas(8) u64 texture_coords = 0;
     alignas(4) u32 vertex_count = 0;
     alignas(4) u32 lod_count = 0;
+    // LODs finer than this aren't uploaded yet, see `MeshStreamer`.
+    alignas(4) u32 finest_resident_lod = 0;
+    alignas(4) MeshFlag flags = MeshFlag::None;
+    // position = offset + quantized * scale
+    alignas(4) glm::vec3 vertex_position_offset = {};
+    alignas(4) glm::vec3 vertex_position_scale = {};
     alignas(8) MeshLOD lods[MAX_LODS] = {};
     alignas(4) Bounds bounds = {};
 };
@@ -224,6 +224,7 @@ auto Scene::destroy(this Scene &self) -> void {
 
     self.mesh_instance_count = 0;
     self.max_meshlet_instance_count = 0;
+    self.gpu_mesh_primitives.clear();
     self.root.destruct();
     self.name.clear();
     self.root.clear();
@@ -337,17 +338,22 @@ auto Scene::is_component_known(this Scene &self, flecs::id component_id) -> bool
 
 auto Scene::import_from_file(this Scene &self, const fs::path &path) -> bool {
     ZoneScoped;
-    memory::ScopedStack stack;
-    namespace sj = simdjson;
 
-    File file(path, FileAccess::Read);
-    if (!file) {
+    auto json_str = File::to_string(path);
+    if (json_str.empty()) {
         LOG_ERROR("Failed to open file {}!", path);
         return false;
     }
 
-    auto json = sj::padded_string(file.size);
-    file.read(json.data(), file.size);
+    return self.import_from_data(json_str);
+}
+
+auto Scene::import_from_data(this Scene &self, std::string_view json_str) -> bool {
+    ZoneScoped;
+    memory::ScopedStack stack;
+    namespace sj = simdjson;
+
+    auto json = sj::padded_string(json_str);
 
     sj::ondemand::parser parser;
     auto doc = parser.iterate(json);
@@ -376,11 +382,12 @@ auto Scene::import_from_file(this Scene &self, const fs::path &path) -> bool {
         }
     }
 
+    // Entities are ready, their assets show up as they become resident.
     LOG_TRACE("Loading scene {} with {} assets...", self.name, requested_assets.size());
     for (const auto &uuid : requested_assets) {
         auto &asset_man = App::mod<AssetManager>();
         if (uuid && asset_man.get_asset(uuid)) {
-            asset_man.load_asset(uuid);
+            asset_man.load_asset_async(uuid);
         }
     }
 
@@ -834,8 +841,24 @@ auto Scene::prepare_frame(this Scene &self, SceneRenderer &renderer, u32 image_c
     auto gpu_meshes = std::vector<GPU::Mesh>();
     auto gpu_mesh_instances = std::vector<GPU::MeshInstance>();
 
+    auto resident_generation = asset_man.resident_generation.load();
+    if (self.has_pending_models && self.seen_resident_generation != resident_generation) {
+        self.models_dirty = true;
+    }
+
     if (self.models_dirty) {
+        self.has_pending_models = false;
+        self.seen_resident_generation = resident_generation;
+        self.gpu_mesh_primitives.clear();
+        self.meshes_generation++;
         for (const auto &[rendering_mesh, transform_ids] : self.rendering_meshes_map) {
+            // Still loading, don't stall the frame for it
+            auto *model_asset = asset_man.get_asset(rendering_mesh.n0);
+            if (!model_asset || !model_asset->is_resident()) {
+                self.has_pending_models = true;
+                continue;
+            }
+
             auto *model = asset_man.get_model(rendering_mesh.n0);
             const auto &mesh = model->meshes[rendering_mesh.n1];
 
@@ -844,21 +867,26 @@ auto Scene::prepare_frame(this Scene &self, SceneRenderer &renderer, u32 image_c
                 const auto &gpu_mesh = model->gpu_meshes[primitive_index];
                 auto mesh_index = static_cast<u32>(gpu_meshes.size());
                 gpu_meshes.emplace_back(gpu_mesh);
+                self.gpu_mesh_primitives.emplace_back(rendering_mesh.n0, primitive_index);
 
                 //  ── INSTANCING ──────────────────────────────────────────────────
-                for (const auto transform_id : transform_ids) {
-                    auto lod0_index = 0;
-                    const auto &lod0 = gpu_mesh.lods[lod0_index];
+                // Culling emits meshlets of every level coarser than selected one,
+                // see `cull_meshlets`.
+                auto dag_meshlet_count = 0_u32;
+                for (u32 lod_index = 0; lod_index < gpu_mesh.lod_count; lod_index++) {
+                    dag_meshlet_count += gpu_mesh.lods[lod_index].meshlet_count;
+                }
 
+                for (const auto transform_id : transform_ids) {
                     auto &mesh_instance = gpu_mesh_instances.emplace_back();
                     mesh_instance.mesh_index = mesh_index;
-                    mesh_instance.lod_index = lod0_index;
+                    mesh_instance.lod_index = 0;
                     mesh_instance.material_index = SlotMap_decode_id(primitive.material_id).index;
                     mesh_instance.transform_index = SlotMap_decode_id(transform_id).index;
                     mesh_instance.meshlet_instance_visibility_offset = meshlet_instance_visibility_offset;
 
-                    meshlet_instance_visibility_offset += lod0.meshlet_count;
-                    max_meshlet_instance_count += lod0.meshlet_count;
+                    meshlet_instance_visibility_offset += dag_meshlet_count;
+                    max_meshlet_instance_count += dag_meshlet_count;
                 }
             }
         }
@@ -867,8 +895,60 @@ auto Scene::prepare_frame(this Scene &self, SceneRenderer &renderer, u32 image_c
         self.max_meshlet_instance_count = max_meshlet_instance_count;
     }
 
+    //  ── TEXTURE STREAMING ───────────────────────────────────────────────
+    // Bounding sphere of every instance projected to screen, textures of
+    // its material are wanted at roughly one texel per covered pixel.
+    if (active_camera_data.has_value()) {
+        ZoneScopedN("Texture Demand");
+        const auto &camera = active_camera_data.value();
+        auto projection_scale = camera.resolution.y / (2.0f * glm::tan(glm::radians(camera.fov_deg) * 0.5f));
+        auto material_screen_sizes = ankerl::unordered_dense::map<MaterialID, f32>();
+        for (const auto &[rendering_mesh, transform_ids] : self.rendering_meshes_map) {
+            auto *model_asset = asset_man.get_asset(rendering_mesh.n0);
+            if (!model_asset || !model_asset->is_resident()) {
+                continue;
+            }
+
+            auto *model = asset_man.get_model(rendering_mesh.n0);
+            const auto &mesh = model->meshes[rendering_mesh.n1];
+            for (auto primitive_index : mesh.primitive_indices) {
+                const auto &primitive = model->primitives[primitive_index];
+                const auto &bounds = model->gpu_meshes[primitive_index].bounds;
+                auto &screen_size = material_screen_sizes[primitive.material_id];
+                for (const auto transform_id : transform_ids) {
+                    const auto &world_mat = self.transforms.slot(transform_id)->world;
+                    auto axis_scale = glm::vec3(glm::length(world_mat[0]), glm::length(world_mat[1]), glm::length(world_mat[2]));
+                    auto scale = glm::max(axis_scale.x, glm::max(axis_scale.y, axis_scale.z));
+                    auto center = glm::vec3(world_mat * glm::vec4(bounds.sphere_center, 1.0f));
+                    auto radius = bounds.sphere_radius * scale;
+                    auto distance = ls::max(glm::distance(center, camera.position), camera.near_clip);
+                    screen_size = ls::max(screen_size, 2.0f * radius * projection_scale / distance);
+                }
+            }
+        }
+
+        for (const auto &[material_id, screen_size] : material_screen_sizes) {
+            const auto *material = asset_man.get_material(material_id);
+            if (!material) {
+                continue;
+            }
+
+            for (const auto &texture_uuid : { material->albedo_texture,
+                                              material->normal_texture,
+                                              material->emissive_texture,
+                                              material->metallic_roughness_texture,
+                                              material->occlusion_texture })
+            {
+                if (texture_uuid) {
+                    asset_man.texture_streamer.request(asset_man.get_texture_stream_uuid(texture_uuid), screen_size);
+                }
+            }
+        }
+    }
+
     auto uuid_to_image_index = [&](const UUID &uuid) -> ls::option<u32> {
-        if (!asset_man.is_texture_loaded(uuid)) {
+        // Uploads might still be in flight, material is dirtied again once they land.
+        if (!asset_man.is_texture_loaded(uuid) || asset_man.get_load_state(uuid) != AssetLoadState::Resident) {
             return ls::nullopt;
         }
 
@@ -905,6 +985,13 @@ auto Scene::prepare_frame(this Scene &self, SceneRenderer &renderer, u32 image_c
         }
 
         flags |= normal_image_index.has_value() ? GPU::MaterialFlag::HasNormalImage : GPU::MaterialFlag::None;
+        if (normal_image_index.has_value()) {
+            // Z of BC5 and EAC RG11 normals is reconstructed.
+            auto normal_format = asset_man.get_texture(material->normal_texture)->image.format();
+            if (normal_format == vuk::Format::eBc5UnormBlock || normal_format == vuk::Format::eEacR11G11UnormBlock) {
+                flags |= GPU::MaterialFlag::NormalTwoComponent;
+            }
+        }
         flags |= emissive_image_index.has_value() ? GPU::MaterialFlag::HasEmissiveImage : GPU::MaterialFlag::None;
         flags |= metallic_roughness_image_index.has_value() ? GPU::MaterialFlag::HasMetallicRoughnessImage : GPU::MaterialFlag::None;
         flags |= occlusion_image_index.has_value() ? GPU::MaterialFlag::HasOcclusionImage : GPU::MaterialFlag::None;
@@ -931,6 +1018,8 @@ auto Scene::prepare_frame(this Scene &self, SceneRenderer &renderer, u32 image_c
         .image_count = image_count,
         .mesh_instance_count = self.mesh_instance_count,
         .max_meshlet_instance_count = self.max_meshlet_instance_count,
+        .mesh_count = static_cast<u32>(self.gpu_mesh_primitives.size()),
+        .meshes_generation = self.meshes_generation,
         .regenerate_sky = regenerate_sky,
         .dirty_transform_ids = self.dirty_transforms,
         .gpu_transforms = self.transforms.slots_unsafe(),
@@ -947,6 +1036,17 @@ auto Scene::prepare_frame(this Scene &self, SceneRenderer &renderer, u32 image_c
     };
     auto prepared_frame = renderer.prepare_frame(prepare_info);
 
+    // LODs `cull_meshes` selected a few frames ago, finer ones get streamed in.
+    for (u32 mesh_index = 0; mesh_index < prepare_info.mesh_lod_feedback.size(); mesh_index++) {
+        auto feedback = prepare_info.mesh_lod_feedback[mesh_index];
+        if (feedback == 0 || feedback > GPU::Mesh::MAX_LODS) {
+            continue;
+        }
+
+        const auto &[model_uuid, primitive_index] = self.gpu_mesh_primitives[mesh_index];
+        asset_man.mesh_streamer.request(model_uuid, primitive_index, static_cast<u32>(GPU::Mesh::MAX_LODS - feedback));
+    }
+
     self.models_dirty = false;
     self.dirty_transforms.clear();
 
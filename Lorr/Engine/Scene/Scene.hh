@@ -42,8 +42,15 @@ private:
     std::vector<GPU::Material> gpu_materials = {};
 
     bool models_dirty = false;
+    // Some meshes were skipped because their models aren't resident yet,
+    // rebuilt when `AssetManager::resident_generation` moves.
+    bool has_pending_models = false;
+    u64 seen_resident_generation = 0;
     u32 mesh_instance_count = 0;
     u32 max_meshlet_instance_count = 0;
+    // Model and primitive of every GPU mesh, LOD feedback is indexed by them.
+    std::vector<ls::pair<UUID, u32>> gpu_mesh_primitives = {};
+    u64 meshes_generation = 0;
 
     GPU::CullFlags cull_flags = GPU::CullFlags::All;
 
@@ -63,6 +70,8 @@ public:
     auto is_component_known(this Scene &, flecs::id component_id) -> bool;
 
     auto import_from_file(this Scene &, const fs::path &path) -> bool;
+    // Same as `import_from_file` with contents already in memory, ie. packed scenes.
+    auto import_from_data(this Scene &, std::string_view json_str) -> bool;
     auto export_to_file(this Scene &, const fs::path &path) -> bool;
 
     auto create_entity(this Scene &, const std::string &name = {}) -> flecs::entity;
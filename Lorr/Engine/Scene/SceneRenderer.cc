@@ -64,7 +64,8 @@ static auto cull_meshes(
     vuk::Value<vuk::Buffer> &meshlet_instances_buffer,
     vuk::Value<vuk::Buffer> &visible_meshlet_instances_count_buffer,
     vuk::Value<vuk::Buffer> &transforms_buffer,
-    vuk::Value<vuk::Buffer> &debug_drawer_buffer
+    vuk::Value<vuk::Buffer> &debug_drawer_buffer,
+    vuk::Value<vuk::Buffer> &mesh_lod_feedback_buffer
 ) -> vuk::Value<vuk::Buffer> {
     ZoneScoped;
 
@@ -77,7 +78,8 @@ static auto cull_meshes(
             VUK_BA(vuk::eComputeRW) mesh_instances,
             VUK_BA(vuk::eComputeRW) meshlet_instances,
             VUK_BA(vuk::eComputeRW) visible_meshlet_instances_count,
-            VUK_BA(vuk::eComputeRW) debug_drawer
+            VUK_BA(vuk::eComputeRW) debug_drawer,
+            VUK_BA(vuk::eComputeRW) mesh_lod_feedback
         ) {
             cmd_list //
                 .bind_compute_pipeline("passes.cull_meshes")
@@ -87,6 +89,7 @@ static auto cull_meshes(
                 .bind_buffer(0, 3, meshlet_instances)
                 .bind_buffer(0, 4, visible_meshlet_instances_count)
                 .bind_buffer(0, 5, debug_drawer)
+                .bind_buffer(0, 6, mesh_lod_feedback)
                 .push_constants(
                     vuk::ShaderStageFlagBits::eCompute,
                     0,
@@ -101,7 +104,15 @@ static auto cull_meshes(
                 )
                 .dispatch_invocations(mesh_instance_count);
 
-            return std::make_tuple(meshes, transforms, mesh_instances, meshlet_instances, visible_meshlet_instances_count, debug_drawer);
+            return std::make_tuple(
+                meshes,
+                transforms,
+                mesh_instances,
+                meshlet_instances,
+                visible_meshlet_instances_count,
+                debug_drawer,
+                mesh_lod_feedback
+            );
         }
     );
 
@@ -111,7 +122,8 @@ static auto cull_meshes(
         mesh_instances_buffer,
         meshlet_instances_buffer,
         visible_meshlet_instances_count_buffer,
-        debug_drawer_buffer
+        debug_drawer_buffer,
+        mesh_lod_feedback_buffer
     ) =
         vis_cull_meshes_pass(
             std::move(meshes_buffer),
@@ -119,7 +131,8 @@ static auto cull_meshes(
             std::move(mesh_instances_buffer),
             std::move(meshlet_instances_buffer),
             std::move(visible_meshlet_instances_count_buffer),
-            std::move(debug_drawer_buffer)
+            std::move(debug_drawer_buffer),
+            std::move(mesh_lod_feedback_buffer)
         );
 
     auto generate_cull_commands_pass = vuk::make_pass(
@@ -151,6 +164,8 @@ static auto cull_meshlets(
     f32 near_clip,
     glm::vec2 &resolution,
     glm::mat4 &projection_view,
+    glm::vec3 &observer_position,
+    f32 acceptable_lod_error,
     vuk::Value<vuk::ImageAttachment> &hiz_attachment,
     vuk::Value<vuk::Buffer> &cull_meshlets_cmd_buffer,
     vuk::Value<vuk::Buffer> &visible_meshlet_instances_count_buffer,
@@ -170,7 +185,7 @@ static auto cull_meshlets(
     //  ── CULL MESHLETS ───────────────────────────────────────────────────
     auto vis_cull_meshlets_pass = vuk::make_pass(
         stack.format("vis cull meshlets {}", late ? "late" : "early"),
-        [late, cull_flags, near_clip, projection_view](
+        [late, cull_flags, near_clip, resolution, projection_view, observer_position, acceptable_lod_error](
             vuk::CommandBuffer &cmd_list,
             VUK_BA(vuk::eIndirectRead) dispatch_cmd,
             VUK_BA(vuk::eComputeRead) meshlet_instances,
@@ -199,7 +214,18 @@ static auto cull_meshlets(
                 .bind_buffer(0, 9, visible_meshlet_instances_indices)
                 .bind_buffer(0, 10, meshlet_instance_visibility_mask)
                 .bind_buffer(0, 11, cull_triangles_cmd)
-                .push_constants(vuk::ShaderStageFlagBits::eCompute, 0, PushConstants(cull_flags, near_clip, projection_view))
+                .push_constants(
+                    vuk::ShaderStageFlagBits::eCompute,
+                    0,
+                    PushConstants(
+                        cull_flags,
+                        near_clip,
+                        projection_view,
+                        observer_position,
+                        glm::max(resolution.x, resolution.y),
+                        acceptable_lod_error
+                    )
+                )
                 .specialize_constants(0, late)
                 .dispatch_indirect(dispatch_cmd);
 
@@ -1356,6 +1382,25 @@ auto SceneRenderer::prepare_frame(this SceneRenderer &self, FramePrepareInfo &in
             self.meshlet_instance_visibility_mask_buffer.acquire(device, "meshlet instances visibility mask", vuk::eMemoryRead);
     }
 
+    if (info.mesh_count != 0 && info.mesh_instance_count != 0) {
+        // One per frame in flight, when it comes around again the frame that
+        // wrote it is done.
+        self.mesh_lod_feedbacks.resize(device.frame_count());
+        auto &feedback = self.mesh_lod_feedbacks[self.frame_counter % self.mesh_lod_feedbacks.size()];
+        if (feedback.pending && feedback.meshes_generation == info.meshes_generation) {
+            const auto *feedback_data = reinterpret_cast<const u32 *>(feedback.buffer.host_ptr());
+            info.mesh_lod_feedback.assign(feedback_data, feedback_data + feedback.mesh_count);
+        }
+
+        auto feedback_size_bytes = info.mesh_count * sizeof(u32);
+        feedback.buffer = feedback.buffer.resize(device, feedback_size_bytes, vuk::MemoryUsage::eGPUtoCPU).value();
+        feedback.meshes_generation = info.meshes_generation;
+        feedback.mesh_count = info.mesh_count;
+        feedback.pending = true;
+        prepared_frame.mesh_lod_feedback_buffer = feedback.buffer.acquire(device, "mesh lod feedback", vuk::eNone, 0, feedback_size_bytes);
+        prepared_frame.mesh_lod_feedback_buffer = zero_fill_pass(std::move(prepared_frame.mesh_lod_feedback_buffer));
+    }
+
     prepared_frame.camera_buffer = transfer_man.scratch_buffer(info.camera);
 
     auto directional_light_cascade_count = 1_u32;
@@ -1589,6 +1634,7 @@ auto SceneRenderer::render(this SceneRenderer &self, vuk::Value<vuk::ImageAttach
         auto mesh_instances_buffer = std::move(frame.mesh_instances_buffer);
         auto materials_buffer = std::move(frame.materials_buffer);
         auto meshlet_instance_visibility_mask_buffer = std::move(frame.meshlet_instance_visibility_mask_buffer);
+        auto mesh_lod_feedback_buffer = std::move(frame.mesh_lod_feedback_buffer);
         auto meshlet_instances_buffer =
             transfer_man.alloc_transient_buffer(vuk::MemoryUsage::eGPUonly, frame.max_meshlet_instance_count * sizeof(GPU::MeshletInstance));
         auto visible_meshlet_instances_indices_buffer =
@@ -1723,7 +1769,8 @@ auto SceneRenderer::render(this SceneRenderer &self, vuk::Value<vuk::ImageAttach
             meshlet_instances_buffer,
             visible_meshlet_instances_count_buffer,
             transforms_buffer,
-            debug_drawer_buffer
+            debug_drawer_buffer,
+            mesh_lod_feedback_buffer
         );
 
         auto early_draw_visbuffer_cmd_buffer = cull_meshlets(
@@ -1733,6 +1780,8 @@ auto SceneRenderer::render(this SceneRenderer &self, vuk::Value<vuk::ImageAttach
             frame.camera.near_clip,
             frame.camera.resolution,
             frame.camera.projection_view_mat,
+            frame.camera.position,
+            frame.camera.acceptable_lod_error,
             hiz_attachment,
             cull_meshlets_cmd_buffer,
             visible_meshlet_instances_count_buffer,
@@ -1772,6 +1821,8 @@ auto SceneRenderer::render(this SceneRenderer &self, vuk::Value<vuk::ImageAttach
             frame.camera.near_clip,
             frame.camera.resolution,
             frame.camera.projection_view_mat,
+            frame.camera.position,
+            frame.camera.acceptable_lod_error,
             hiz_attachment,
             cull_meshlets_cmd_buffer,
             visible_meshlet_instances_count_buffer,
@@ -2370,6 +2421,13 @@ auto SceneRenderer::cleanup(this SceneRenderer &self) -> void {
         self.meshlet_instance_visibility_mask_buffer = {};
     }
 
+    for (auto &feedback : self.mesh_lod_feedbacks) {
+        if (feedback.buffer) {
+            device.destroy(feedback.buffer.id());
+        }
+    }
+    self.mesh_lod_feedbacks.clear();
+
     if (self.materials_buffer) {
         device.destroy(self.materials_buffer.id());
         self.materials_buffer = {};
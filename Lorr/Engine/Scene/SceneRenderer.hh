@@ -9,6 +9,9 @@ struct FramePrepareInfo {
     u32 image_count = 0;
     u32 mesh_instance_count = 0;
     u32 max_meshlet_instance_count = 0;
+    u32 mesh_count = 0;
+    // Bumped when meshes are rebuilt, older feedback doesn't match them.
+    u64 meshes_generation = 0;
     bool regenerate_sky = false;
 
     ls::span<GPU::TransformID> dirty_transform_ids = {};
@@ -26,6 +29,10 @@ struct FramePrepareInfo {
     ls::option<GPU::Atmosphere> atmosphere = ls::nullopt;
     ls::option<GPU::EyeAdaptation> eye_adaptation = ls::nullopt;
     ls::option<GPU::VBGTAO> vbgtao = ls::nullopt;
+
+    // Out. `MAX_LODS - lod_index` of finest LOD selected for every mesh,
+    // 0 for meshes that weren't visible. Frames in flight behind.
+    std::vector<u32> mesh_lod_feedback = {};
 };
 
 struct PreparedFrame {
@@ -35,6 +42,7 @@ struct PreparedFrame {
     vuk::Value<vuk::Buffer> meshes_buffer = {};
     vuk::Value<vuk::Buffer> mesh_instances_buffer = {};
     vuk::Value<vuk::Buffer> meshlet_instance_visibility_mask_buffer = {};
+    vuk::Value<vuk::Buffer> mesh_lod_feedback_buffer = {};
     vuk::Value<vuk::Buffer> materials_buffer = {};
     vuk::Value<vuk::Buffer> camera_buffer = {};
     vuk::Value<vuk::Buffer> directional_light_buffer = {};
@@ -75,6 +83,15 @@ struct SceneRenderer {
 
     Buffer materials_buffer = {};
 
+    // Read back on CPU once GPU is done with the frame that wrote it.
+    struct MeshLODFeedback {
+        Buffer buffer = {};
+        u64 meshes_generation = 0;
+        u32 mesh_count = 0;
+        bool pending = false;
+    };
+    std::vector<MeshLODFeedback> mesh_lod_feedbacks = {};
+
     Image sky_transmittance_lut = {};
     ImageView sky_transmittance_lut_view = {};
     Image sky_multiscatter_lut = {};
@@ -67,7 +67,13 @@ auto RuntimeModule::init(this RuntimeModule &self) -> bool {
     LOG_TRACE("Actvie world: {}", self.world_path);
 
     auto &asset_man = lr::App::mod<lr::AssetManager>();
+    asset_man.open_project_cache(self.world_path);
     asset_man.import_project(self.world_path);
+    // Mounted over loose files, whatever the pack has is loaded from it.
+    auto pack_path = self.world_path / lr::AssetPack::DEFAULT_FILE_NAME;
+    if (fs::exists(pack_path) && !asset_man.mount_pack(self.world_path, pack_path)) {
+        LOG_WARN("Asset pack '{}' can't be mounted, loading loose files.", pack_path);
+    }
 
     return true;
 }
@@ -82,6 +88,9 @@ auto RuntimeModule::update(this RuntimeModule &self, f64 delta_time) -> void {
     auto swapchain_attachment = device.new_frame(window.swap_chain.value());
     swapchain_attachment = vuk::clear_image(std::move(swapchain_attachment), vuk::Black<f32>);
     imgui_renderer.begin_frame(delta_time, swapchain_attachment->extent);
+    asset_man.poll_loads();
+    asset_man.texture_streamer.update(asset_man);
+    asset_man.mesh_streamer.update(asset_man);
 
     if (self.active_scene_uuid) {
         auto *active_scene = asset_man.get_scene(self.active_scene_uuid);
@@ -0,0 +1,87 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Asset/AssetCache.hh"
+
+namespace lr {
+LR_TEST(asset_cache_evicts_oldest_release_first) {
+    auto cache = AssetCache{};
+    LR_CHECK(cache.set_budgets(100, 1000).empty());
+
+    auto first = UUID::generate_random();
+    auto second = UUID::generate_random();
+    auto third = UUID::generate_random();
+    auto fourth = UUID::generate_random();
+    LR_CHECK(cache.insert(first, 40, 10).empty());
+    LR_CHECK(cache.insert(second, 40, 10).empty());
+
+    auto evicted = cache.insert(third, 40, 10);
+    LR_REQUIRE(evicted.size() == 1);
+    LR_CHECK(evicted[0] == first);
+
+    // Released again, now the newest one.
+    LR_CHECK(cache.take(second));
+    LR_CHECK(cache.insert(second, 40, 10).empty());
+    evicted = cache.insert(fourth, 40, 10);
+    LR_REQUIRE(evicted.size() == 1);
+    LR_CHECK(evicted[0] == third);
+
+    auto stats = cache.stats();
+    LR_CHECK(stats.cpu_size == 80 && stats.gpu_size == 20);
+    LR_CHECK(stats.cached_count == 2);
+    LR_CHECK(stats.hit_count == 1);
+    LR_CHECK(stats.eviction_count == 2);
+}
+
+LR_TEST(asset_cache_respects_gpu_budget) {
+    auto cache = AssetCache{};
+    LR_CHECK(cache.set_budgets(1000, 100).empty());
+
+    auto first = UUID::generate_random();
+    auto second = UUID::generate_random();
+    LR_CHECK(cache.insert(first, 1, 60).empty());
+    auto evicted = cache.insert(second, 1, 60);
+    LR_REQUIRE(evicted.size() == 1);
+    LR_CHECK(evicted[0] == first);
+
+    // Doesn't fit at all, evicts everything including itself.
+    auto huge = UUID::generate_random();
+    evicted = cache.insert(huge, 1, 200);
+    LR_CHECK(evicted.size() == 2);
+    LR_CHECK(std::ranges::contains(evicted, huge));
+    LR_CHECK(cache.stats().cached_count == 0);
+    LR_CHECK(cache.stats().gpu_size == 0);
+}
+
+LR_TEST(asset_cache_shrinking_budgets_evicts) {
+    auto cache = AssetCache{};
+    auto uuids = std::vector<UUID>();
+    for (u32 i = 0; i < 4; i++) {
+        auto &uuid = uuids.emplace_back(UUID::generate_random());
+        LR_CHECK(cache.insert(uuid, 10, 10).empty());
+    }
+
+    auto evicted = cache.set_budgets(20, 1000);
+    LR_REQUIRE(evicted.size() == 2);
+    LR_CHECK(evicted[0] == uuids[0] && evicted[1] == uuids[1]);
+
+    // Zero budgets turn caching off.
+    evicted = cache.set_budgets(0, 0);
+    LR_CHECK(evicted.size() == 2);
+    LR_CHECK(cache.stats().cached_count == 0);
+    LR_CHECK(!cache.take(uuids[3]));
+}
+
+LR_TEST(asset_cache_remove_skips_hit_count) {
+    auto cache = AssetCache{};
+    auto uuid = UUID::generate_random();
+    LR_CHECK(cache.insert(uuid, 10, 10).empty());
+    LR_CHECK(cache.remove(uuid));
+    LR_CHECK(!cache.remove(uuid));
+
+    cache.record_miss();
+    auto stats = cache.stats();
+    LR_CHECK(stats.hit_count == 0);
+    LR_CHECK(stats.miss_count == 1);
+    LR_CHECK(stats.cpu_size == 0 && stats.gpu_size == 0);
+}
+} // namespace lr
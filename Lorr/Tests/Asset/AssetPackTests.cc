@@ -0,0 +1,115 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Asset/AssetPack.hh"
+
+#include <random>
+
+namespace lr {
+static auto random_bytes(usize size, u32 seed) -> std::vector<u8> {
+    auto rng = std::mt19937(seed);
+    auto bytes = std::vector<u8>(size);
+    for (auto &byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+
+    return bytes;
+}
+
+static auto make_source(u32 index) -> AssetPackSource {
+    auto meta_str = fmt::format("{{ \"index\": {} }}", index);
+    auto source = AssetPackSource{
+        .uuid = UUID::generate_random(),
+        .type = index % 2 == 0 ? AssetType::Texture : AssetType::Model,
+        .data_type = index % 2 == 0 ? AssetPackDataType::Cooked : AssetPackDataType::Source,
+        .params_hash = index,
+        .path = fmt::format("assets/asset_{}.png", index),
+        .meta = std::vector<u8>(meta_str.begin(), meta_str.end()),
+    };
+
+    // Every other one compresses well.
+    source.data = index % 2 == 0 ? std::vector<u8>(10000 + index, static_cast<u8>(index)) : random_bytes(10000 + index, index);
+    return source;
+}
+
+LR_TEST(asset_pack_round_trip) {
+    auto pack_dir = test::ScopedTempDir("asset_pack_round_trip");
+    auto pack_path = pack_dir.path / AssetPack::DEFAULT_FILE_NAME;
+    auto sources = std::vector<AssetPackSource>();
+    for (u32 i = 0; i < 37; i++) {
+        sources.push_back(make_source(i));
+    }
+
+    LR_REQUIRE(AssetPack::write(pack_path, sources, TextureCookFormat::UASTC));
+    LR_CHECK(!fs::exists(fs::path(pack_path) += ".tmp"));
+
+    auto pack = AssetPack::open(pack_path);
+    LR_REQUIRE(pack.has_value());
+    LR_CHECK(pack->entry_count == sources.size());
+    LR_CHECK(pack->texture_cook_format == TextureCookFormat::UASTC);
+    LR_CHECK(std::has_single_bit(pack->slots.size()) && pack->slots.size() >= sources.size() * 2);
+
+    for (const auto &source : sources) {
+        const auto *entry = pack->find(source.uuid);
+        LR_REQUIRE(entry != nullptr);
+        LR_CHECK(pack->entry_uuid(*entry) == source.uuid);
+        LR_CHECK(pack->entry_path(*entry) == source.path);
+        LR_CHECK(entry->type == source.type);
+        LR_CHECK(entry->data_type == source.data_type);
+        LR_CHECK(entry->params_hash == source.params_hash);
+        LR_CHECK(entry->data.offset % AssetPack::CHUNK_ALIGNMENT == 0);
+
+        auto meta = pack->read(entry->meta);
+        auto data = pack->read(entry->data);
+        LR_REQUIRE(meta.has_value() && data.has_value());
+        LR_CHECK(std::ranges::equal(meta->data, source.meta));
+        LR_CHECK(std::ranges::equal(data->data, source.data));
+
+        // Random data isn't worth compressing, it's read from the mapping.
+        auto is_compressible = source.type == AssetType::Texture;
+        LR_CHECK((entry->data.compression == AssetPackCompression::LZ4) == is_compressible);
+        LR_CHECK(data->decompressed.empty() == !is_compressible);
+    }
+
+    LR_CHECK(pack->find(UUID::generate_random()) == nullptr);
+}
+
+LR_TEST(asset_pack_skips_duplicates) {
+    auto pack_dir = test::ScopedTempDir("asset_pack_duplicates");
+    auto pack_path = pack_dir.path / AssetPack::DEFAULT_FILE_NAME;
+    auto sources = std::vector<AssetPackSource>{ make_source(0), make_source(1) };
+    auto duplicate = make_source(2);
+    duplicate.uuid = sources[0].uuid;
+    sources.push_back(std::move(duplicate));
+
+    LR_REQUIRE(AssetPack::write(pack_path, sources, TextureCookFormat::BC7));
+    auto pack = AssetPack::open(pack_path);
+    LR_REQUIRE(pack.has_value());
+    LR_CHECK(pack->entry_count == 2);
+
+    // First one wins.
+    const auto *entry = pack->find(sources[0].uuid);
+    LR_REQUIRE(entry != nullptr);
+    LR_CHECK(pack->entry_path(*entry) == sources[0].path);
+}
+
+LR_TEST(asset_pack_rejects_other_files) {
+    auto pack_dir = test::ScopedTempDir("asset_pack_other_files");
+    LR_CHECK(!AssetPack::open(pack_dir.path / "missing.lrpak").has_value());
+
+    auto garbage_path = pack_dir.path / "garbage.lrpak";
+    {
+        auto garbage = random_bytes(1024, 9);
+        File file(garbage_path, FileAccess::Write);
+        LR_REQUIRE(file.write(garbage.data(), garbage.size()) == garbage.size());
+    }
+    LR_CHECK(!AssetPack::open(garbage_path).has_value());
+
+    // Empty packs are still packs.
+    auto empty_path = pack_dir.path / "empty.lrpak";
+    LR_REQUIRE(AssetPack::write(empty_path, {}, TextureCookFormat::BC7));
+    auto empty_pack = AssetPack::open(empty_path);
+    LR_REQUIRE(empty_pack.has_value());
+    LR_CHECK(empty_pack->entry_count == 0);
+    LR_CHECK(empty_pack->find(UUID::generate_random()) == nullptr);
+}
+} // namespace lr
@@ -0,0 +1,101 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Asset/DerivedDataCache.hh"
+
+#include <random>
+
+namespace lr {
+// Random bytes don't compress, entries are stored as is.
+static auto random_bytes(usize size, u32 seed) -> std::vector<u8> {
+    auto rng = std::mt19937(seed);
+    auto bytes = std::vector<u8>(size);
+    for (auto &byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+
+    return bytes;
+}
+
+LR_TEST(derived_data_cache_put_get) {
+    auto cache_dir = test::ScopedTempDir("ddc_put_get");
+    auto cache = DerivedDataCache{};
+    LR_REQUIRE(cache.init(cache_dir.path));
+
+    auto raw_key = cache.make_key(1, 2);
+    auto compressed_key = cache.make_key(1, 3);
+    LR_CHECK(raw_key != compressed_key);
+    LR_CHECK(raw_key == cache.make_key(1, 2));
+
+    auto raw_data = random_bytes(10000, 7);
+    auto compressed_data = std::vector<u8>(10000, 42);
+    LR_REQUIRE(cache.put(raw_key, raw_data));
+    LR_REQUIRE(cache.put(compressed_key, compressed_data));
+    LR_CHECK(cache.stats().compressed_bytes_saved > 0);
+
+    auto raw_entry = cache.get(raw_key);
+    auto compressed_entry = cache.get(compressed_key);
+    LR_REQUIRE(raw_entry.has_value() && compressed_entry.has_value());
+    LR_CHECK(std::ranges::equal(raw_entry->data, raw_data));
+    LR_CHECK(std::ranges::equal(compressed_entry->data, compressed_data));
+
+    LR_CHECK(!cache.get(cache.make_key(2, 2)).has_value());
+    auto stats = cache.stats();
+    LR_CHECK(stats.hit_count == 2);
+    LR_CHECK(stats.miss_count == 1);
+    LR_CHECK(stats.hit_bytes == raw_data.size() + compressed_data.size());
+}
+
+LR_TEST(derived_data_cache_overwrites_entry) {
+    auto cache_dir = test::ScopedTempDir("ddc_overwrite");
+    auto cache = DerivedDataCache{};
+    LR_REQUIRE(cache.init(cache_dir.path));
+
+    auto key = cache.make_key(5, 5);
+    auto old_data = random_bytes(4096, 1);
+    auto new_data = random_bytes(2048, 2);
+    LR_REQUIRE(cache.put(key, old_data));
+    LR_REQUIRE(cache.put(key, new_data));
+
+    auto entry = cache.get(key);
+    LR_REQUIRE(entry.has_value());
+    LR_CHECK(std::ranges::equal(entry->data, new_data));
+    LR_CHECK(cache.entries.size() == 1);
+}
+
+LR_TEST(derived_data_cache_evicts_least_recently_used) {
+    constexpr static usize ENTRY_SIZE = 4096;
+
+    auto cache_dir = test::ScopedTempDir("ddc_evict");
+    auto cache = DerivedDataCache{};
+    // Three entries and their headers fit, fourth one doesn't.
+    LR_REQUIRE(cache.init(cache_dir.path, 3 * ENTRY_SIZE + 1024));
+
+    auto keys = std::vector<DerivedDataKey>();
+    for (u32 i = 0; i < 3; i++) {
+        auto &key = keys.emplace_back(cache.make_key(i, 0));
+        auto data = random_bytes(ENTRY_SIZE, i);
+        LR_REQUIRE(cache.put(key, data));
+    }
+
+    // Touching first one leaves second as least recently used.
+    LR_CHECK(cache.get(keys[0]).has_value());
+
+    auto &new_key = keys.emplace_back(cache.make_key(3, 0));
+    auto new_data = random_bytes(ENTRY_SIZE, 3);
+    LR_REQUIRE(cache.put(new_key, new_data));
+    LR_CHECK(cache.contains(keys[0]));
+    LR_CHECK(!cache.contains(keys[1]));
+    LR_CHECK(cache.contains(keys[2]));
+    LR_CHECK(cache.contains(keys[3]));
+    LR_CHECK(!cache.get(keys[1]).has_value());
+    LR_CHECK(cache.total_size <= cache.max_size);
+
+    // Entries and their data survive a restart.
+    auto reopened_cache = DerivedDataCache{};
+    LR_REQUIRE(reopened_cache.init(cache_dir.path, 3 * ENTRY_SIZE + 1024));
+    LR_CHECK(reopened_cache.entries.size() == 3);
+    auto entry = reopened_cache.get(keys[3]);
+    LR_REQUIRE(entry.has_value());
+    LR_CHECK(std::ranges::equal(entry->data, new_data));
+}
+} // namespace lr
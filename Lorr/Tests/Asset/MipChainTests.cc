@@ -0,0 +1,116 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Asset/MipChain.hh"
+
+#include <random>
+
+namespace lr {
+static auto random_pixels(vuk::Extent3D extent, u32 seed) -> std::vector<u8> {
+    auto rng = std::mt19937(seed);
+    auto pixels = std::vector<u8>(static_cast<usize>(extent.width) * extent.height * 4);
+    for (auto &pixel : pixels) {
+        pixel = static_cast<u8>(rng());
+    }
+
+    return pixels;
+}
+
+// Odd, non square and single row extents take the edge paths of SIMD rows.
+constexpr static vuk::Extent3D MIP_TEST_EXTENTS[] = {
+    { .width = 1, .height = 1, .depth = 1 },   { .width = 2, .height = 2, .depth = 1 },  { .width = 7, .height = 5, .depth = 1 },
+    { .width = 33, .height = 17, .depth = 1 }, { .width = 64, .height = 64, .depth = 1 }, { .width = 256, .height = 1, .depth = 1 },
+    { .width = 3, .height = 129, .depth = 1 },
+};
+
+LR_TEST(mip_chain_matches_scalar_reference) {
+    auto infos = std::vector<MipChainInfo>{
+        { .filter = MipFilter::Box, .srgb = false },
+        { .filter = MipFilter::Box, .srgb = true },
+        { .filter = MipFilter::Kaiser, .srgb = false },
+        { .filter = MipFilter::Kaiser, .srgb = true },
+        { .filter = MipFilter::Kaiser, .srgb = false, .normal = true },
+        { .filter = MipFilter::Kaiser, .srgb = true, .alpha_cutoff = 0.5f },
+    };
+
+    auto seed = 0_u32;
+    for (const auto &extent : MIP_TEST_EXTENTS) {
+        for (auto info : infos) {
+            info.extent = extent;
+            auto base_pixels = random_pixels(extent, seed++);
+            auto chain = MipChain::generate(base_pixels, info);
+            auto reference_chain = MipChain::generate_reference(base_pixels, info);
+
+            LR_CHECK(chain.mip_level_count == MipChain::level_count(extent));
+            LR_CHECK(chain.mip_level_count == reference_chain.mip_level_count);
+            LR_CHECK(chain.level_offsets == reference_chain.level_offsets);
+            LR_CHECK(chain.pixels == reference_chain.pixels);
+        }
+    }
+}
+
+LR_TEST(mip_chain_keeps_base_level) {
+    auto extent = vuk::Extent3D{ .width = 16, .height = 8, .depth = 1 };
+    auto base_pixels = random_pixels(extent, 1234);
+    auto chain = MipChain::generate(base_pixels, { .extent = extent, .srgb = false });
+
+    LR_REQUIRE(chain.mip_level_count == 5);
+    auto base_level = chain.level_data(0);
+    LR_CHECK(std::ranges::equal(base_level, base_pixels));
+    LR_CHECK(chain.level_data(4).size() == 4);
+}
+
+LR_TEST(mip_chain_generates_into_levels) {
+    auto seed = 100_u32;
+    for (const auto &extent : MIP_TEST_EXTENTS) {
+        auto info = MipChainInfo{ .extent = extent, .srgb = true, .alpha_cutoff = 0.5f };
+        auto base_pixels = random_pixels(extent, seed++);
+        auto chain = MipChain::generate(base_pixels, info);
+
+        // Separate allocations, same as staging buffers of each level.
+        auto level_storage = std::vector<std::vector<u8>>(chain.mip_level_count);
+        auto levels = std::vector<ls::span<u8>>(chain.mip_level_count);
+        for (u32 level = 0; level < chain.mip_level_count; level++) {
+            level_storage[level].resize(chain.level_data(level).size());
+            levels[level] = level_storage[level];
+        }
+
+        std::ranges::copy(base_pixels, level_storage[0].begin());
+        LR_REQUIRE(MipChain::generate_into(info, levels));
+        for (u32 level = 0; level < chain.mip_level_count; level++) {
+            LR_CHECK(std::ranges::equal(level_storage[level], chain.level_data(level)));
+        }
+    }
+
+    // Every level has to be there and fit.
+    auto extent = vuk::Extent3D{ .width = 4, .height = 4, .depth = 1 };
+    auto base_pixels = random_pixels(extent, 7);
+    auto small_level = std::vector<u8>(3);
+    auto levels = std::vector<ls::span<u8>>{ base_pixels, small_level };
+    LR_CHECK(!MipChain::generate_into({ .extent = extent }, levels));
+    auto last_level = std::vector<u8>(4);
+    auto middle_level = std::vector<u8>(16);
+    levels = { base_pixels, small_level, last_level };
+    LR_CHECK(!MipChain::generate_into({ .extent = extent }, levels));
+    levels = { base_pixels, middle_level, last_level };
+    LR_CHECK(MipChain::generate_into({ .extent = extent }, levels));
+}
+
+LR_TEST(mip_chain_box_averages_solid_color) {
+    auto extent = vuk::Extent3D{ .width = 8, .height = 8, .depth = 1 };
+    auto base_pixels = std::vector<u8>(static_cast<usize>(extent.width) * extent.height * 4);
+    for (usize i = 0; i < base_pixels.size(); i += 4) {
+        base_pixels[i + 0] = 10;
+        base_pixels[i + 1] = 100;
+        base_pixels[i + 2] = 200;
+        base_pixels[i + 3] = 255;
+    }
+
+    auto chain = MipChain::generate(base_pixels, { .extent = extent, .filter = MipFilter::Box, .srgb = true });
+    for (u32 level = 1; level < chain.mip_level_count; level++) {
+        auto level_pixels = chain.level_data(level);
+        for (usize i = 0; i < level_pixels.size(); i++) {
+            LR_CHECK(level_pixels[i] == base_pixels[i % 4]);
+        }
+    }
+}
+} // namespace lr
@@ -0,0 +1,266 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Asset/ModelFile.hh"
+
+#include <random>
+#include <xxhash.h>
+
+namespace lr {
+// Single LOD primitive laid out like `cook_primitive` does, contents are
+// random but indices stay in range so index codecs take them. `cooked`
+// points into `payload`, so it's never copied.
+struct TestPrimitive {
+    std::vector<u8> payload = {};
+    CookedPrimitive cooked = {};
+
+    TestPrimitive(const TestPrimitive &) = delete;
+    TestPrimitive(u32 seed) {
+        constexpr static u32 VERTEX_COUNT = 6;
+        constexpr static u32 TRIANGLE_COUNT = 4;
+
+        auto rng = std::mt19937(seed);
+        auto &gpu_mesh = this->cooked.gpu_mesh;
+        auto &lod = gpu_mesh.lods[0];
+        auto payload_size = 0_u64;
+        auto place = [&payload_size](u64 size) {
+            auto offset = payload_size;
+            payload_size += size;
+            return offset;
+        };
+
+        gpu_mesh.vertex_count = VERTEX_COUNT;
+        gpu_mesh.lod_count = 1;
+        gpu_mesh.vertex_positions = place(VERTEX_COUNT * sizeof(glm::vec3));
+        gpu_mesh.vertex_normals = place(VERTEX_COUNT * sizeof(u32));
+        gpu_mesh.texture_coords = place(VERTEX_COUNT * sizeof(u32));
+        lod.indices = place(TRIANGLE_COUNT * 3 * sizeof(u32));
+        lod.meshlets = place(sizeof(GPU::Meshlet));
+        lod.meshlet_bounds = place(sizeof(GPU::Bounds));
+        lod.meshlet_errors = place(sizeof(GPU::MeshletError));
+        lod.local_triangle_indices = place(TRIANGLE_COUNT * 3);
+        lod.indirect_vertex_indices = place(VERTEX_COUNT * sizeof(u32));
+        lod.indices_count = TRIANGLE_COUNT * 3;
+        lod.meshlet_count = 1;
+
+        this->payload.resize(payload_size);
+        for (auto &byte : this->payload) {
+            byte = static_cast<u8>(rng());
+        }
+
+        auto *indices = reinterpret_cast<u32 *>(this->payload.data() + lod.indices);
+        for (u32 triangle = 0; triangle < TRIANGLE_COUNT; triangle++) {
+            for (u32 i = 0; i < 3; i++) {
+                indices[triangle * 3 + i] = (triangle + i) % VERTEX_COUNT;
+            }
+        }
+
+        auto *indirect_vertex_indices = reinterpret_cast<u32 *>(this->payload.data() + lod.indirect_vertex_indices);
+        for (u32 i = 0; i < VERTEX_COUNT; i++) {
+            indirect_vertex_indices[i] = i;
+        }
+
+        this->cooked.material_index = 0;
+        this->cooked.index_count = TRIANGLE_COUNT * 3;
+        this->cooked.payload = ls::span<u8>(this->payload.data(), this->payload.size());
+        this->cooked.payload_size = this->payload.size();
+        this->cooked.payload_hash = XXH3_64bits(this->payload.data(), this->payload.size());
+    }
+};
+
+static auto make_test_model() -> Model {
+    auto model = Model{};
+    model.materials = { UUID::generate_random(), UUID::generate_random() };
+    model.meshes.push_back({ .name = "mesh", .primitive_indices = { 0, 1 } });
+    model.nodes.push_back({ .name = "root", .child_indices = { 1 } });
+    model.nodes.push_back({ .name = "child",
+                            .mesh_index = 0,
+                            .translation = { 1.0f, 2.0f, 3.0f },
+                            .rotation = { 1.0f, 0.0f, 0.0f, 0.0f },
+                            .scale = { 2.0f, 2.0f, 2.0f } });
+    model.scenes.push_back({ .name = "scene", .node_indices = { 0 } });
+    model.scenes.push_back({ .name = "other scene", .node_indices = { 1 } });
+    model.default_scene_index = 1;
+
+    return model;
+}
+
+static auto read_model_file(std::vector<u8> &file_data, const Model &source_model, Model &model, std::vector<CookedPrimitive> &primitives)
+    -> bool {
+    auto model_file = ModelFile::from_data(DerivedData{ .data = ls::span<u8>(file_data.data(), file_data.size()) });
+    if (!model_file.has_value()) {
+        return false;
+    }
+
+    model.materials = source_model.materials;
+    return model_file->read(model, primitives);
+}
+
+LR_TEST(model_file_round_trip) {
+    TestPrimitive test_primitives[] = { TestPrimitive(1), TestPrimitive(2) };
+    test_primitives[1].cooked.material_index = 1;
+    auto cooked_primitives = std::vector<CookedPrimitive>{ test_primitives[0].cooked, test_primitives[1].cooked };
+    auto source_model = make_test_model();
+    auto file_data = ModelFile::serialize(source_model, cooked_primitives);
+
+    auto model = Model{};
+    auto primitives = std::vector<CookedPrimitive>();
+    LR_REQUIRE(read_model_file(file_data, source_model, model, primitives));
+
+    LR_REQUIRE(model.meshes.size() == source_model.meshes.size());
+    LR_CHECK(model.meshes[0].name == "mesh");
+    LR_CHECK(model.meshes[0].primitive_indices == source_model.meshes[0].primitive_indices);
+
+    LR_REQUIRE(model.nodes.size() == source_model.nodes.size());
+    for (const auto &[node, source_node] : std::views::zip(model.nodes, source_model.nodes)) {
+        LR_CHECK(node.name == source_node.name);
+        LR_CHECK(node.child_indices == source_node.child_indices);
+        LR_CHECK(node.mesh_index == source_node.mesh_index);
+        LR_CHECK(node.translation == source_node.translation);
+        LR_CHECK(node.rotation == source_node.rotation);
+        LR_CHECK(node.scale == source_node.scale);
+    }
+
+    LR_REQUIRE(model.scenes.size() == source_model.scenes.size());
+    LR_CHECK(model.scenes[1].name == "other scene");
+    LR_CHECK(model.scenes[1].node_indices == source_model.scenes[1].node_indices);
+    LR_CHECK(model.default_scene_index == 1);
+
+    LR_REQUIRE(primitives.size() == std::size(test_primitives));
+    for (const auto &[primitive, test_primitive] : std::views::zip(primitives, test_primitives)) {
+        LR_CHECK(primitive.material_index == test_primitive.cooked.material_index);
+        LR_CHECK(primitive.index_count == test_primitive.cooked.index_count);
+        LR_CHECK(primitive.payload_size == test_primitive.payload.size());
+        LR_CHECK(primitive.payload_hash == test_primitive.cooked.payload_hash);
+        LR_CHECK(std::memcmp(&primitive.gpu_mesh, &test_primitive.cooked.gpu_mesh, sizeof(GPU::Mesh)) == 0);
+
+        auto decoded_payload = std::vector<u8>(primitive.payload_size);
+        LR_CHECK(primitive.read_payload(0, decoded_payload));
+        LR_CHECK(decoded_payload == test_primitive.payload);
+
+        // Vertex data on its own, like a streamed mesh reads it.
+        auto vertex_data = std::vector<u8>(primitive.gpu_mesh.lods[0].indices);
+        LR_CHECK(primitive.read_payload(0, vertex_data));
+        LR_CHECK(std::ranges::equal(vertex_data, ls::span(test_primitive.payload).subspan(0, vertex_data.size())));
+    }
+}
+
+LR_TEST(model_file_reads_single_primitive) {
+    auto test_primitive = TestPrimitive(3);
+    auto cooked_primitives = std::vector<CookedPrimitive>{ test_primitive.cooked, test_primitive.cooked };
+    auto source_model = make_test_model();
+    auto file_data = ModelFile::serialize(source_model, cooked_primitives);
+    auto model_file = ModelFile::from_data(DerivedData{ .data = ls::span<u8>(file_data.data(), file_data.size()) });
+    LR_REQUIRE(model_file.has_value());
+
+    auto primitive = model_file->read_primitive(1);
+    LR_REQUIRE(primitive.has_value());
+    auto decoded_payload = std::vector<u8>(primitive->payload_size);
+    LR_CHECK(primitive->read_payload(0, decoded_payload));
+    LR_CHECK(decoded_payload == test_primitive.payload);
+    LR_CHECK(!model_file->read_primitive(2).has_value());
+}
+
+LR_TEST(model_file_rejects_mismatched_materials) {
+    auto test_primitive = TestPrimitive(4);
+    auto cooked_primitives = std::vector<CookedPrimitive>{ test_primitive.cooked, test_primitive.cooked };
+    auto source_model = make_test_model();
+    auto file_data = ModelFile::serialize(source_model, cooked_primitives);
+
+    auto other_model = source_model;
+    other_model.materials[1] = UUID::generate_random();
+    auto model = Model{};
+    auto primitives = std::vector<CookedPrimitive>();
+    LR_CHECK(!read_model_file(file_data, other_model, model, primitives));
+}
+
+LR_TEST(model_file_rejects_out_of_range_indices) {
+    auto test_primitive = TestPrimitive(5);
+    auto cooked_primitives = std::vector<CookedPrimitive>{ test_primitive.cooked, test_primitive.cooked };
+
+    auto check_rejected = [&](const Model &source_model) {
+        auto file_data = ModelFile::serialize(source_model, cooked_primitives);
+        auto model = Model{};
+        auto primitives = std::vector<CookedPrimitive>();
+        LR_CHECK(!read_model_file(file_data, source_model, model, primitives));
+    };
+
+    auto bad_primitive_model = make_test_model();
+    bad_primitive_model.meshes[0].primitive_indices.push_back(2);
+    check_rejected(bad_primitive_model);
+
+    auto bad_child_model = make_test_model();
+    bad_child_model.nodes[0].child_indices.push_back(2);
+    check_rejected(bad_child_model);
+
+    auto bad_mesh_model = make_test_model();
+    bad_mesh_model.nodes[1].mesh_index = 1;
+    check_rejected(bad_mesh_model);
+
+    auto bad_scene_node_model = make_test_model();
+    bad_scene_node_model.scenes[0].node_indices.push_back(5);
+    check_rejected(bad_scene_node_model);
+
+    auto bad_default_scene_model = make_test_model();
+    bad_default_scene_model.default_scene_index = 2;
+    check_rejected(bad_default_scene_model);
+}
+
+LR_TEST(model_file_encodes_streams) {
+    auto test_primitive = TestPrimitive(6);
+    auto cooked_primitives = std::vector<CookedPrimitive>{ test_primitive.cooked };
+    auto source_model = make_test_model();
+    source_model.meshes[0].primitive_indices = { 0 };
+    auto file_data = ModelFile::serialize(source_model, cooked_primitives);
+    auto model_file = ModelFile::from_data(DerivedData{ .data = ls::span<u8>(file_data.data(), file_data.size()) });
+    LR_REQUIRE(model_file.has_value());
+
+    auto primitive = model_file->read_primitive(0);
+    LR_REQUIRE(primitive.has_value());
+    LR_REQUIRE(!primitive->streams.empty());
+    LR_CHECK(primitive->payload.empty());
+
+    // Streams follow each other and cover the whole payload.
+    auto decoded_offset = 0_u64;
+    auto encoded_size = 0_u64;
+    for (const auto &stream : primitive->streams) {
+        LR_CHECK(stream.offset == decoded_offset);
+        LR_CHECK(stream.encoded_size <= stream.size);
+        LR_CHECK(stream.codec != ModelFileStreamCodec::None || stream.encoded_size == stream.size);
+        decoded_offset += stream.size;
+        encoded_size += stream.encoded_size;
+    }
+
+    LR_CHECK(decoded_offset == primitive->payload_size);
+    LR_CHECK(encoded_size == primitive->encoded_payload.size());
+
+    // Whole triangles and sequential indices always shrink.
+    const auto &lod = primitive->gpu_mesh.lods[0];
+    auto find_stream = [&](u64 offset) {
+        return std::ranges::find_if(primitive->streams, [offset](const ModelFileStream &stream) { return stream.offset == offset; });
+    };
+    auto index_stream = find_stream(lod.indices);
+    auto indirect_stream = find_stream(lod.indirect_vertex_indices);
+    LR_REQUIRE(index_stream != primitive->streams.end() && indirect_stream != primitive->streams.end());
+    LR_CHECK(index_stream->codec == ModelFileStreamCodec::Index);
+    LR_CHECK(indirect_stream->codec == ModelFileStreamCodec::IndexSequence);
+
+    // LOD on its own decodes only its own streams.
+    auto lod_size = primitive->payload_size - lod.indices;
+    auto lod_streams = primitive->payload_streams(lod.indices, lod_size);
+    LR_REQUIRE(!lod_streams.empty());
+    LR_CHECK(lod_streams.front().offset == lod.indices);
+    LR_CHECK(lod_streams.back().offset + lod_streams.back().size == primitive->payload_size);
+
+    auto lod_data = std::vector<u8>(lod_size);
+    LR_CHECK(primitive->read_payload(lod.indices, lod_data));
+    LR_CHECK(std::ranges::equal(lod_data, ls::span(test_primitive.payload).subspan(lod.indices)));
+}
+
+LR_TEST(model_file_rejects_other_data) {
+    auto garbage = std::vector<u8>(256, 0xAB);
+    LR_CHECK(!ModelFile::from_data(DerivedData{ .data = ls::span<u8>(garbage.data(), garbage.size()) }).has_value());
+
+    auto empty = std::vector<u8>();
+    LR_CHECK(!ModelFile::from_data(DerivedData{ .data = ls::span<u8>(empty.data(), empty.size()) }).has_value());
+}
+} // namespace lr
@@ -0,0 +1,132 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Asset/Asset.hh"
+
+namespace lr {
+static auto write_meta_file(const fs::path &path, const UUID &uuid) -> bool {
+    auto contents = fmt::format("{{ \"uuid\": \"{}\", \"type\": {} }}", uuid.str(), std::to_underlying(AssetType::Material));
+    File file(path, FileAccess::Write);
+    return file && file.write(contents.data(), contents.size()) == contents.size();
+}
+
+static auto is_registered(AssetManager &asset_man, const UUID &uuid) -> bool {
+    return asset_man.get_asset(uuid) != nullptr;
+}
+
+LR_TEST(registry_snapshot_round_trip) {
+    auto snapshot_dir = test::ScopedTempDir("registry_snapshot_round_trip");
+    auto snapshot_path = snapshot_dir.path / RegistrySnapshot::FILE_NAME;
+
+    auto snapshot = RegistrySnapshot{};
+    snapshot.directories.push_back({ .path = ".", .time = 100 });
+    snapshot.directories.push_back({ .path = "models", .time = -5 });
+    snapshot.entries.push_back({
+        .uuid = UUID::generate_random(),
+        .type = AssetType::Model,
+        .meta_path = "models/tree.glb.lrasset",
+        .meta_time = 42,
+        .meta_size = 1234,
+        .source_hash = { .size = 4096, .time = 43, .hash = 0xDEADBEEF },
+        .dependencies = { UUID::generate_random(), UUID::generate_random() },
+    });
+    snapshot.entries.push_back({
+        .uuid = UUID::generate_random(),
+        .type = AssetType::Texture,
+        .meta_path = "bark.png.lrasset",
+        .meta_time = 44,
+        .meta_size = 99,
+    });
+    LR_REQUIRE(snapshot.write(snapshot_path));
+
+    auto read_snapshot = RegistrySnapshot::read(snapshot_path);
+    LR_REQUIRE(read_snapshot.has_value());
+    LR_REQUIRE(read_snapshot->directories.size() == snapshot.directories.size());
+    for (const auto &[directory, read_directory] : std::views::zip(snapshot.directories, read_snapshot->directories)) {
+        LR_CHECK(directory.path == read_directory.path);
+        LR_CHECK(directory.time == read_directory.time);
+    }
+
+    LR_REQUIRE(read_snapshot->entries.size() == snapshot.entries.size());
+    for (const auto &[entry, read_entry] : std::views::zip(snapshot.entries, read_snapshot->entries)) {
+        LR_CHECK(entry.uuid == read_entry.uuid);
+        LR_CHECK(entry.type == read_entry.type);
+        LR_CHECK(entry.meta_path == read_entry.meta_path);
+        LR_CHECK(entry.meta_time == read_entry.meta_time);
+        LR_CHECK(entry.meta_size == read_entry.meta_size);
+        LR_CHECK(entry.source_hash.size == read_entry.source_hash.size);
+        LR_CHECK(entry.source_hash.time == read_entry.source_hash.time);
+        LR_CHECK(entry.source_hash.hash == read_entry.source_hash.hash);
+        LR_CHECK(entry.dependencies == read_entry.dependencies);
+    }
+
+    // Anything else is ignored, import lists everything again.
+    auto garbage = std::vector<u8>(256, 0xCD);
+    {
+        File file(snapshot_path, FileAccess::Write);
+        LR_REQUIRE(file.write(garbage.data(), garbage.size()) == garbage.size());
+    }
+    LR_CHECK(!RegistrySnapshot::read(snapshot_path).has_value());
+    LR_CHECK(!RegistrySnapshot::read(snapshot_dir.path / "missing.lrreg").has_value());
+}
+
+LR_TEST(registry_snapshot_lists_changed_directories_only) {
+    auto project_dir = test::ScopedTempDir("registry_snapshot_mtimes");
+    const auto &project_path = project_dir.path;
+    auto sub_path = project_path / "materials";
+    auto snapshot_path = project_path / ".cache" / RegistrySnapshot::FILE_NAME;
+    auto ec = std::error_code{};
+    // Created up front, first snapshot write would change mtime of root otherwise.
+    fs::create_directories(project_path / ".cache", ec);
+    fs::create_directories(sub_path, ec);
+
+    auto root_uuid = UUID::generate_random();
+    auto sub_uuid = UUID::generate_random();
+    LR_REQUIRE(write_meta_file(project_path / "root.lrmat.lrasset", root_uuid));
+    LR_REQUIRE(write_meta_file(sub_path / "sub.lrmat.lrasset", sub_uuid));
+
+    {
+        auto asset_man = AssetManager{};
+        asset_man.import_project(project_path);
+        LR_CHECK(is_registered(asset_man, root_uuid));
+        LR_CHECK(is_registered(asset_man, sub_uuid));
+        LR_CHECK(asset_man.find_asset(sub_path / "sub.lrmat", AssetType::Material) == sub_uuid);
+        LR_CHECK(!asset_man.find_asset(sub_path / "sub.lrmat", AssetType::Texture));
+    }
+
+    // Entry only the snapshot knows of, it's kept as long as its
+    // directory isn't listed again.
+    auto ghost_uuid = UUID::generate_random();
+    {
+        auto snapshot = RegistrySnapshot::read(snapshot_path);
+        LR_REQUIRE(snapshot.has_value());
+        LR_CHECK(snapshot->directories.size() == 2);
+        LR_CHECK(snapshot->entries.size() == 2);
+        snapshot->entries.push_back({ .uuid = ghost_uuid, .type = AssetType::Material, .meta_path = "materials/ghost.lrmat.lrasset" });
+        LR_REQUIRE(snapshot->write(snapshot_path));
+    }
+
+    {
+        auto asset_man = AssetManager{};
+        asset_man.import_project(project_path);
+        LR_CHECK(is_registered(asset_man, ghost_uuid));
+        LR_CHECK(is_registered(asset_man, sub_uuid));
+    }
+
+    // New file changes mtime of its directory, it's listed again. Bumped
+    // by hand for file systems with coarse timestamps.
+    auto new_sub_uuid = UUID::generate_random();
+    LR_REQUIRE(write_meta_file(sub_path / "new.lrmat.lrasset", new_sub_uuid));
+    fs::last_write_time(sub_path, fs::last_write_time(sub_path, ec) + std::chrono::seconds(1), ec);
+
+    {
+        auto asset_man = AssetManager{};
+        asset_man.import_project(project_path);
+        LR_CHECK(is_registered(asset_man, root_uuid));
+        LR_CHECK(!is_registered(asset_man, ghost_uuid));
+        LR_CHECK(is_registered(asset_man, sub_uuid));
+        LR_CHECK(is_registered(asset_man, new_sub_uuid));
+        LR_CHECK(asset_man.find_asset(sub_path / "new.lrmat", AssetType::Material) == new_sub_uuid);
+        LR_CHECK(!asset_man.find_asset(sub_path / "ghost.lrmat", AssetType::Material));
+    }
+}
+} // namespace lr
@@ -0,0 +1,86 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Asset/VertexQuantization.hh"
+
+#include <random>
+
+namespace lr {
+LR_TEST(vertex_quantization_positions_within_half_step) {
+    auto rng = std::mt19937(45);
+    auto dist = std::uniform_real_distribution<f32>(-100.0f, 250.0f);
+    auto position_min = glm::vec3(-100.0f, -100.0f, 7.0f);
+    // Z has no extent, every position sits on the same plane.
+    auto position_extent = glm::vec3(350.0f, 350.0f, 0.0f);
+    auto position_scale = position_extent / 65535.0f;
+
+    auto check_position = [&](glm::vec3 position) {
+        auto quantized = quantize_position(position, position_min, position_extent);
+        auto dequantized = dequantize_position(quantized, position_min, position_scale);
+        for (i32 i = 0; i < 3; i++) {
+            LR_CHECK(glm::abs(dequantized[i] - position[i]) <= position_scale[i] * 0.5f + 1e-4f);
+        }
+
+        LR_CHECK(quantized[3] == 0);
+    };
+
+    for (u32 i = 0; i < 10000; i++) {
+        check_position(glm::vec3(dist(rng), dist(rng), 7.0f));
+    }
+
+    // Corners land on the ends of the range exactly.
+    auto min_quantized = quantize_position(position_min, position_min, position_extent);
+    auto max_quantized = quantize_position(position_min + position_extent, position_min, position_extent);
+    LR_CHECK(min_quantized == (std::array<u16, 4>{ 0, 0, 0, 0 }));
+    LR_CHECK(max_quantized == (std::array<u16, 4>{ 65535, 65535, 0, 0 }));
+    LR_CHECK(dequantize_position(min_quantized, position_min, position_scale) == position_min);
+}
+
+LR_TEST(vertex_quantization_octahedral_round_trip) {
+    auto check_normal = [](glm::vec3 normal) {
+        auto decoded = decode_octahedral_unorm16(encode_octahedral_unorm16(normal));
+        LR_CHECK(glm::abs(glm::length(decoded) - 1.0f) < 1e-5f);
+        // 16 bits per half, octahedral mapping stretches a step to ~6e-5
+        // at most.
+        LR_CHECK(glm::length(decoded - normal) < 2e-4f);
+    };
+
+    // Axes and diagonals sit on the folds and corners of the octahedron.
+    constexpr static glm::vec3 EDGE_NORMALS[] = {
+        { 1.0f, 0.0f, 0.0f },  { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },  { 0.0f, -1.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f },  { 0.0f, 0.0f, -1.0f }, { 1.0f, 1.0f, 0.0f },  { -1.0f, 1.0f, 0.0f },
+        { 1.0f, -1.0f, -1.0f }, { -1.0f, -1.0f, -1.0f }, { 0.0f, 1.0f, -1.0f }, { 1.0f, 0.0f, -1.0f },
+    };
+    for (auto normal : EDGE_NORMALS) {
+        check_normal(glm::normalize(normal));
+    }
+
+    auto rng = std::mt19937(46);
+    auto dist = std::normal_distribution<f32>();
+    for (u32 i = 0; i < 10000; i++) {
+        auto normal = glm::vec3(dist(rng), dist(rng), dist(rng));
+        if (glm::length(normal) > 1e-3f) {
+            check_normal(glm::normalize(normal));
+        }
+    }
+
+    // Degenerate normals still decode to a unit vector.
+    LR_CHECK(glm::abs(glm::length(decode_octahedral_unorm16(encode_octahedral_unorm16(glm::vec3(0.0f)))) - 1.0f) < 1e-5f);
+}
+
+LR_TEST(vertex_quantization_texcoords_within_half_step) {
+    // Cooking only quantizes texcoords below 2, half floats step by 1/1024
+    // at most there.
+    auto rng = std::mt19937(47);
+    auto dist = std::uniform_real_distribution<f32>(-1.999f, 1.999f);
+    for (u32 i = 0; i < 10000; i++) {
+        auto texcoord = glm::vec2(dist(rng), dist(rng));
+        auto dequantized = dequantize_texcoord(quantize_texcoord(texcoord));
+        LR_CHECK(glm::abs(dequantized.x - texcoord.x) <= 1.0f / 2048.0f);
+        LR_CHECK(glm::abs(dequantized.y - texcoord.y) <= 1.0f / 2048.0f);
+    }
+
+    // Exact values survive as is.
+    auto exact_texcoord = glm::vec2(0.5f, -1.25f);
+    LR_CHECK(dequantize_texcoord(quantize_texcoord(exact_texcoord)) == exact_texcoord);
+}
+} // namespace lr
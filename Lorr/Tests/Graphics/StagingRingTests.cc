@@ -0,0 +1,108 @@
+#include "Tests/Test.hh"
+
+#include "Engine/Graphics/VulkanDevice.hh"
+
+namespace lr {
+// Only positions are exercised, buffer is never mapped or bound.
+static auto init_ring(StagingRing &ring, u64 block_count) -> void {
+    auto buffer = vuk::Buffer{};
+    buffer.size = block_count * StagingRing::BLOCK_SIZE;
+    ring.init(std::move(buffer));
+}
+
+LR_TEST(staging_ring_allocates_until_full) {
+    auto ring = StagingRing{};
+    init_ring(ring, 8);
+
+    auto first = ring.allocate(3 * StagingRing::BLOCK_SIZE);
+    auto second = ring.allocate(2 * StagingRing::BLOCK_SIZE + 1);
+    LR_REQUIRE(first.has_value() && second.has_value());
+    LR_CHECK(first->first_block == 0 && first->block_count == 3);
+    LR_CHECK(second->first_block == 3 && second->block_count == 3);
+
+    // Doesn't fit before the end and ring can't wrap yet.
+    LR_CHECK(!ring.allocate(3 * StagingRing::BLOCK_SIZE).has_value());
+    LR_CHECK(!ring.allocate(9 * StagingRing::BLOCK_SIZE).has_value());
+
+    // Empty allocations still take a block.
+    auto empty = ring.allocate(0);
+    LR_REQUIRE(empty.has_value());
+    LR_CHECK(empty->first_block == 6 && empty->block_count == 1);
+}
+
+LR_TEST(staging_ring_reclaims_in_order) {
+    auto ring = StagingRing{};
+    init_ring(ring, 8);
+
+    auto first = ring.allocate(3 * StagingRing::BLOCK_SIZE);
+    auto second = ring.allocate(3 * StagingRing::BLOCK_SIZE);
+    LR_REQUIRE(first.has_value() && second.has_value());
+
+    // Retired out of order, tail waits for the first range.
+    ring.retire(second.value());
+    LR_CHECK(ring.reclaim() == 0);
+    LR_CHECK(ring.tail.load() == 0);
+
+    ring.retire(first.value());
+    LR_CHECK(ring.reclaim() == 6);
+    LR_CHECK(ring.tail.load() == 6);
+    LR_CHECK(ring.reclaim() == 0);
+}
+
+LR_TEST(staging_ring_wraps_around) {
+    auto ring = StagingRing{};
+    init_ring(ring, 8);
+
+    auto first = ring.allocate(6 * StagingRing::BLOCK_SIZE);
+    LR_REQUIRE(first.has_value());
+    ring.retire(first.value());
+    LR_CHECK(ring.reclaim() == 6);
+
+    // Two blocks left before the end, they are skipped and retired.
+    auto wrapped = ring.allocate(3 * StagingRing::BLOCK_SIZE);
+    LR_REQUIRE(wrapped.has_value());
+    LR_CHECK(wrapped->first_block == 8 && wrapped->block_count == 3);
+    LR_CHECK(ring.reclaim() == 2);
+    LR_CHECK(ring.tail.load() == 8);
+
+    // Reused blocks start unretired.
+    LR_CHECK(ring.reclaim() == 0);
+    ring.retire(wrapped.value());
+    LR_CHECK(ring.reclaim() == 3);
+    LR_CHECK(ring.head.load() == ring.tail.load());
+
+    // Whole ring is free again.
+    auto rest = ring.allocate(5 * StagingRing::BLOCK_SIZE);
+    auto front = ring.allocate(3 * StagingRing::BLOCK_SIZE);
+    LR_REQUIRE(rest.has_value() && front.has_value());
+    LR_CHECK(rest->first_block == 11);
+    LR_CHECK(front->first_block == 16);
+    LR_CHECK(!ring.allocate(1).has_value());
+}
+
+LR_TEST(staging_ring_finds_ranges_of_buffers) {
+    auto ring = StagingRing{};
+    init_ring(ring, 8);
+
+    auto first = ring.allocate(2 * StagingRing::BLOCK_SIZE);
+    auto second = ring.allocate(StagingRing::BLOCK_SIZE + 5);
+    LR_REQUIRE(first.has_value() && second.has_value());
+
+    auto second_buffer = ring.buffer.subrange(second->first_block * StagingRing::BLOCK_SIZE, StagingRing::BLOCK_SIZE + 5);
+    auto second_range = ring.range_of(second_buffer);
+    LR_REQUIRE(second_range.has_value());
+    LR_CHECK(second_range->first_block == second->first_block);
+    LR_CHECK(second_range->block_count == second->block_count);
+
+    auto outside_buffer = vuk::Buffer{};
+    outside_buffer.offset = ring.buffer.size;
+    LR_CHECK(!ring.range_of(outside_buffer).has_value());
+
+    // Discarded ranges are retired through the range of their buffer.
+    ring.retire(second_range.value());
+    LR_CHECK(ring.reclaim() == 0);
+    ring.retire(ring.range_of(ring.buffer.subrange(0, 2 * StagingRing::BLOCK_SIZE)).value());
+    LR_CHECK(ring.reclaim() == 4);
+    LR_CHECK(ring.head.load() == ring.tail.load());
+}
+} // namespace lr
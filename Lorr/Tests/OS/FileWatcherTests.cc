@@ -0,0 +1,145 @@
+#include "Tests/Test.hh"
+
+#include "Engine/OS/File.hh"
+#include "Engine/OS/FileWatcher.hh"
+
+#include <thread>
+
+namespace lr {
+// Everything that was pending has settled after a few settle windows.
+static auto poll_settled(FileWatcher &watcher) -> std::vector<FileEvent> {
+    auto events = std::vector<FileEvent>();
+    auto end_ts = std::chrono::steady_clock::now() + FileWatcher::SETTLE_DURATION * 4;
+    while (std::chrono::steady_clock::now() < end_ts) {
+        auto polled_events = watcher.poll();
+        events.insert(events.end(), polled_events.begin(), polled_events.end());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return events;
+}
+
+static auto write_file(const fs::path &path, std::string_view contents) -> bool {
+    File file(path, FileAccess::Write);
+    return file && file.write(contents.data(), contents.size()) == contents.size();
+}
+
+LR_TEST(file_watcher_coalesces_save) {
+    auto root_dir = test::ScopedTempDir("file_watcher_save");
+    auto watcher = FileWatcher{};
+    if (!watcher.init(root_dir.path)) {
+        // Not Linux, nothing to test.
+        return;
+    }
+    LS_DEFER(&) {
+        watcher.destroy();
+    };
+
+    // Editors save in several steps, they are a single event.
+    auto file_path = root_dir.path / "texture.png";
+    LR_REQUIRE(write_file(file_path, "first"));
+    LR_REQUIRE(write_file(file_path, "second"));
+    LR_REQUIRE(write_file(file_path, "third"));
+
+    auto events = poll_settled(watcher);
+    LR_REQUIRE(events.size() == 1);
+    LR_CHECK(events[0].file_name == file_path);
+    LR_CHECK(events[0].action_mask == FileActionMask::Create);
+
+    LR_REQUIRE(write_file(file_path, "fourth"));
+    LR_REQUIRE(write_file(file_path, "fifth"));
+    events = poll_settled(watcher);
+    LR_REQUIRE(events.size() == 1);
+    LR_CHECK(events[0].action_mask == FileActionMask::Modify);
+
+    auto ec = std::error_code{};
+    fs::remove(file_path, ec);
+    events = poll_settled(watcher);
+    LR_REQUIRE(events.size() == 1);
+    LR_CHECK(events[0].action_mask == FileActionMask::Delete);
+}
+
+LR_TEST(file_watcher_drops_temporary_and_suppressed_files) {
+    auto root_dir = test::ScopedTempDir("file_watcher_temporary");
+    auto watcher = FileWatcher{};
+    if (!watcher.init(root_dir.path)) {
+        return;
+    }
+    LS_DEFER(&) {
+        watcher.destroy();
+    };
+
+    // Created and removed before it settles.
+    auto temp_path = root_dir.path / "scene.json.tmp";
+    LR_REQUIRE(write_file(temp_path, "temp"));
+    auto ec = std::error_code{};
+    fs::remove(temp_path, ec);
+
+    // Written by us.
+    auto suppressed_path = root_dir.path / "model.glb.lrasset";
+    watcher.suppress(suppressed_path);
+    LR_REQUIRE(write_file(suppressed_path, "{}"));
+
+    LR_CHECK(poll_settled(watcher).empty());
+
+    // Only the write after it was suppressed is dropped.
+    LR_REQUIRE(write_file(suppressed_path, "{ }"));
+    auto events = poll_settled(watcher);
+    LR_REQUIRE(events.size() == 1);
+    LR_CHECK(events[0].file_name == suppressed_path);
+}
+
+LR_TEST(file_watcher_reports_new_directory_contents) {
+    auto root_dir = test::ScopedTempDir("file_watcher_directory");
+    auto watcher = FileWatcher{};
+    if (!watcher.init(root_dir.path)) {
+        return;
+    }
+    LS_DEFER(&) {
+        watcher.destroy();
+    };
+
+    // Moved in with contents, files inside exist before it is watched.
+    auto staging_dir = test::ScopedTempDir("file_watcher_directory_staging");
+    LR_REQUIRE(write_file(staging_dir.path / "a.png", "a"));
+    LR_REQUIRE(write_file(staging_dir.path / "b.png", "b"));
+    auto moved_dir = root_dir.path / "textures";
+    auto ec = std::error_code{};
+    fs::rename(staging_dir.path, moved_dir, ec);
+    LR_REQUIRE(!ec);
+
+    auto events = poll_settled(watcher);
+    auto has_event = [&](const fs::path &path, FileActionMask action_mask) {
+        return std::ranges::any_of(events, [&](const FileEvent &event) { return event.file_name == path && event.action_mask == action_mask; });
+    };
+    LR_CHECK(events.size() == 3);
+    LR_CHECK(has_event(moved_dir, FileActionMask::Create | FileActionMask::Directory));
+    LR_CHECK(has_event(moved_dir / "a.png", FileActionMask::Create));
+    LR_CHECK(has_event(moved_dir / "b.png", FileActionMask::Create));
+}
+
+LR_TEST(file_watcher_ignores_dot_directories) {
+    auto root_dir = test::ScopedTempDir("file_watcher_dot_directories");
+    auto ec = std::error_code{};
+    fs::create_directories(root_dir.path / ".cache", ec);
+    auto watcher = FileWatcher{};
+    if (!watcher.init(root_dir.path)) {
+        return;
+    }
+    LS_DEFER(&) {
+        watcher.destroy();
+    };
+
+    // Derived data cache writes, and directories created while watching.
+    LR_REQUIRE(write_file(root_dir.path / ".cache" / "entry", "cooked"));
+    fs::create_directories(root_dir.path / ".git" / "objects", ec);
+    LR_REQUIRE(write_file(root_dir.path / ".git" / "objects" / "object", "object"));
+    LR_CHECK(poll_settled(watcher).empty());
+
+    auto file_path = root_dir.path / "model.glb";
+    LR_REQUIRE(write_file(file_path, "model"));
+    auto events = poll_settled(watcher);
+    LR_REQUIRE(events.size() == 1);
+    LR_CHECK(events[0].file_name == file_path);
+}
+} // namespace lr
@@ -0,0 +1,55 @@
+#include "Tests/Test.hh"
+
+#include "Engine/OS/Timer.hh"
+
+namespace lr {
+// `AppBuilder::build` calibrates the clock before tests run.
+LR_TEST(tsc_clock_conversions_agree) {
+    LR_REQUIRE(TSCClock::frequency != 0);
+    LR_CHECK(glm::abs(static_cast<f64>(TSCClock::frequency) * TSCClock::seconds_per_tick - 1.0) < 1e-9);
+
+    auto second_ticks = TSCClock::frequency;
+    LR_CHECK(glm::abs(TSCClock::to_seconds(second_ticks) - 1.0) < 1e-6);
+    LR_CHECK(glm::abs(TSCClock::to_ms(second_ticks) - 1'000.0) < 1e-3);
+    LR_CHECK(glm::abs(TSCClock::to_us(second_ticks) - 1'000'000.0) < 1.0);
+    // Truncated, rounding of `seconds_per_tick` can put it one below.
+    auto second_ns = TSCClock::to_ns(second_ticks);
+    LR_CHECK(second_ns >= 999'999'999 && second_ns <= 1'000'000'000);
+    LR_CHECK(TSCClock::to_ns(0) == 0);
+}
+
+LR_TEST(tsc_clock_matches_steady_clock) {
+    constexpr auto WAIT_DURATION = std::chrono::milliseconds(20);
+
+    auto begin_ts = std::chrono::steady_clock::now();
+    auto begin_ticks = TSCClock::now();
+    auto end_ts = begin_ts;
+    while (end_ts - begin_ts < WAIT_DURATION) {
+        end_ts = std::chrono::steady_clock::now();
+    }
+    auto end_ticks = TSCClock::now();
+
+    LR_REQUIRE(end_ticks > begin_ticks);
+    auto steady_ns = static_cast<f64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end_ts - begin_ts).count());
+    auto tsc_ns = static_cast<f64>(TSCClock::to_ns(end_ticks - begin_ticks));
+    // Calibration runs for a few ms, it is well within 1%.
+    LR_CHECK(glm::abs(tsc_ns - steady_ns) < steady_ns * 0.01);
+}
+
+LR_TEST(stage_timer_sums_stages) {
+    auto timer = StageTimer{};
+    for (u32 i = 0; i < StageTimer::MAX_STAGES + 2; i++) {
+        timer.lap("stage");
+    }
+
+    LR_CHECK(timer.stage_count == StageTimer::MAX_STAGES);
+    auto recorded_ticks = 0_u64;
+    for (usize i = 0; i < timer.stage_count; i++) {
+        recorded_ticks += timer.stages[i].n1;
+    }
+
+    // Stages past the limit still count towards total.
+    LR_CHECK(recorded_ticks <= timer.total_ticks);
+    LR_CHECK(timer.to_string().contains("total"));
+}
+} // namespace lr
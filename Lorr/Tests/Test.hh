@@ -0,0 +1,60 @@
+#pragma once
+
+#include <source_location>
+
+namespace lr::test {
+using TestFn = void (*)();
+
+struct TestCase {
+    std::string_view name = {};
+    TestFn fn = nullptr;
+};
+
+// Filled by `LR_TEST` before `main` runs.
+auto test_cases() -> std::vector<TestCase> &;
+// Marks running test failed, test keeps going unless it returns itself.
+auto fail(std::string_view expr, std::source_location location = std::source_location::current()) -> void;
+
+struct TestRegistrar {
+    TestRegistrar(std::string_view name, TestFn fn) {
+        test_cases().push_back({ .name = name, .fn = fn });
+    }
+};
+
+// Fresh directory per test, removed once it's done.
+struct ScopedTempDir {
+    fs::path path = {};
+
+    ScopedTempDir(std::string_view name) : path(fs::temp_directory_path() / fmt::format("lorr_tests_{}", name)) {
+        auto ec = std::error_code{};
+        fs::remove_all(path, ec);
+        fs::create_directories(path, ec);
+    }
+
+    ~ScopedTempDir() {
+        auto ec = std::error_code{};
+        fs::remove_all(path, ec);
+    }
+};
+} // namespace lr::test
+
+#define LR_TEST(name)                                             \
+    static auto name() -> void;                                   \
+    static lr::test::TestRegistrar name##_registrar(#name, name); \
+    static auto name() -> void
+
+#define LR_CHECK(expr)             \
+    do {                           \
+        if (!(expr)) {             \
+            lr::test::fail(#expr); \
+        }                          \
+    } while (false)
+
+// Rest of the test depends on `expr`.
+#define LR_REQUIRE(expr)           \
+    do {                           \
+        if (!(expr)) {             \
+            lr::test::fail(#expr); \
+            return;                \
+        }                          \
+    } while (false)
@@ -0,0 +1,42 @@
+#include "Tests/TestModule.hh"
+
+#include "Tests/Test.hh"
+
+#include "Engine/Core/App.hh"
+
+namespace lr::test {
+static std::atomic<u32> failed_check_count = 0;
+
+auto test_cases() -> std::vector<TestCase> & {
+    static std::vector<TestCase> cases = {};
+    return cases;
+}
+
+auto fail(std::string_view expr, std::source_location location) -> void {
+    LOG_ERROR("{}:{}: Check failed: {}", location.file_name(), location.line(), expr);
+    failed_check_count.fetch_add(1);
+}
+} // namespace lr::test
+
+auto TestModule::init(this TestModule &self) -> bool {
+    ZoneScoped;
+
+    auto &test_cases = lr::test::test_cases();
+    for (const auto &test_case : test_cases) {
+        auto failed_check_count = lr::test::failed_check_count.load();
+        test_case.fn();
+        if (lr::test::failed_check_count.load() != failed_check_count) {
+            LOG_ERROR("FAIL {}", test_case.name);
+            self.failed_count++;
+        } else {
+            LOG_INFO("PASS {}", test_case.name);
+        }
+    }
+
+    LOG_INFO("{} of {} tests passed.", test_cases.size() - self.failed_count, test_cases.size());
+    lr::App::close();
+
+    return true;
+}
+
+auto TestModule::destroy(this TestModule &) -> void {}
@@ -0,0 +1,12 @@
+#pragma once
+
+// Runs every `LR_TEST` once app is up, job manager is there for code that
+// fans out. No device or window, tests stick to CPU side code.
+struct TestModule {
+    static constexpr auto MODULE_NAME = "Tests";
+
+    u32 failed_count = 0;
+
+    auto init(this TestModule &) -> bool;
+    auto destroy(this TestModule &) -> void;
+};
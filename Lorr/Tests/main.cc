@@ -0,0 +1,13 @@
+#include "Tests/TestModule.hh"
+
+#include "Engine/Core/App.hh"
+
+i32 main(i32, c8 **) {
+    ZoneScoped;
+
+    lr::AppBuilder() //
+        .module<TestModule>()
+        .build(4, "tests.log");
+
+    return lr::App::mod<TestModule>().failed_count == 0 ? 0 : 1;
+}
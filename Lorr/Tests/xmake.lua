@@ -0,0 +1,11 @@
+target("Tests")
+    set_kind("binary")
+    set_languages("cxx23")
+    -- Not installed, `xmake test` builds and runs it.
+    set_default(false)
+    add_deps("Lorr")
+    add_includedirs("./")
+    add_files("**.cc")
+    add_rpathdirs("@executable_path")
+    add_tests("default")
+target_end()
@@ -1,4 +1,5 @@
 includes("Editor")
 includes("Runtime")
+includes("Tests")
 includes("Engine")
 includes("ls")